@@ -14,6 +14,7 @@
 #include <jet/scalar_grid3.h>
 #include <limits>
 #include <memory>
+#include <vector>
 
 namespace jet {
 
@@ -109,6 +110,31 @@ class AdvectionSolver3 {
         FaceCenteredGrid3* output,
         const ScalarField3& boundarySdf
             = ConstantScalarField3(kMaxD));
+
+    //!
+    //! \brief Solves advection equation for multiple scalar grids at once.
+    //!
+    //! This function solves advection equation for each scalar grid in
+    //! \p inputs with the same underlying vector field \p flow and stores the
+    //! solutions in the scalar grid with the same index in \p outputs. The
+    //! default implementation calls AdvectionSolver3::advect for each grid, but
+    //! the inheriting classes can override it to share the computation among
+    //! the grids, such as the back-tracing of the semi-Lagrangian method.
+    //!
+    //! \param inputs Input scalar grids.
+    //! \param flow Vector field that advects the input fields.
+    //! \param dt Time-step for the advection.
+    //! \param outputs Output scalar grids.
+    //! \param boundarySdf Boundary interface defined by signed-distance
+    //!     field.
+    //!
+    virtual void advectScalars(
+        const std::vector<const ScalarGrid3*>& inputs,
+        const VectorField3& flow,
+        double dt,
+        const std::vector<ScalarGrid3*>& outputs,
+        const ScalarField3& boundarySdf
+            = ConstantScalarField3(kMaxD));
 };
 
 //! Shared pointer type for the 3-D advection solver.
@@ -46,10 +46,19 @@ class ApicSolver3 : public PicSolver3 {
     //! Transfers velocity field from grids to particles.
     void transferFromGridsToParticles() override;
 
+    //! Reorders the particles and the affine velocity coefficients.
+    void sortParticles() override;
+
+    //! Removes the particles and the affine velocity coefficients.
+    void removeParticles(const ConstArrayAccessor1<char>& mask) override;
+
  private:
     Array1<Vector3D> _cX;
     Array1<Vector3D> _cY;
     Array1<Vector3D> _cZ;
+
+    void gatherCoefficients(
+        const Array1<size_t>& indices, size_t oldNumberOfParticles);
 };
 
 //! Shared pointer type for the ApicSolver3.
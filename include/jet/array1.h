@@ -77,6 +77,17 @@ class Array<T, 1> final {
     //! Resizes the array with \p size and fill the new element with \p initVal.
     void resize(size_t size, const T& initVal = T());
 
+    //!
+    //! \brief Reserves the storage for at least \p capacity elements.
+    //!
+    //! This function does not change the size of the array. Resizing or
+    //! appending within the capacity does not reallocate the storage.
+    //!
+    void reserve(size_t capacity);
+
+    //! Returns the number of elements that can be held without reallocation.
+    size_t capacity() const;
+
     //! Returns the reference to the i-th element.
     T& at(size_t i);
 
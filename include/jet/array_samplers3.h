@@ -8,6 +8,7 @@
 #define INCLUDE_JET_ARRAY_SAMPLERS3_H_
 
 #include <jet/array_samplers.h>
+#include <jet/array_accessor1.h>
 #include <jet/array_accessor3.h>
 #include <jet/vector3.h>
 #include <functional>
@@ -99,6 +100,22 @@ class LinearArraySampler<T, R, 3> final {
     //! Returns sampled value at point \p pt.
     T operator()(const Vector3<R>& pt) const;
 
+    //!
+    //! \brief Samples the values at multiple points.
+    //!
+    //! The points are processed in small blocks. The cell indices and the
+    //! interpolation weights of a block are computed first with branch-free
+    //! loops so that the compiler can vectorize them, and then the values are
+    //! gathered and blended. The result is identical to calling operator() for
+    //! each point.
+    //!
+    //! \param[in]  pts    The sample points.
+    //! \param[out] result The sampled values with the same size as \p pts.
+    //!
+    void sample(
+        const ConstArrayAccessor1<Vector3<R>>& pts,
+        ArrayAccessor1<T> result) const;
+
     //! Returns the indices of points and their sampling weight for given point.
     void getCoordinatesAndWeights(
         const Vector3<R>& pt,
@@ -161,6 +178,20 @@ class CubicArraySampler<T, R, 3> final {
     //! Returns sampled value at point \p pt.
     T operator()(const Vector3<R>& pt) const;
 
+    //!
+    //! \brief Samples the values at multiple points.
+    //!
+    //! Same as LinearArraySampler3::sample, the cell indices and the fractions
+    //! of a block of points are computed first and the cubic interpolation
+    //! follows. The result is identical to calling operator() for each point.
+    //!
+    //! \param[in]  pts    The sample points.
+    //! \param[out] result The sampled values with the same size as \p pts.
+    //!
+    void sample(
+        const ConstArrayAccessor1<Vector3<R>>& pts,
+        ArrayAccessor1<T> result) const;
+
     //! Returns a funtion object that wraps this instance.
     std::function<T(const Vector3<R>&)> functor() const;
 
@@ -0,0 +1,81 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_ARRAY_SCATTER_H_
+#define INCLUDE_JET_ARRAY_SCATTER_H_
+
+#include <jet/array_accessor2.h>
+#include <jet/array_accessor3.h>
+#include <jet/array_samplers2.h>
+#include <jet/array_samplers3.h>
+
+namespace jet {
+
+//!
+//! \brief Scatters point values to 2-D array as weighted averages.
+//!
+//! This function splats the values carried by the points to the nodes of the
+//! \p output array using the bi-linear weights of the \p sampler and stores
+//! the weighted average at each node. Nodes that are touched by any point are
+//! marked as 1 in \p markers and the others are set to 0 (with zero value).
+//!
+//! Instead of scattering from the points with atomics or locks, the points are
+//! sorted by their base node and each node gathers the contributions from the
+//! nearby points in a fixed order. Thus the result is computed in parallel and
+//! bitwise identical regardless of the number of threads.
+//!
+//! \param numberOfPoints   Number of points.
+//! \param sampler          Sampler that defines the grid of \p output.
+//! \param positionFunc     Returns the position of the i-th point.
+//! \param valueFunc        Returns the value of the i-th point for the given
+//!                         node index.
+//! \param output           Weighted average at each node.
+//! \param markers          Set to 1 if the node is touched, else 0.
+//!
+template <typename PositionFunc, typename ValueFunc>
+void scatterWeightedAverage(
+    size_t numberOfPoints,
+    const LinearArraySampler2<double, double>& sampler,
+    const PositionFunc& positionFunc,
+    const ValueFunc& valueFunc,
+    ArrayAccessor2<double> output,
+    ArrayAccessor2<char> markers);
+
+//!
+//! \brief Scatters point values to 3-D array as weighted averages.
+//!
+//! This function splats the values carried by the points to the nodes of the
+//! \p output array using the tri-linear weights of the \p sampler and stores
+//! the weighted average at each node. Nodes that are touched by any point are
+//! marked as 1 in \p markers and the others are set to 0 (with zero value).
+//!
+//! Instead of scattering from the points with atomics or locks, the points are
+//! sorted by their base node and each node gathers the contributions from the
+//! nearby points in a fixed order. Thus the result is computed in parallel and
+//! bitwise identical regardless of the number of threads.
+//!
+//! \param numberOfPoints   Number of points.
+//! \param sampler          Sampler that defines the grid of \p output.
+//! \param positionFunc     Returns the position of the i-th point.
+//! \param valueFunc        Returns the value of the i-th point for the given
+//!                         node index.
+//! \param output           Weighted average at each node.
+//! \param markers          Set to 1 if the node is touched, else 0.
+//!
+template <typename PositionFunc, typename ValueFunc>
+void scatterWeightedAverage(
+    size_t numberOfPoints,
+    const LinearArraySampler3<double, double>& sampler,
+    const PositionFunc& positionFunc,
+    const ValueFunc& valueFunc,
+    ArrayAccessor3<double> output,
+    ArrayAccessor3<char> markers);
+
+}  // namespace jet
+
+#include "detail/array_scatter-inl.h"
+
+#endif  // INCLUDE_JET_ARRAY_SCATTER_H_
@@ -58,6 +58,15 @@ struct Blas {
         const VectorType& v,
         VectorType* result);
 
+    //! Performs matrix-vector multiplication and returns the dot products
+    //! v.v and v.(mv) in \p vDotV and \p vDotResult.
+    static void mvmDot(
+        const MatrixType& m,
+        const VectorType& v,
+        VectorType* result,
+        ScalarType* vDotV,
+        ScalarType* vDotResult);
+
     //! Computes residual vector (b - ax).
     static void residual(
         const MatrixType& a,
@@ -65,6 +74,17 @@ struct Blas {
         const VectorType& b,
         VectorType* result);
 
+    //! Performs the fused conjugate gradient update p = r + beta * p,
+    //! s = w + beta * s, x = x + alpha * p and r = r - alpha * s.
+    static void cgUpdate(
+        ScalarType alpha,
+        ScalarType beta,
+        const VectorType& w,
+        VectorType* r,
+        VectorType* p,
+        VectorType* s,
+        VectorType* x);
+
     //! Returns L2-norm of the given vector \p v.
     static ScalarType l2Norm(const VectorType& v);
 
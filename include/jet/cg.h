@@ -45,6 +45,32 @@ void cg(
     unsigned int* lastNumberOfIterations,
     double* lastResidualNorm);
 
+//!
+//! \brief Solves conjugate gradient with fused kernels.
+//!
+//! This function implements the Chronopoulos-Gear variant of the conjugate
+//! gradient method which computes both dot products of an iteration right
+//! after the matrix-vector multiplication. This allows BlasType::mvmDot to
+//! compute them in the same pass and BlasType::cgUpdate to merge all the
+//! vector updates into a single pass, thus each iteration sweeps the vectors
+//! twice instead of seven times. The working vectors \p d, \p q, and \p s
+//! hold the search direction, the product of \p A and \p r, and the product
+//! of \p A and \p d, respectively.
+//!
+template <typename BlasType>
+void cgFused(
+    const typename BlasType::MatrixType& A,
+    const typename BlasType::VectorType& b,
+    unsigned int maxNumberOfIterations,
+    double tolerance,
+    typename BlasType::VectorType* x,
+    typename BlasType::VectorType* r,
+    typename BlasType::VectorType* d,
+    typename BlasType::VectorType* q,
+    typename BlasType::VectorType* s,
+    unsigned int* lastNumberOfIterations,
+    double* lastResidualNorm);
+
 //!
 //! \brief Solves pre-conditioned conjugate gradient.
 //!
@@ -7,6 +7,7 @@
 #ifndef INCLUDE_JET_COLLIDER3_H_
 #define INCLUDE_JET_COLLIDER3_H_
 
+#include <jet/array_accessor1.h>
 #include <jet/surface3.h>
 #include <functional>
 
@@ -55,6 +56,40 @@ class Collider3 {
         Vector3D* position,
         Vector3D* velocity);
 
+    //!
+    //! \brief Resolves collision for given points.
+    //!
+    //! This function resolves collision for all the points with the same
+    //! radius. When the broad phase is enabled, the signed distance to the
+    //! surface is sampled on a coarse grid that covers the points first. A
+    //! point is tested against the surface only when the distance bound from
+    //! its nearest grid node does not rule out the contact.
+    //!
+    //! \param radius Radius of the colliding points.
+    //! \param restitutionCoefficient Defines the restitution effect.
+    //! \param positions Input and output positions of the points.
+    //! \param velocities Input and output velocities of the points.
+    //!
+    void resolveCollision(
+        double radius,
+        double restitutionCoefficient,
+        ArrayAccessor1<Vector3D> positions,
+        ArrayAccessor1<Vector3D> velocities);
+
+    //! Returns true if the broad phase is used for resolving the points.
+    bool isUsingBroadPhase() const;
+
+    //!
+    //! \brief Sets true to use the broad phase for resolving the points.
+    //!
+    //! The broad phase assumes that Surface3::closestDistance returns the
+    //! Euclidean distance to the surface and Surface3::isInside only changes
+    //! across the surface. Disable the broad phase for the surfaces that do
+    //! not meet the requirements, such as a custom implicit surface whose
+    //! signed-distance function overestimates the distance. Default is true.
+    //!
+    void setIsUsingBroadPhase(bool onoff);
+
     //! Returns friction coefficent.
     double frictionCoefficient() const;
 
@@ -111,6 +146,7 @@ class Collider3 {
  private:
     Surface3Ptr _surface;
     double _frictionCoeffient = 0.0;
+    bool _isUsingBroadPhase = true;
     OnBeginUpdateCallback _onUpdateCallback;
 };
 
@@ -96,6 +96,16 @@ class CollocatedVectorGrid3 : public VectorGrid3 {
     //!
     std::function<Vector3D(const Vector3D&)> sampler() const override;
 
+    //!
+    //! \brief Returns the linear sampler.
+    //!
+    //! Unlike CollocatedVectorGrid3::sampler, the returned sampler is
+    //! statically typed so that it can be inlined in the hot loops. The
+    //! sampler refers to the grid data and becomes invalid when the grid is
+    //! resized.
+    //!
+    const LinearArraySampler3<Vector3D, double>& linearSampler() const;
+
  protected:
     //! Swaps the data storage and predefined samplers with given grid.
     void swapCollocatedVectorGrid(CollocatedVectorGrid3* other);
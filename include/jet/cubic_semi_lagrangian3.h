@@ -20,6 +20,47 @@ class CubicSemiLagrangian3 final : public SemiLagrangian3 {
  public:
     CubicSemiLagrangian3();
 
+    //!
+    //! \brief Computes semi-Langian for given scalar grid.
+    //!
+    //! This function overrides the original function with cubic interpolation.
+    //!
+    void advect(const ScalarGrid3& input, const VectorField3& flow, double dt,
+                ScalarGrid3* output,
+                const ScalarField3& boundarySdf = ConstantScalarField3(
+                    std::numeric_limits<double>::max())) override;
+
+    //!
+    //! \brief Computes semi-Langian for given collocated vector grid.
+    //!
+    //! This function overrides the original function with cubic interpolation.
+    //!
+    void advect(const CollocatedVectorGrid3& input, const VectorField3& flow,
+                double dt, CollocatedVectorGrid3* output,
+                const ScalarField3& boundarySdf = ConstantScalarField3(
+                    std::numeric_limits<double>::max())) override;
+
+    //!
+    //! \brief Computes semi-Langian for given face-centered vector grid.
+    //!
+    //! This function overrides the original function with cubic interpolation.
+    //!
+    void advect(const FaceCenteredGrid3& input, const VectorField3& flow,
+                double dt, FaceCenteredGrid3* output,
+                const ScalarField3& boundarySdf = ConstantScalarField3(
+                    std::numeric_limits<double>::max())) override;
+
+    //!
+    //! \brief Computes semi-Langian for multiple scalar grids at once.
+    //!
+    //! This function overrides the original function with cubic interpolation.
+    //!
+    void advectScalars(const std::vector<const ScalarGrid3*>& inputs,
+                       const VectorField3& flow, double dt,
+                       const std::vector<ScalarGrid3*>& outputs,
+                       const ScalarField3& boundarySdf = ConstantScalarField3(
+                           std::numeric_limits<double>::max())) override;
+
  protected:
     //!
     //! \brief Returns spatial interpolation function object for given scalar
@@ -73,6 +73,16 @@ void Array<T, 1>::resize(size_t size, const T& initVal) {
     _data.resize(size, initVal);
 }
 
+template <typename T>
+void Array<T, 1>::reserve(size_t capacity) {
+    _data.reserve(capacity);
+}
+
+template <typename T>
+size_t Array<T, 1>::capacity() const {
+    return _data.capacity();
+}
+
 template <typename T>
 T& Array<T, 1>::at(size_t i) {
     assert(i < size());
@@ -15,6 +15,47 @@
 
 namespace jet {
 
+namespace internal {
+
+// Number of points processed together by the batched samplers
+constexpr size_t kArraySamplerBlockSize = 16;
+
+// Branch-free getBarycentric with iLow = 0 for a block of n values
+template <typename R>
+inline void getBarycentricInBlock(
+    const R* x, size_t n, ssize_t iHigh, ssize_t* i, R* f) {
+    for (size_t p = 0; p < n; ++p) {
+        const R s = std::floor(x[p]);
+        const ssize_t is = static_cast<ssize_t>(s);
+        const bool isLow = (iHigh == 0) || (is < 0);
+        const bool isHigh = !isLow && (is > iHigh - 1);
+        i[p] = isLow ? 0 : (isHigh ? iHigh - 1 : is);
+        f[p] = isLow ? 0 : (isHigh ? 1 : static_cast<R>(x[p] - s));
+    }
+}
+
+// Computes the cell indices and fractions of a block of points
+template <typename R>
+inline void getBarycentricInBlock(
+    const Vector3<R>* pts, size_t n, const Vector3<R>& origin,
+    const Vector3<R>& gridSpacing, const Size3& size,
+    ssize_t* i, ssize_t* j, ssize_t* k, R* fx, R* fy, R* fz) {
+    R nx[kArraySamplerBlockSize];
+    R ny[kArraySamplerBlockSize];
+    R nz[kArraySamplerBlockSize];
+    for (size_t p = 0; p < n; ++p) {
+        nx[p] = (pts[p].x - origin.x) / gridSpacing.x;
+        ny[p] = (pts[p].y - origin.y) / gridSpacing.y;
+        nz[p] = (pts[p].z - origin.z) / gridSpacing.z;
+    }
+
+    getBarycentricInBlock(nx, n, static_cast<ssize_t>(size.x) - 1, i, fx);
+    getBarycentricInBlock(ny, n, static_cast<ssize_t>(size.y) - 1, j, fy);
+    getBarycentricInBlock(nz, n, static_cast<ssize_t>(size.z) - 1, k, fz);
+}
+
+}  // namespace internal
+
 template <typename T, typename R>
 NearestArraySampler3<T, R>::NearestArraySampler(
     const ConstArrayAccessor3<T>& accessor,
@@ -148,6 +189,54 @@ T LinearArraySampler3<T, R>::operator()(const Vector3<R>& x) const {
         fz);
 }
 
+template <typename T, typename R>
+void LinearArraySampler3<T, R>::sample(
+    const ConstArrayAccessor1<Vector3<R>>& pts,
+    ArrayAccessor1<T> result) const {
+    JET_ASSERT(pts.size() == result.size());
+    JET_ASSERT(_gridSpacing.x > std::numeric_limits<R>::epsilon() &&
+               _gridSpacing.y > std::numeric_limits<R>::epsilon() &&
+               _gridSpacing.z > std::numeric_limits<R>::epsilon());
+
+    const size_t kBlockSize = internal::kArraySamplerBlockSize;
+    const Size3 size = _accessor.size();
+    const ssize_t iSize = static_cast<ssize_t>(size.x);
+    const ssize_t jSize = static_cast<ssize_t>(size.y);
+    const ssize_t kSize = static_cast<ssize_t>(size.z);
+
+    ssize_t is[kBlockSize], js[kBlockSize], ks[kBlockSize];
+    R fxs[kBlockSize], fys[kBlockSize], fzs[kBlockSize];
+
+    for (size_t begin = 0; begin < pts.size(); begin += kBlockSize) {
+        const size_t n = std::min(kBlockSize, pts.size() - begin);
+        internal::getBarycentricInBlock(
+            pts.data() + begin, n, _origin, _gridSpacing, size,
+            is, js, ks, fxs, fys, fzs);
+
+        for (size_t p = 0; p < n; ++p) {
+            const ssize_t i = is[p];
+            const ssize_t j = js[p];
+            const ssize_t k = ks[p];
+            const ssize_t ip1 = std::min(i + 1, iSize - 1);
+            const ssize_t jp1 = std::min(j + 1, jSize - 1);
+            const ssize_t kp1 = std::min(k + 1, kSize - 1);
+
+            result[begin + p] = trilerp(
+                _accessor(i, j, k),
+                _accessor(ip1, j, k),
+                _accessor(i, jp1, k),
+                _accessor(ip1, jp1, k),
+                _accessor(i, j, kp1),
+                _accessor(ip1, j, kp1),
+                _accessor(i, jp1, kp1),
+                _accessor(ip1, jp1, kp1),
+                fxs[p],
+                fys[p],
+                fzs[p]);
+        }
+    }
+}
+
 template <typename T, typename R>
 void LinearArraySampler3<T, R>::getCoordinatesAndWeights(
     const Vector3<R>& x,
@@ -345,6 +434,78 @@ T CubicArraySampler3<T, R>::operator()(const Vector3<R>& x) const {
         kValues[0], kValues[1], kValues[2], kValues[3], fz);
 }
 
+template <typename T, typename R>
+void CubicArraySampler3<T, R>::sample(
+    const ConstArrayAccessor1<Vector3<R>>& pts,
+    ArrayAccessor1<T> result) const {
+    JET_ASSERT(pts.size() == result.size());
+    JET_ASSERT(_gridSpacing.x > std::numeric_limits<R>::epsilon() &&
+               _gridSpacing.y > std::numeric_limits<R>::epsilon() &&
+               _gridSpacing.z > std::numeric_limits<R>::epsilon());
+
+    const size_t kBlockSize = internal::kArraySamplerBlockSize;
+    const Size3 size = _accessor.size();
+    const ssize_t iSize = static_cast<ssize_t>(size.x);
+    const ssize_t jSize = static_cast<ssize_t>(size.y);
+    const ssize_t kSize = static_cast<ssize_t>(size.z);
+
+    ssize_t is[kBlockSize], js[kBlockSize], ks[kBlockSize];
+    R fxs[kBlockSize], fys[kBlockSize], fzs[kBlockSize];
+
+    for (size_t begin = 0; begin < pts.size(); begin += kBlockSize) {
+        const size_t n = std::min(kBlockSize, pts.size() - begin);
+        internal::getBarycentricInBlock(
+            pts.data() + begin, n, _origin, _gridSpacing, size,
+            is, js, ks, fxs, fys, fzs);
+
+        for (size_t p = 0; p < n; ++p) {
+            const ssize_t i = is[p];
+            const ssize_t j = js[p];
+            const ssize_t k = ks[p];
+
+            const ssize_t ii[4] = {
+                std::max(i - 1, kZeroSSize),
+                i,
+                std::min(i + 1, iSize - 1),
+                std::min(i + 2, iSize - 1)
+            };
+            const ssize_t jj[4] = {
+                std::max(j - 1, kZeroSSize),
+                j,
+                std::min(j + 1, jSize - 1),
+                std::min(j + 2, jSize - 1)
+            };
+            const ssize_t kk[4] = {
+                std::max(k - 1, kZeroSSize),
+                k,
+                std::min(k + 1, kSize - 1),
+                std::min(k + 2, kSize - 1)
+            };
+
+            T kValues[4];
+
+            for (int c = 0; c < 4; ++c) {
+                T jValues[4];
+
+                for (int b = 0; b < 4; ++b) {
+                    jValues[b] = monotonicCatmullRom(
+                        _accessor(ii[0], jj[b], kk[c]),
+                        _accessor(ii[1], jj[b], kk[c]),
+                        _accessor(ii[2], jj[b], kk[c]),
+                        _accessor(ii[3], jj[b], kk[c]),
+                        fxs[p]);
+                }
+
+                kValues[c] = monotonicCatmullRom(
+                    jValues[0], jValues[1], jValues[2], jValues[3], fys[p]);
+            }
+
+            result[begin + p] = monotonicCatmullRom(
+                kValues[0], kValues[1], kValues[2], kValues[3], fzs[p]);
+        }
+    }
+}
+
 template <typename T, typename R>
 std::function<T(const Vector3<R>&)> CubicArraySampler3<T, R>::functor() const {
     CubicArraySampler sampler(*this);
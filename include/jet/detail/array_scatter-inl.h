@@ -0,0 +1,186 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_ARRAY_SCATTER_INL_H_
+#define INCLUDE_JET_DETAIL_ARRAY_SCATTER_INL_H_
+
+#include <jet/constants.h>
+#include <jet/parallel.h>
+
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <vector>
+
+namespace jet {
+
+namespace internal {
+
+// Builds the table of the first sorted entry for each base node so that the
+// entries of node c are in [offsets[c], offsets[c + 1]).
+inline void buildScatterOffsets(
+    const std::vector<std::pair<size_t, size_t>>& keys,
+    size_t numberOfNodes,
+    std::vector<size_t>* offsets) {
+    const size_t numberOfPoints = keys.size();
+    offsets->resize(numberOfNodes + 1);
+
+    parallelFor(kZeroSize, numberOfPoints + 1, [&](size_t s) {
+        const size_t begin = (s == 0) ? 0 : keys[s - 1].first + 1;
+        const size_t end
+            = (s == numberOfPoints) ? numberOfNodes : keys[s].first;
+        for (size_t c = begin; c <= end; ++c) {
+            (*offsets)[c] = s;
+        }
+    });
+}
+
+}  // namespace internal
+
+template <typename PositionFunc, typename ValueFunc>
+void scatterWeightedAverage(
+    size_t numberOfPoints,
+    const LinearArraySampler2<double, double>& sampler,
+    const PositionFunc& positionFunc,
+    const ValueFunc& valueFunc,
+    ArrayAccessor2<double> output,
+    ArrayAccessor2<char> markers) {
+    const Size2 size = output.size();
+    JET_ASSERT(markers.size() == size);
+
+    const size_t numberOfNodes = size.x * size.y;
+    if (numberOfNodes == 0) {
+        return;
+    }
+
+    // Compute weights and sort the points by their base (lower-left) node
+    std::vector<std::array<double, 4>> weights(numberOfPoints);
+    std::vector<std::pair<size_t, size_t>> keys(numberOfPoints);
+    parallelFor(kZeroSize, numberOfPoints, [&](size_t i) {
+        std::array<Point2UI, 4> indices;
+        sampler.getCoordinatesAndWeights(
+            positionFunc(i), &indices, &weights[i]);
+        keys[i].first = indices[0].x + size.x * indices[0].y;
+        keys[i].second = i;
+    });
+
+    parallelSort(keys.begin(), keys.end());
+
+    std::vector<size_t> offsets;
+    internal::buildScatterOffsets(keys, numberOfNodes, &offsets);
+
+    // Gather from the points whose base node is within one cell
+    parallelFor(kZeroSize, size.x, kZeroSize, size.y, [&](size_t i, size_t j) {
+        double sum = 0.0;
+        double weightSum = 0.0;
+        bool isTouched = false;
+
+        for (size_t dj = 0; dj <= std::min(j, kOneSize); ++dj) {
+            for (size_t di = 0; di <= std::min(i, kOneSize); ++di) {
+                const size_t bi = i - di;
+                const size_t bj = j - dj;
+                const size_t c = bi + size.x * bj;
+
+                for (size_t s = offsets[c]; s < offsets[c + 1]; ++s) {
+                    const size_t p = keys[s].second;
+                    for (size_t n = 0; n < 4; ++n) {
+                        const size_t ci = std::min(bi + (n & 1), size.x - 1);
+                        const size_t cj
+                            = std::min(bj + ((n >> 1) & 1), size.y - 1);
+                        if (ci == i && cj == j) {
+                            const double w = weights[p][n];
+                            sum += w * valueFunc(p, Point2UI(i, j));
+                            weightSum += w;
+                            isTouched = true;
+                        }
+                    }
+                }
+            }
+        }
+
+        output(i, j) = (weightSum > 0.0) ? sum / weightSum : 0.0;
+        markers(i, j) = isTouched ? 1 : 0;
+    });
+}
+
+template <typename PositionFunc, typename ValueFunc>
+void scatterWeightedAverage(
+    size_t numberOfPoints,
+    const LinearArraySampler3<double, double>& sampler,
+    const PositionFunc& positionFunc,
+    const ValueFunc& valueFunc,
+    ArrayAccessor3<double> output,
+    ArrayAccessor3<char> markers) {
+    const Size3 size = output.size();
+    JET_ASSERT(markers.size() == size);
+
+    const size_t numberOfNodes = size.x * size.y * size.z;
+    if (numberOfNodes == 0) {
+        return;
+    }
+
+    // Compute weights and sort the points by their base (lower-left) node
+    std::vector<std::array<double, 8>> weights(numberOfPoints);
+    std::vector<std::pair<size_t, size_t>> keys(numberOfPoints);
+    parallelFor(kZeroSize, numberOfPoints, [&](size_t i) {
+        std::array<Point3UI, 8> indices;
+        sampler.getCoordinatesAndWeights(
+            positionFunc(i), &indices, &weights[i]);
+        keys[i].first
+            = indices[0].x + size.x * (indices[0].y + size.y * indices[0].z);
+        keys[i].second = i;
+    });
+
+    parallelSort(keys.begin(), keys.end());
+
+    std::vector<size_t> offsets;
+    internal::buildScatterOffsets(keys, numberOfNodes, &offsets);
+
+    // Gather from the points whose base node is within one cell
+    parallelFor(
+        kZeroSize, size.x, kZeroSize, size.y, kZeroSize, size.z,
+        [&](size_t i, size_t j, size_t k) {
+            double sum = 0.0;
+            double weightSum = 0.0;
+            bool isTouched = false;
+
+            for (size_t dk = 0; dk <= std::min(k, kOneSize); ++dk) {
+                for (size_t dj = 0; dj <= std::min(j, kOneSize); ++dj) {
+                    for (size_t di = 0; di <= std::min(i, kOneSize); ++di) {
+                        const size_t bi = i - di;
+                        const size_t bj = j - dj;
+                        const size_t bk = k - dk;
+                        const size_t c = bi + size.x * (bj + size.y * bk);
+
+                        for (size_t s = offsets[c]; s < offsets[c + 1]; ++s) {
+                            const size_t p = keys[s].second;
+                            for (size_t n = 0; n < 8; ++n) {
+                                const size_t ci
+                                    = std::min(bi + (n & 1), size.x - 1);
+                                const size_t cj
+                                    = std::min(bj + ((n >> 1) & 1), size.y - 1);
+                                const size_t ck
+                                    = std::min(bk + ((n >> 2) & 1), size.z - 1);
+                                if (ci == i && cj == j && ck == k) {
+                                    const double w = weights[p][n];
+                                    sum += w * valueFunc(p, Point3UI(i, j, k));
+                                    weightSum += w;
+                                    isTouched = true;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            output(i, j, k) = (weightSum > 0.0) ? sum / weightSum : 0.0;
+            markers(i, j, k) = isTouched ? 1 : 0;
+        });
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_ARRAY_SCATTER_INL_H_
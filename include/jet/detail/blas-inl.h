@@ -63,6 +63,33 @@ void Blas<ScalarType, VectorType, MatrixType>::residual(
     *result = b - a * x;
 }
 
+template <typename ScalarType, typename VectorType, typename MatrixType>
+void Blas<ScalarType, VectorType, MatrixType>::mvmDot(
+    const MatrixType& m,
+    const VectorType& v,
+    VectorType* result,
+    ScalarType* vDotV,
+    ScalarType* vDotResult) {
+    *result = m * v;
+    *vDotV = v.dot(v);
+    *vDotResult = v.dot(*result);
+}
+
+template <typename ScalarType, typename VectorType, typename MatrixType>
+void Blas<ScalarType, VectorType, MatrixType>::cgUpdate(
+    ScalarType alpha,
+    ScalarType beta,
+    const VectorType& w,
+    VectorType* r,
+    VectorType* p,
+    VectorType* s,
+    VectorType* x) {
+    *p = *r + beta * *p;
+    *s = w + beta * *s;
+    *x += alpha * *p;
+    *r -= alpha * *s;
+}
+
 template <typename ScalarType, typename VectorType, typename MatrixType>
 ScalarType Blas<ScalarType, VectorType, MatrixType>::l2Norm(
     const VectorType& v) {
@@ -123,6 +123,72 @@ void cg(
         lastResidualNorm);
 }
 
+template <typename BlasType>
+void cgFused(
+    const typename BlasType::MatrixType& A,
+    const typename BlasType::VectorType& b,
+    unsigned int maxNumberOfIterations,
+    double tolerance,
+    typename BlasType::VectorType* x,
+    typename BlasType::VectorType* r,
+    typename BlasType::VectorType* d,
+    typename BlasType::VectorType* q,
+    typename BlasType::VectorType* s,
+    unsigned int* lastNumberOfIterations,
+    double* lastResidualNorm) {
+    // Clear
+    BlasType::set(0, r);
+    BlasType::set(0, d);
+    BlasType::set(0, q);
+    BlasType::set(0, s);
+
+    // r = b - Ax
+    BlasType::residual(A, *x, b, r);
+
+    // q = Ar, sigmaNew = r.r, delta = r.q
+    double sigmaNew = 0.0;
+    double delta = 0.0;
+    BlasType::mvmDot(A, *r, q, &sigmaNew, &delta);
+
+    double alpha = sigmaNew / delta;
+    double beta = 0.0;
+
+    unsigned int iter = 0;
+    bool trigger = false;
+    while (sigmaNew > square(tolerance) && iter < maxNumberOfIterations) {
+        // d = r + beta*d, s = q + beta*s, x = x + alpha*d, r = r - alpha*s
+        BlasType::cgUpdate(alpha, beta, *q, r, d, s, x);
+
+        ++iter;
+
+        // if i is divisible by 50...
+        if (trigger || iter % 50 == 0) {
+            // r = b - Ax
+            BlasType::residual(A, *x, b, r);
+            trigger = false;
+        }
+
+        // sigmaOld = sigmaNew
+        double sigmaOld = sigmaNew;
+
+        // q = Ar, sigmaNew = r.r, delta = r.q
+        BlasType::mvmDot(A, *r, q, &sigmaNew, &delta);
+
+        if (sigmaNew > sigmaOld) {
+            trigger = true;
+        }
+
+        // beta = sigmaNew/sigmaOld, alpha = sigmaNew/d.Ad
+        beta = sigmaNew / sigmaOld;
+        alpha = sigmaNew / (delta - beta * sigmaNew / alpha);
+    }
+
+    *lastNumberOfIterations = iter;
+
+    // std::fabs(sigmaNew) - Workaround for negative zero
+    *lastResidualNorm = std::sqrt(std::fabs(sigmaNew));
+}
+
 }  // namespace jet
 
 #endif  // INCLUDE_JET_DETAIL_CG_INL_H_
@@ -0,0 +1,49 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_NEIGHBOR_LISTS_INL_H_
+#define INCLUDE_JET_DETAIL_NEIGHBOR_LISTS_INL_H_
+
+#include <jet/constants.h>
+#include <jet/macros.h>
+#include <jet/parallel.h>
+
+#include <limits>
+
+namespace jet {
+
+template <typename CountFunc, typename FillFunc>
+void NeighborLists::build(size_t numberOfLists, const CountFunc& countFunc,
+                          const FillFunc& fillFunc) {
+    // The neighbors are indexed with IndexType
+    JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(
+        numberOfLists > static_cast<size_t>(
+                            std::numeric_limits<IndexType>::max()),
+        "The number of lists exceeds the range of the neighbor index type.");
+
+    _offsets.resize(numberOfLists + 1);
+    _offsets[0] = 0;
+
+    // Count
+    parallelFor(kZeroSize, numberOfLists,
+                [&](size_t i) { _offsets[i + 1] = countFunc(i); });
+
+    // Inclusive scan of the counts, which leaves the start offset of the
+    // i-th list in _offsets[i] since _offsets[0] is zero
+    for (size_t i = 0; i < numberOfLists; ++i) {
+        _offsets[i + 1] += _offsets[i];
+    }
+
+    // Fill
+    _indices.resize(_offsets[numberOfLists]);
+    parallelFor(kZeroSize, numberOfLists, [&](size_t i) {
+        fillFunc(i, _indices.data() + _offsets[i]);
+    });
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_NEIGHBOR_LISTS_INL_H_
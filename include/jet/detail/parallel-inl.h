@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <functional>
 #include <future>
+#include <memory>
 #include <vector>
 
 #ifdef JET_TASKING_TBB
@@ -21,6 +22,7 @@
 #include <tbb/parallel_sort.h>
 #include <tbb/task.h>
 #elif defined(JET_TASKING_CPP11THREADS)
+#include <atomic>
 #include <thread>
 #endif
 
@@ -28,6 +30,57 @@ namespace jet {
 
 namespace internal {
 
+#ifdef JET_TASKING_CPP11THREADS
+//!
+//! \brief Persistent work-stealing thread pool for the C++11 thread backend.
+//!
+//! The pool is started lazily on the first submitted task and keeps its worker
+//! threads alive for the lifetime of the process. Each worker owns a task
+//! queue; tasks spawned from a worker are pushed to its own queue and popped
+//! in LIFO order, while idle workers steal the oldest task from the others.
+//! The number of workers follows setMaxNumberOfThreads().
+//!
+class ThreadPool {
+ public:
+    //! Returns the process-wide pool instance.
+    static ThreadPool& instance();
+
+    //! Submits a task to the pool.
+    void enqueue(std::function<void()> task);
+
+    //! Runs one pending task on the calling thread if available.
+    bool tryRunPendingTask();
+
+    //!
+    //! Resizes the pool. Must not be called while tasks are in flight, and
+    //! throws std::invalid_argument if called from a task since the worker
+    //! running it would have to join itself.
+    //!
+    void resize(unsigned int numThreads);
+
+    //! Returns the number of worker threads (started or not).
+    unsigned int numberOfThreads() const;
+
+    //!
+    //! Blocks until \p isDone returns true while executing pending tasks. The
+    //! calling thread sleeps while there is no task to run, and it is woken
+    //! up whenever a task is submitted or finished.
+    //!
+    void waitUntil(const std::function<bool()>& isDone);
+
+ private:
+    struct Impl;
+
+    std::unique_ptr<Impl> _impl;
+
+    ThreadPool();
+
+    ~ThreadPool();
+
+    JET_NON_COPYABLE(ThreadPool)
+};
+#endif  // JET_TASKING_CPP11THREADS
+
 // NOTE - This abstraction takes a lambda which should take captured
 //        variables by *value* to ensure no captured references race
 //        with the task itself.
@@ -47,8 +100,7 @@ inline void schedule(TASK_T&& fcn) {
         LocalTBBTask(std::forward<TASK_T>(fcn));
     tbb::task::enqueue(*tbb_node);
 #elif defined(JET_TASKING_CPP11THREADS)
-    std::thread thread(fcn);
-    thread.detach();
+    ThreadPool::instance().enqueue(std::forward<TASK_T>(fcn));
 #else  // OpenMP or Serial --> synchronous!
     fcn();
 #endif
@@ -73,6 +125,24 @@ inline auto async(TASK_T&& fcn) -> std::future<operator_return_t<TASK_T>> {
     return future;
 }
 
+// Waits for the future. With the thread pool backend, the waiting thread keeps
+// executing pending tasks so that nested parallel calls cannot deadlock.
+template <typename T>
+inline void wait(std::future<T>& future) {
+    if (!future.valid()) {
+        return;
+    }
+
+#ifdef JET_TASKING_CPP11THREADS
+    ThreadPool::instance().waitUntil([&future]() {
+        return future.wait_for(std::chrono::seconds(0)) ==
+               std::future_status::ready;
+    });
+#else
+    future.wait();
+#endif
+}
+
 // Adopted from:
 // Radenski, A.
 // Shared Memory, Message Passing, and Hybrid Merge Sorts for Standalone and
@@ -141,15 +211,49 @@ void parallelMergeSort(RandomIterator a, size_t size, RandomIterator2 temp,
 
         // Wait for jobs to finish
         for (auto& f : pool) {
-            if (f.valid()) {
-                f.wait();
-            }
+            internal::wait(f);
         }
 
         merge(a, size, temp, compareFunction);
     }
 }
 
+// Maximum number of leaf subranges of the deterministic reduction tree.
+const size_t kDeterministicReduceMaxNumberOfBlocks = 256;
+
+template <typename IndexType, typename Value, typename Function,
+          typename Reduce>
+Value deterministicReduce(IndexType start, IndexType end,
+                          const Value& identity, const Function& func,
+                          const Reduce& reduce, ExecutionPolicy policy) {
+    // Block boundaries depend only on the range size
+    const size_t n = static_cast<size_t>(end - start);
+    const size_t numBlocks = std::min(n, kDeterministicReduceMaxNumberOfBlocks);
+    if (numBlocks == 0) {
+        return identity;
+    }
+
+    std::vector<Value> results(numBlocks, identity);
+    parallelFor(kZeroSize, numBlocks,
+                [&](size_t b) {
+                    IndexType blockBegin =
+                        start + static_cast<IndexType>(b * n / numBlocks);
+                    IndexType blockEnd =
+                        start + static_cast<IndexType>((b + 1) * n / numBlocks);
+                    results[b] = func(blockBegin, blockEnd, identity);
+                },
+                policy);
+
+    // Pairwise tree reduction in a fixed order
+    for (size_t stride = 1; stride < numBlocks; stride *= 2) {
+        for (size_t b = 0; b + stride < numBlocks; b += 2 * stride) {
+            results[b] = reduce(results[b], results[b + stride]);
+        }
+    }
+
+    return results[0];
+}
+
 }  // namespace internal
 
 template <typename RandomIterator, typename T>
@@ -203,26 +307,25 @@ void parallelFor(IndexType start, IndexType end, const Function& func,
         }
     };
 
-    // Create pool and launch jobs
-    std::vector<std::thread> pool;
-    pool.reserve(numThreads);
+    // Launch all but the last slice on the pool and run the last one on the
+    // calling thread
+    std::atomic<unsigned int> numPendingSlices(0);
     IndexType i1 = start;
     IndexType i2 = std::min(start + slice, end);
-    for (unsigned int i = 0; i + 1 < numThreads && i1 < end; ++i) {
-        pool.emplace_back(launchRange, i1, i2);
+    for (unsigned int i = 0; i + 1 < numThreads && i2 < end; ++i) {
+        ++numPendingSlices;
+        internal::schedule([&launchRange, &numPendingSlices, i1, i2]() {
+            launchRange(i1, i2);
+            --numPendingSlices;
+        });
         i1 = i2;
         i2 = std::min(i2 + slice, end);
     }
-    if (i1 < end) {
-        pool.emplace_back(launchRange, i1, end);
-    }
+    launchRange(i1, end);
 
     // Wait for jobs to finish
-    for (std::thread& t : pool) {
-        if (t.joinable()) {
-            t.join();
-        }
-    }
+    internal::ThreadPool::instance().waitUntil(
+        [&numPendingSlices]() { return numPendingSlices == 0; });
 #else
 
 #ifdef JET_TASKING_OPENMP
@@ -296,9 +399,7 @@ void parallelRangeFor(IndexType start, IndexType end, const Function& func,
 
     // Wait for jobs to finish
     for (auto& f : pool) {
-        if (f.valid()) {
-            f.wait();
-        }
+        internal::wait(f);
     }
 #endif
 }
@@ -360,11 +461,16 @@ template <typename IndexType, typename Value, typename Function,
           typename Reduce>
 Value parallelReduce(IndexType start, IndexType end, const Value& identity,
                      const Function& func, const Reduce& reduce,
-                     ExecutionPolicy policy) {
+                     ExecutionPolicy policy, ReductionMode mode) {
     if (start > end) {
         return identity;
     }
 
+    if (mode == ReductionMode::kDeterministic) {
+        return internal::deterministicReduce(start, end, identity, func,
+                                             reduce, policy);
+    }
+
 #ifdef JET_TASKING_TBB
     if (policy == ExecutionPolicy::kParallel) {
         return tbb::parallel_reduce(
@@ -419,9 +525,7 @@ Value parallelReduce(IndexType start, IndexType end, const Value& identity,
 
     // Wait for jobs to finish
     for (auto& f : pool) {
-        if (f.valid()) {
-            f.wait();
-        }
+        internal::wait(f);
     }
 
     // Gather
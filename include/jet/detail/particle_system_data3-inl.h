@@ -0,0 +1,98 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_PARTICLE_SYSTEM_DATA3_INL_H_
+#define INCLUDE_JET_DETAIL_PARTICLE_SYSTEM_DATA3_INL_H_
+
+#include <jet/constants.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace jet {
+
+template <typename Callback>
+void ParticleSystemData3::forEachNeighbor(
+    size_t i, const Callback& callback) const {
+    if (_useNeighborLists) {
+        for (size_t j : _neighborLists[i]) {
+            callback(j);
+        }
+        return;
+    }
+
+    // Since the grid spacing is not smaller than the search radius, the
+    // neighbors are within the 27 cells around the particle.
+    const PointSparseHashGridSearcher3& searcher = *_cellSearcher;
+    const std::vector<Vector3D>& points = searcher.points();
+    const std::vector<size_t>& sortedIndices = searcher.sortedIndices();
+
+    const Vector3D& origin = _vectorDataList[_positionIdx][i];
+    const double radiusSquared
+        = _neighborListsSearchRadius * _neighborListsSearchRadius;
+
+    const Point3I originIndex = searcher.getBucketIndex(origin);
+    Point3I cell;
+    for (cell.z = originIndex.z - 1; cell.z <= originIndex.z + 1; ++cell.z) {
+        for (cell.y = originIndex.y - 1; cell.y <= originIndex.y + 1;
+             ++cell.y) {
+            // The points are sorted in (z, y, x) order of the cells which are
+            // never wrapped, so the three cells in a row form one contiguous
+            // range of the sorted arrays.
+            size_t start = kMaxSize;
+            size_t end = 0;
+            for (cell.x = originIndex.x - 1; cell.x <= originIndex.x + 1;
+                 ++cell.x) {
+                size_t cellStart, cellEnd;
+                searcher.getBucketRange(cell, &cellStart, &cellEnd);
+                if (cellStart < cellEnd) {
+                    start = std::min(start, cellStart);
+                    end = std::max(end, cellEnd);
+                }
+            }
+
+            for (size_t k = start; k < end; ++k) {
+                if (points[k].distanceSquaredTo(origin) <= radiusSquared
+                    && sortedIndices[k] != i) {
+                    callback(sortedIndices[k]);
+                }
+            }
+        }
+    }
+}
+
+template <typename Callback>
+void ParticleSystemData3::forEachNeighborBatch(
+    size_t i, const Callback& callback) const {
+    typedef NeighborLists::IndexType IndexType;
+
+    if (_useNeighborLists) {
+        const NeighborLists::ConstList neighbors = _neighborLists[i];
+        const IndexType* indices = neighbors.data();
+        const size_t n = neighbors.size();
+        for (size_t k = 0; k < n; k += kNeighborBatchSize) {
+            callback(indices + k, std::min(n - k, kNeighborBatchSize));
+        }
+        return;
+    }
+
+    IndexType indices[kNeighborBatchSize];
+    size_t n = 0;
+    forEachNeighbor(i, [&](size_t j) {
+        indices[n++] = static_cast<IndexType>(j);
+        if (n == kNeighborBatchSize) {
+            callback(static_cast<const IndexType*>(indices), n);
+            n = 0;
+        }
+    });
+    if (n > 0) {
+        callback(static_cast<const IndexType*>(indices), n);
+    }
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_PARTICLE_SYSTEM_DATA3_INL_H_
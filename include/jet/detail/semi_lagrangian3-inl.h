@@ -0,0 +1,207 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_SEMI_LAGRANGIAN3_INL_H_
+#define INCLUDE_JET_DETAIL_SEMI_LAGRANGIAN3_INL_H_
+
+#include <jet/math_utils.h>
+
+#include <vector>
+
+namespace jet {
+
+namespace internal {
+
+inline Vector3D SemiLagrangianFlowSampler3::operator()(
+    const Vector3D& x) const {
+    if (_isFaceCentered) {
+        return Vector3D(_uSampler(x), _vSampler(x), _wSampler(x));
+    } else {
+        return _flow.sample(x);
+    }
+}
+
+inline bool isCoLocated(const ScalarGrid3& a, const ScalarGrid3& b) {
+    return a.hasSameShape(b) && a.dataSize() == b.dataSize() &&
+           a.dataOrigin() == b.dataOrigin();
+}
+
+}  // namespace internal
+
+template <typename InputSampler>
+void SemiLagrangian3::advectScalar(
+    const ScalarGrid3& input,
+    const InputSampler& inputSampler,
+    const VectorField3& flow,
+    double dt,
+    ScalarGrid3* output,
+    const ScalarField3& boundarySdf) {
+    auto outputDataPos = output->dataPosition();
+    auto outputDataAcc = output->dataAccessor();
+    auto inputDataPos = input.dataPosition();
+    internal::SemiLagrangianFlowSampler3 flowSampler(flow);
+
+    double h = min3(
+        output->gridSpacing().x,
+        output->gridSpacing().y,
+        output->gridSpacing().z);
+
+    output->parallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        if (boundarySdf.sample(inputDataPos(i, j, k)) > 0.0) {
+            Vector3D pt = backTrace(
+                flowSampler, dt, h, outputDataPos(i, j, k), boundarySdf);
+            outputDataAcc(i, j, k) = inputSampler(pt);
+        }
+    });
+}
+
+template <typename InputSampler>
+void SemiLagrangian3::advectCoLocatedScalars(
+    const std::vector<const ScalarGrid3*>& inputs,
+    const std::vector<InputSampler>& inputSamplers,
+    const VectorField3& flow,
+    double dt,
+    const std::vector<ScalarGrid3*>& outputs,
+    const ScalarField3& boundarySdf) {
+    JET_THROW_INVALID_ARG_IF(inputs.size() != outputs.size());
+    JET_THROW_INVALID_ARG_IF(inputs.size() != inputSamplers.size());
+
+    internal::SemiLagrangianFlowSampler3 flowSampler(flow);
+
+    size_t n = inputs.size();
+    std::vector<char> isAdvected(n, 0);
+    std::vector<size_t> group;
+    std::vector<ScalarGrid3::ScalarDataAccessor> outputDataAccs;
+
+    for (size_t first = 0; first < n; ++first) {
+        if (isAdvected[first]) {
+            continue;
+        }
+
+        const ScalarGrid3& input = *inputs[first];
+        ScalarGrid3* output = outputs[first];
+
+        // Collect the grids sharing the data points with the first one
+        group.clear();
+        outputDataAccs.clear();
+        for (size_t m = first; m < n; ++m) {
+            if (!isAdvected[m] &&
+                internal::isCoLocated(input, *inputs[m]) &&
+                internal::isCoLocated(*output, *outputs[m])) {
+                group.push_back(m);
+                outputDataAccs.push_back(outputs[m]->dataAccessor());
+                isAdvected[m] = 1;
+            }
+        }
+
+        double h = min3(
+            output->gridSpacing().x,
+            output->gridSpacing().y,
+            output->gridSpacing().z);
+
+        auto outputDataPos = output->dataPosition();
+        auto inputDataPos = input.dataPosition();
+
+        output->parallelForEachDataPointIndex(
+            [&](size_t i, size_t j, size_t k) {
+                if (boundarySdf.sample(inputDataPos(i, j, k)) > 0.0) {
+                    Vector3D pt = backTrace(
+                        flowSampler, dt, h, outputDataPos(i, j, k),
+                        boundarySdf);
+                    for (size_t m = 0; m < group.size(); ++m) {
+                        outputDataAccs[m](i, j, k)
+                            = inputSamplers[group[m]](pt);
+                    }
+                }
+            });
+    }
+}
+
+template <typename InputSampler>
+void SemiLagrangian3::advectCollocated(
+    const CollocatedVectorGrid3& input,
+    const InputSampler& inputSampler,
+    const VectorField3& flow,
+    double dt,
+    CollocatedVectorGrid3* output,
+    const ScalarField3& boundarySdf) {
+    internal::SemiLagrangianFlowSampler3 flowSampler(flow);
+
+    double h = min3(
+        output->gridSpacing().x,
+        output->gridSpacing().y,
+        output->gridSpacing().z);
+
+    auto outputDataPos = output->dataPosition();
+    auto outputDataAcc = output->dataAccessor();
+    auto inputDataPos = input.dataPosition();
+
+    output->parallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        if (boundarySdf.sample(inputDataPos(i, j, k)) > 0.0) {
+            Vector3D pt = backTrace(
+                flowSampler, dt, h, outputDataPos(i, j, k), boundarySdf);
+            outputDataAcc(i, j, k) = inputSampler(pt);
+        }
+    });
+}
+
+template <typename ComponentSampler>
+void SemiLagrangian3::advectFaceCentered(
+    const FaceCenteredGrid3& input,
+    const ComponentSampler& uSampler,
+    const ComponentSampler& vSampler,
+    const ComponentSampler& wSampler,
+    const VectorField3& flow,
+    double dt,
+    FaceCenteredGrid3* output,
+    const ScalarField3& boundarySdf) {
+    internal::SemiLagrangianFlowSampler3 flowSampler(flow);
+
+    double h = min3(
+        output->gridSpacing().x,
+        output->gridSpacing().y,
+        output->gridSpacing().z);
+
+    auto uTargetDataPos = output->uPosition();
+    auto uTargetDataAcc = output->uAccessor();
+    auto uSourceDataPos = input.uPosition();
+
+    output->parallelForEachUIndex([&](size_t i, size_t j, size_t k) {
+        if (boundarySdf.sample(uSourceDataPos(i, j, k)) > 0.0) {
+            Vector3D pt = backTrace(
+                flowSampler, dt, h, uTargetDataPos(i, j, k), boundarySdf);
+            uTargetDataAcc(i, j, k) = uSampler(pt);
+        }
+    });
+
+    auto vTargetDataPos = output->vPosition();
+    auto vTargetDataAcc = output->vAccessor();
+    auto vSourceDataPos = input.vPosition();
+
+    output->parallelForEachVIndex([&](size_t i, size_t j, size_t k) {
+        if (boundarySdf.sample(vSourceDataPos(i, j, k)) > 0.0) {
+            Vector3D pt = backTrace(
+                flowSampler, dt, h, vTargetDataPos(i, j, k), boundarySdf);
+            vTargetDataAcc(i, j, k) = vSampler(pt);
+        }
+    });
+
+    auto wTargetDataPos = output->wPosition();
+    auto wTargetDataAcc = output->wAccessor();
+    auto wSourceDataPos = input.wPosition();
+
+    output->parallelForEachWIndex([&](size_t i, size_t j, size_t k) {
+        if (boundarySdf.sample(wSourceDataPos(i, j, k)) > 0.0) {
+            Vector3D pt = backTrace(
+                flowSampler, dt, h, wTargetDataPos(i, j, k), boundarySdf);
+            wTargetDataAcc(i, j, k) = wSampler(pt);
+        }
+    });
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_SEMI_LAGRANGIAN3_INL_H_
@@ -14,6 +14,8 @@
 
 #include <jet/constants.h>
 
+#include <cmath>
+
 namespace jet {
 
 inline SphStdKernel3::SphStdKernel3()
@@ -68,6 +70,60 @@ inline double SphStdKernel3::secondDerivative(double distance) const {
     }
 }
 
+inline void SphStdKernel3::values(
+    const double* distances, size_t n, double* results) const {
+    const double coeff = 315.0 / (64.0 * kPiD * h3);
+    for (size_t i = 0; i < n; ++i) {
+        const double distanceSquared = distances[i] * distances[i];
+        const double x = 1.0 - distanceSquared / h2;
+        results[i] = (distanceSquared < h2) ? coeff * x * x * x : 0.0;
+    }
+}
+
+inline void SphStdKernel3::valuesFromSquaredDistances(
+    const double* squaredDistances, size_t n, double* results) const {
+    const double coeff = 315.0 / (64.0 * kPiD * h3);
+    for (size_t i = 0; i < n; ++i) {
+        const double x = 1.0 - squaredDistances[i] / h2;
+        results[i] = (squaredDistances[i] < h2) ? coeff * x * x * x : 0.0;
+    }
+}
+
+inline void SphStdKernel3::firstDerivatives(
+    const double* distances, size_t n, double* results) const {
+    const double coeff = -945.0 / (32.0 * kPiD * h5);
+    for (size_t i = 0; i < n; ++i) {
+        const double distance = distances[i];
+        const double x = 1.0 - distance * distance / h2;
+        results[i] = (distance < h) ? coeff * distance * x * x : 0.0;
+    }
+}
+
+inline void SphStdKernel3::gradients(
+    const double* distances,
+    const Vector3D* directions,
+    size_t n,
+    Vector3D* results) const {
+    const double coeff = -945.0 / (32.0 * kPiD * h5);
+    for (size_t i = 0; i < n; ++i) {
+        const double distance = distances[i];
+        const double x = 1.0 - distance * distance / h2;
+        const double d = (distance < h) ? coeff * distance * x * x : 0.0;
+        results[i] = -d * directions[i];
+    }
+}
+
+inline void SphStdKernel3::secondDerivatives(
+    const double* distances, size_t n, double* results) const {
+    const double coeff = 945.0 / (32.0 * kPiD * h5);
+    for (size_t i = 0; i < n; ++i) {
+        const double distanceSquared = distances[i] * distances[i];
+        const double x = distanceSquared / h2;
+        results[i] = (distanceSquared < h2)
+            ? coeff * (1 - x) * (5 * x - 1) : 0.0;
+    }
+}
+
 inline SphSpikyKernel3::SphSpikyKernel3()
     : h(0), h2(0), h3(0), h4(0), h5(0) {}
 
@@ -120,6 +176,56 @@ inline double SphSpikyKernel3::secondDerivative(double distance) const {
     }
 }
 
+inline void SphSpikyKernel3::values(
+    const double* distances, size_t n, double* results) const {
+    const double coeff = 15.0 / (kPiD * h3);
+    for (size_t i = 0; i < n; ++i) {
+        const double x = 1.0 - distances[i] / h;
+        results[i] = (distances[i] < h) ? coeff * x * x * x : 0.0;
+    }
+}
+
+inline void SphSpikyKernel3::valuesFromSquaredDistances(
+    const double* squaredDistances, size_t n, double* results) const {
+    const double coeff = 15.0 / (kPiD * h3);
+    for (size_t i = 0; i < n; ++i) {
+        const double distance = std::sqrt(squaredDistances[i]);
+        const double x = 1.0 - distance / h;
+        results[i] = (distance < h) ? coeff * x * x * x : 0.0;
+    }
+}
+
+inline void SphSpikyKernel3::firstDerivatives(
+    const double* distances, size_t n, double* results) const {
+    const double coeff = -45.0 / (kPiD * h4);
+    for (size_t i = 0; i < n; ++i) {
+        const double x = 1.0 - distances[i] / h;
+        results[i] = (distances[i] < h) ? coeff * x * x : 0.0;
+    }
+}
+
+inline void SphSpikyKernel3::gradients(
+    const double* distances,
+    const Vector3D* directions,
+    size_t n,
+    Vector3D* results) const {
+    const double coeff = -45.0 / (kPiD * h4);
+    for (size_t i = 0; i < n; ++i) {
+        const double x = 1.0 - distances[i] / h;
+        const double d = (distances[i] < h) ? coeff * x * x : 0.0;
+        results[i] = -d * directions[i];
+    }
+}
+
+inline void SphSpikyKernel3::secondDerivatives(
+    const double* distances, size_t n, double* results) const {
+    const double coeff = 90.0 / (kPiD * h5);
+    for (size_t i = 0; i < n; ++i) {
+        const double x = 1.0 - distances[i] / h;
+        results[i] = (distances[i] < h) ? coeff * x : 0.0;
+    }
+}
+
 }  // namespace jet
 
 #endif  // INCLUDE_JET_DETAIL_SPH_KERNELS3_INL_H_
@@ -0,0 +1,149 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DF_SPH_SOLVER3_H_
+#define INCLUDE_JET_DF_SPH_SOLVER3_H_
+
+#include <jet/sph_solver3.h>
+
+namespace jet {
+
+//!
+//! \brief 3-D divergence-free SPH (DFSPH) solver.
+//!
+//! This class implements 3-D divergence-free SPH solver based on Bender and
+//! Koschier's 2015 SCA paper. Instead of converting the density error into
+//! pressure forces with a stiff equation of state, the solver corrects the
+//! velocities so that both the density error and the divergence of the
+//! velocity field vanish. Since the time step does not depend on the speed of
+//! sound, the time step is limited by the CFL condition only which allows
+//! much larger steps than SphSolver3 and PciSphSolver3.
+//!
+//! \see Bender and Koschier, Divergence-free smoothed particle hydrodynamics,
+//!      Proceedings of the 14th ACM SIGGRAPH/Eurographics Symposium on
+//!      Computer Animation. ACM, 2015.
+//!
+class DfSphSolver3 : public SphSolver3 {
+ public:
+    class Builder;
+
+    //! Constructs a solver with empty particle set.
+    DfSphSolver3();
+
+    //! Constructs a solver with target density, spacing, and relative kernel
+    //! radius.
+    DfSphSolver3(
+        double targetDensity,
+        double targetSpacing,
+        double relativeKernelRadius);
+
+    virtual ~DfSphSolver3();
+
+    //! Returns max allowed density error ratio.
+    double maxDensityErrorRatio() const;
+
+    //!
+    //! \brief Sets max allowed density error ratio.
+    //!
+    //! This function sets the max allowed ratio of the largest per-particle
+    //! density error to the target density for the density solver, the same
+    //! criterion as PciSphSolver3. Default is 0.01 (1%). The input value
+    //! should be positive.
+    //!
+    void setMaxDensityErrorRatio(double ratio);
+
+    //! Returns max allowed average divergence error ratio.
+    double maxDivergenceErrorRatio() const;
+
+    //!
+    //! \brief Sets max allowed average divergence error ratio.
+    //!
+    //! This function sets the max allowed ratio of the average density change
+    //! over a time step to the target density for the divergence solver.
+    //! Default is 0.001 (0.1%). The input value should be positive.
+    //!
+    void setMaxDivergenceErrorRatio(double ratio);
+
+    //! Returns max number of iterations.
+    unsigned int maxNumberOfIterations() const;
+
+    //!
+    //! \brief Sets max number of iterations.
+    //!
+    //! This function sets the max number of iterations of both density and
+    //! divergence solvers. Default is 100.
+    //!
+    void setMaxNumberOfIterations(unsigned int n);
+
+    //! Returns the CFL number.
+    double maxCfl() const;
+
+    //!
+    //! \brief Sets the CFL number.
+    //!
+    //! The sub-time step is chosen so that no particle moves more than the
+    //! CFL number times the target spacing. Default is 0.4. The input value
+    //! should be positive.
+    //!
+    void setMaxCfl(double newCfl);
+
+    //! Returns builder fox DfSphSolver3.
+    static Builder builder();
+
+ protected:
+    //! Returns the number of sub-time-steps from the CFL condition.
+    unsigned int numberOfSubTimeSteps(
+        double timeIntervalInSeconds) const override;
+
+    //! Accumulates the pressure force to the forces array in the particle
+    //! system.
+    void accumulatePressureForce(double timeIntervalInSeconds) override;
+
+    //! Performs pre-processing step before the simulation.
+    void onBeginAdvanceTimeStep(double timeStepInSeconds) override;
+
+ private:
+    double _maxDensityErrorRatio = 0.01;
+    double _maxDivergenceErrorRatio = 0.001;
+    unsigned int _maxNumberOfIterations = 100;
+    double _maxCfl = 0.4;
+
+    ParticleSystemData3::ScalarData _alphas;
+    ParticleSystemData3::ScalarData _kappas;
+    ParticleSystemData3::ScalarData _densityErrors;
+    ParticleSystemData3::VectorData _tempPositions;
+    ParticleSystemData3::VectorData _tempVelocities;
+
+    void computeAlphas();
+
+    void correctDivergenceError(double timeStepInSeconds);
+
+    void correctDensityError(double timeStepInSeconds);
+
+    void computeDensityChanges(double timeStepInSeconds);
+
+    void applyKappas(double timeStepInSeconds);
+};
+
+//! Shared pointer type for the DfSphSolver3.
+typedef std::shared_ptr<DfSphSolver3> DfSphSolver3Ptr;
+
+//!
+//! \brief Front-end to create DfSphSolver3 objects step by step.
+//!
+class DfSphSolver3::Builder final
+    : public SphSolverBuilderBase3<DfSphSolver3::Builder> {
+ public:
+    //! Builds DfSphSolver3.
+    DfSphSolver3 build() const;
+
+    //! Builds shared pointer of DfSphSolver3 instance.
+    DfSphSolver3Ptr makeShared() const;
+};
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DF_SPH_SOLVER3_H_
@@ -252,6 +252,21 @@ class FaceCenteredGrid3 final : public VectorGrid3 {
     //!
     std::function<Vector3D(const Vector3D&)> sampler() const override;
 
+    //!
+    //! \brief Returns the linear sampler for the u-data.
+    //!
+    //! Unlike FaceCenteredGrid3::sampler, the returned sampler is statically
+    //! typed so that it can be inlined in the hot loops. The sampler refers to
+    //! the grid data and becomes invalid when the grid is resized.
+    //!
+    const LinearArraySampler3<double, double>& uLinearSampler() const;
+
+    //! Returns the linear sampler for the v-data.
+    const LinearArraySampler3<double, double>& vLinearSampler() const;
+
+    //! Returns the linear sampler for the w-data.
+    const LinearArraySampler3<double, double>& wLinearSampler() const;
+
     //! Returns builder fox FaceCenteredGrid3.
     static Builder builder();
 
@@ -24,6 +24,9 @@ class FdmCgSolver3 final : public FdmLinearSystemSolver3 {
     //! Solves the given compressed linear system.
     bool solveCompressed(FdmCompressedLinearSystem3* system) override;
 
+    //! Solves the given matrix-free linear system.
+    bool solveMatrixFree(FdmMatrixFreeLinearSystem3* system) override;
+
     //! Returns the max number of CG iterations.
     unsigned int maxNumberOfIterations() const;
 
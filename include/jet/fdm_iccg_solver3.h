@@ -26,6 +26,9 @@ class FdmIccgSolver3 final : public FdmLinearSystemSolver3 {
     //! Solves the given compressed linear system.
     bool solveCompressed(FdmCompressedLinearSystem3* system) override;
 
+    //! Solves the given matrix-free linear system.
+    bool solveMatrixFree(FdmMatrixFreeLinearSystem3* system) override;
+
     //! Returns the max number of ICCG iterations.
     unsigned int maxNumberOfIterations() const;
 
@@ -39,12 +42,15 @@ class FdmIccgSolver3 final : public FdmLinearSystemSolver3 {
     double lastResidual() const;
 
  private:
+    //! Incomplete Cholesky preconditioner for the 7-point matrices, either
+    //! stored (FdmBlas3) or computed on the fly (FdmMatrixFreeBlas3).
+    template <typename BlasType>
     struct Preconditioner final {
-        ConstArrayAccessor3<FdmMatrixRow3> A;
+        const typename BlasType::MatrixType* A;
         FdmVector3 d;
         FdmVector3 y;
 
-        void build(const FdmMatrix3& matrix);
+        void build(const typename BlasType::MatrixType& matrix);
 
         void solve(const FdmVector3& b, FdmVector3* x);
     };
@@ -69,7 +75,8 @@ class FdmIccgSolver3 final : public FdmLinearSystemSolver3 {
     FdmVector3 _d;
     FdmVector3 _q;
     FdmVector3 _s;
-    Preconditioner _precond;
+    Preconditioner<FdmBlas3> _precond;
+    Preconditioner<FdmMatrixFreeBlas3> _precondMatrixFree;
 
     // Compressed vectors and preconditioner
     VectorND _rComp;
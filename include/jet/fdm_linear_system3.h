@@ -10,8 +10,11 @@
 #include <jet/array1.h>
 #include <jet/array3.h>
 #include <jet/matrix_csr.h>
+#include <jet/vector3.h>
 #include <jet/vector_n.h>
 
+#include <cstdint>
+
 namespace jet {
 
 //! The row of FdmMatrix3 where row corresponds to (i, j, k) grid point.
@@ -35,6 +38,60 @@ typedef Array3<double> FdmVector3;
 //! Matrix type for 3-D finite differencing.
 typedef Array3<FdmMatrixRow3> FdmMatrix3;
 
+//!
+//! \brief Matrix-free 7-point Laplacian matrix for 3-D finite differencing.
+//!
+//! Instead of storing FdmMatrixRow3 per cell, this matrix stores one byte of
+//! flags per cell and computes the rows from the flags and the grid spacing.
+//! An active cell has the sum of invHSqr over its open faces as the diagonal
+//! component. It is coupled by -invHSqr with each active neighbor across a
+//! face that is open from the lower-index side. An inactive cell has an
+//! identity row. The faces on the grid boundary must be closed.
+//!
+struct FdmMatrixFree3 {
+    //! The cell is an unknown of the system.
+    static const uint8_t kActive = 1 << 0;
+
+    //! The face toward (i-1, j, k) is open.
+    static const uint8_t kOpenLeft = 1 << 1;
+
+    //! The face toward (i+1, j, k) is open.
+    static const uint8_t kOpenRight = 1 << 2;
+
+    //! The face toward (i, j-1, k) is open.
+    static const uint8_t kOpenDown = 1 << 3;
+
+    //! The face toward (i, j+1, k) is open.
+    static const uint8_t kOpenUp = 1 << 4;
+
+    //! The face toward (i, j, k-1) is open.
+    static const uint8_t kOpenBack = 1 << 5;
+
+    //! The face toward (i, j, k+1) is open.
+    static const uint8_t kOpenFront = 1 << 6;
+
+    //! Per-cell flags.
+    Array3<uint8_t> flags;
+
+    //! Inverse of the squared grid spacing.
+    Vector3D invHSqr;
+
+    //! Returns the size of the matrix in grid points.
+    Size3 size() const;
+
+    //! Clears all the data.
+    void clear();
+
+    //! Resizes the flags with given grid size.
+    void resize(const Size3& size);
+
+    //! Returns the row that corresponds to (i, j, k) grid point.
+    FdmMatrixRow3 row(size_t i, size_t j, size_t k) const;
+
+    //! Writes the explicit form of this matrix to \p result.
+    void toMatrix(FdmMatrix3* result) const;
+};
+
 //! Linear system (Ax=b) for 3-D finite differencing.
 struct FdmLinearSystem3 {
     //! System matrix.
@@ -53,6 +110,24 @@ struct FdmLinearSystem3 {
     void resize(const Size3& size);
 };
 
+//! Matrix-free linear system (Ax=b) for 3-D finite differencing.
+struct FdmMatrixFreeLinearSystem3 {
+    //! System matrix.
+    FdmMatrixFree3 A;
+
+    //! Solution vector.
+    FdmVector3 x;
+
+    //! RHS vector.
+    FdmVector3 b;
+
+    //! Clears all the data.
+    void clear();
+
+    //! Resizes the arrays with given grid size.
+    void resize(const Size3& size);
+};
+
 //! Compressed linear system (Ax=b) for 3-D finite differencing.
 struct FdmCompressedLinearSystem3 {
     //! System matrix.
@@ -98,10 +173,84 @@ struct FdmBlas3 {
     static void mvm(const MatrixType& m, const VectorType& v,
                     VectorType* result);
 
+    //! Performs matrix-vector multiplication with the matrix-free matrix.
+    static void mvm(const FdmMatrixFree3& m, const VectorType& v,
+                    VectorType* result);
+
+    //! Performs matrix-vector multiplication and returns the dot products
+    //! v.v and v.(mv) in \p vDotV and \p vDotResult.
+    static void mvmDot(const MatrixType& m, const VectorType& v,
+                       VectorType* result, ScalarType* vDotV,
+                       ScalarType* vDotResult);
+
+    //! Performs matrix-vector multiplication with the matrix-free matrix and
+    //! returns the dot products v.v and v.(mv) in \p vDotV and
+    //! \p vDotResult.
+    static void mvmDot(const FdmMatrixFree3& m, const VectorType& v,
+                       VectorType* result, ScalarType* vDotV,
+                       ScalarType* vDotResult);
+
     //! Computes residual vector (b - ax).
     static void residual(const MatrixType& a, const VectorType& x,
                          const VectorType& b, VectorType* result);
 
+    //! Computes residual vector (b - ax) with the matrix-free matrix.
+    static void residual(const FdmMatrixFree3& a, const VectorType& x,
+                         const VectorType& b, VectorType* result);
+
+    //! Performs the fused conjugate gradient update p = r + beta * p,
+    //! s = w + beta * s, x = x + alpha * p and r = r - alpha * s.
+    static void cgUpdate(ScalarType alpha, ScalarType beta,
+                         const VectorType& w, VectorType* r, VectorType* p,
+                         VectorType* s, VectorType* x);
+
+    //! Returns L2-norm of the given vector \p v.
+    static ScalarType l2Norm(const VectorType& v);
+
+    //! Returns Linf-norm of the given vector \p v.
+    static ScalarType lInfNorm(const VectorType& v);
+};
+
+//! BLAS operator wrapper for matrix-free 3-D finite differencing.
+struct FdmMatrixFreeBlas3 {
+    typedef double ScalarType;
+    typedef FdmVector3 VectorType;
+    typedef FdmMatrixFree3 MatrixType;
+
+    //! Sets entire element of given vector \p result with scalar \p s.
+    static void set(ScalarType s, VectorType* result);
+
+    //! Copies entire element of given vector \p result with other vector \p v.
+    static void set(const VectorType& v, VectorType* result);
+
+    //! Performs dot product with vector \p a and \p b.
+    static double dot(const VectorType& a, const VectorType& b);
+
+    //! Performs ax + y operation where \p a is a matrix and \p x and \p y are
+    //! vectors.
+    static void axpy(double a, const VectorType& x, const VectorType& y,
+                     VectorType* result);
+
+    //! Performs matrix-vector multiplication.
+    static void mvm(const MatrixType& m, const VectorType& v,
+                    VectorType* result);
+
+    //! Performs matrix-vector multiplication and returns the dot products
+    //! v.v and v.(mv) in \p vDotV and \p vDotResult.
+    static void mvmDot(const MatrixType& m, const VectorType& v,
+                       VectorType* result, ScalarType* vDotV,
+                       ScalarType* vDotResult);
+
+    //! Computes residual vector (b - ax).
+    static void residual(const MatrixType& a, const VectorType& x,
+                         const VectorType& b, VectorType* result);
+
+    //! Performs the fused conjugate gradient update p = r + beta * p,
+    //! s = w + beta * s, x = x + alpha * p and r = r - alpha * s.
+    static void cgUpdate(ScalarType alpha, ScalarType beta,
+                         const VectorType& w, VectorType* r, VectorType* p,
+                         VectorType* s, VectorType* x);
+
     //! Returns L2-norm of the given vector \p v.
     static ScalarType l2Norm(const VectorType& v);
 
@@ -139,10 +288,22 @@ struct FdmCompressedBlas3 {
     static void mvm(const MatrixType& m, const VectorType& v,
                     VectorType* result);
 
+    //! Performs matrix-vector multiplication and returns the dot products
+    //! v.v and v.(mv) in \p vDotV and \p vDotResult.
+    static void mvmDot(const MatrixType& m, const VectorType& v,
+                       VectorType* result, ScalarType* vDotV,
+                       ScalarType* vDotResult);
+
     //! Computes residual vector (b - ax).
     static void residual(const MatrixType& a, const VectorType& x,
                          const VectorType& b, VectorType* result);
 
+    //! Performs the fused conjugate gradient update p = r + beta * p,
+    //! s = w + beta * s, x = x + alpha * p and r = r - alpha * s.
+    static void cgUpdate(ScalarType alpha, ScalarType beta,
+                         const VectorType& w, VectorType* r, VectorType* p,
+                         VectorType* s, VectorType* x);
+
     //! Returns L2-norm of the given vector \p v.
     static ScalarType l2Norm(const VectorType& v);
 
@@ -25,6 +25,15 @@ class FdmLinearSystemSolver3 {
 
     //! Solves the given compressed linear system.
     virtual bool solveCompressed(FdmCompressedLinearSystem3*) { return false; }
+
+    //!
+    //! \brief Solves the given matrix-free linear system.
+    //!
+    //! The default implementation expands the system into FdmLinearSystem3
+    //! and calls solve(). Solvers that only need the matrix-vector product
+    //! should override this function to avoid the expansion.
+    //!
+    virtual bool solveMatrixFree(FdmMatrixFreeLinearSystem3* system);
 };
 
 //! Shared pointer type for the FdmLinearSystemSolver3.
@@ -90,9 +90,23 @@ class GridSinglePhasePressureSolver3 : public GridPressureSolver3 {
     //! Returns the pressure field.
     const FdmVector3& pressure() const;
 
+    //! Returns true if the solver uses the matrix-free linear system.
+    bool isUsingMatrixFreeSystem() const;
+
+    //!
+    //! \brief Sets true to use the matrix-free linear system.
+    //!
+    //! The matrix-free system stores a byte of flags per cell instead of the
+    //! explicit matrix rows and computes the Laplacian on the fly. It applies
+    //! to the uncompressed, non-multigrid solve only.
+    //!
+    void setIsUsingMatrixFreeSystem(bool isUsing);
+
  private:
     FdmLinearSystem3 _system;
     FdmCompressedLinearSystem3 _compSystem;
+    FdmMatrixFreeLinearSystem3 _mfSystem;
+    bool _isUsingMatrixFreeSystem = false;
     FdmLinearSystemSolver3Ptr _systemSolver;
 
     FdmMgLinearSystem3 _mgSystem;
@@ -202,6 +202,66 @@ class GridSystemData3 : public Serializable {
     //! Returns the advectable vector data at given index.
     const VectorGrid3Ptr& advectableVectorDataAt(size_t idx) const;
 
+    //!
+    //! \brief      Returns the back buffer of the advectable scalar data at
+    //!             given index.
+    //!
+    //! Each advectable data grid has a persistent back buffer of the same type
+    //! and size. Solvers can use it as the input of an advection or a
+    //! diffusion pass instead of cloning the grid every time step.
+    //!
+    const ScalarGrid3Ptr& advectableScalarDataBackBufferAt(size_t idx) const;
+
+    //!
+    //! \brief      Returns the back buffer of the advectable vector data at
+    //!             given index.
+    //!
+    //! \see        GridSystemData3::advectableScalarDataBackBufferAt
+    //!
+    const VectorGrid3Ptr& advectableVectorDataBackBufferAt(size_t idx) const;
+
+    //! Returns the back buffer of the velocity field.
+    const FaceCenteredGrid3Ptr& velocityBackBuffer() const;
+
+    //!
+    //! \brief      Copies the advectable scalar data at given index to its back
+    //!             buffer.
+    //!
+    //! No memory is allocated since the back buffer keeps the same size as the
+    //! data.
+    //!
+    void copyAdvectableScalarDataToBackBuffer(size_t idx);
+
+    //!
+    //! \brief      Copies the advectable vector data at given index to its back
+    //!             buffer.
+    //!
+    //! No memory is allocated since the back buffer keeps the same size as the
+    //! data.
+    //!
+    void copyAdvectableVectorDataToBackBuffer(size_t idx);
+
+    //!
+    //! \brief      Swaps the advectable scalar data at given index with its back
+    //!             buffer.
+    //!
+    //! Only the contents are swapped, so the pointers returned by
+    //! GridSystemData3::advectableScalarDataAt and
+    //! GridSystemData3::advectableScalarDataBackBufferAt remain valid.
+    //!
+    void swapAdvectableScalarData(size_t idx);
+
+    //!
+    //! \brief      Swaps the advectable vector data at given index with its back
+    //!             buffer.
+    //!
+    //! Only the contents are swapped, so the pointers returned by
+    //! GridSystemData3::advectableVectorDataAt,
+    //! GridSystemData3::advectableVectorDataBackBufferAt, and
+    //! GridSystemData3::velocity remain valid.
+    //!
+    void swapAdvectableVectorData(size_t idx);
+
     //! Returns the number of non-advectable scalar data.
     size_t numberOfScalarData() const;
 
@@ -231,6 +291,12 @@ class GridSystemData3 : public Serializable {
     std::vector<VectorGrid3Ptr> _vectorDataList;
     std::vector<ScalarGrid3Ptr> _advectableScalarDataList;
     std::vector<VectorGrid3Ptr> _advectableVectorDataList;
+
+    FaceCenteredGrid3Ptr _velocityBackBuffer;
+    std::vector<ScalarGrid3Ptr> _advectableScalarDataBackBufferList;
+    std::vector<VectorGrid3Ptr> _advectableVectorDataBackBufferList;
+
+    void resetBackBuffers();
 };
 
 //! Shared pointer type of GridSystemData3.
@@ -25,6 +25,7 @@
 #include <jet/array_samplers1.h>
 #include <jet/array_samplers2.h>
 #include <jet/array_samplers3.h>
+#include <jet/array_scatter.h>
 #include <jet/array_utils.h>
 #include <jet/bcc_lattice_point_generator.h>
 #include <jet/blas.h>
@@ -61,6 +62,7 @@
 #include <jet/custom_vector_field2.h>
 #include <jet/custom_vector_field3.h>
 #include <jet/cylinder3.h>
+#include <jet/df_sph_solver3.h>
 #include <jet/eno_level_set_solver2.h>
 #include <jet/eno_level_set_solver3.h>
 #include <jet/face_centered_grid2.h>
@@ -156,6 +158,7 @@
 #include <jet/mg.h>
 #include <jet/nearest_neighbor_query_engine2.h>
 #include <jet/nearest_neighbor_query_engine3.h>
+#include <jet/neighbor_lists.h>
 #include <jet/octree.h>
 #include <jet/parallel.h>
 #include <jet/particle_emitter2.h>
@@ -191,6 +194,7 @@
 #include <jet/point_particle_emitter3.h>
 #include <jet/point_simple_list_searcher2.h>
 #include <jet/point_simple_list_searcher3.h>
+#include <jet/point_sparse_hash_grid_searcher3.h>
 #include <jet/points_to_implicit2.h>
 #include <jet/points_to_implicit3.h>
 #include <jet/quadtree.h>
@@ -0,0 +1,91 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_NEIGHBOR_LISTS_H_
+#define INCLUDE_JET_NEIGHBOR_LISTS_H_
+
+#include <jet/array_accessor1.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace jet {
+
+//!
+//! \brief Compressed-row neighbor lists.
+//!
+//! This class stores the neighbor lists of all particles in two flat arrays;
+//! one offset array with N + 1 entries and one 32-bit index array holding the
+//! concatenated lists. The i-th list is the index range
+//! [offsets()[i], offsets()[i + 1]).
+//!
+class NeighborLists {
+ public:
+    //! Index type of the neighbors.
+    typedef uint32_t IndexType;
+
+    //! Immutable view of a single neighbor list.
+    typedef ConstArrayAccessor1<IndexType> ConstList;
+
+    //! Constructs empty lists.
+    NeighborLists();
+
+    //! Constructs lists from nested lists.
+    explicit NeighborLists(const std::vector<std::vector<size_t>>& lists);
+
+    //! Returns the number of lists.
+    size_t size() const;
+
+    //! Returns true if there is no list.
+    bool empty() const;
+
+    //! Returns the i-th neighbor list.
+    ConstList operator[](size_t i) const;
+
+    //! Returns the total number of neighbor indices of all lists.
+    size_t numberOfEntries() const;
+
+    //! Returns the offset array.
+    const std::vector<size_t>& offsets() const;
+
+    //! Returns the concatenated neighbor index array.
+    const std::vector<IndexType>& indices() const;
+
+    //! Clears all lists.
+    void clear();
+
+    //! Sets the lists from nested lists.
+    void set(const std::vector<std::vector<size_t>>& lists);
+
+    //! Returns the lists in nested form.
+    std::vector<std::vector<size_t>> toNestedLists() const;
+
+    //!
+    //! \brief Builds the lists in parallel with two passes.
+    //!
+    //! The first pass calls \p countFunc(i) to get the length of the i-th
+    //! list. After the offsets are computed, the second pass calls
+    //! \p fillFunc(i, dst) which should write exactly countFunc(i) indices
+    //! starting from \p dst.
+    //!
+    //! \param[in]  numberOfLists   The number of lists.
+    //! \param[in]  countFunc       The function returning a list length.
+    //! \param[in]  fillFunc        The function filling a list.
+    //!
+    template <typename CountFunc, typename FillFunc>
+    void build(size_t numberOfLists, const CountFunc& countFunc,
+               const FillFunc& fillFunc);
+
+ private:
+    std::vector<size_t> _offsets;
+    std::vector<IndexType> _indices;
+};
+
+}  // namespace jet
+
+#include "detail/neighbor_lists-inl.h"
+
+#endif  // INCLUDE_JET_NEIGHBOR_LISTS_H_
@@ -12,6 +12,9 @@ namespace jet {
 //! Execution policy tag.
 enum class ExecutionPolicy { kSerial, kParallel };
 
+//! Reduction mode tag.
+enum class ReductionMode { kDefault, kDeterministic };
+
 //!
 //! \brief      Fills from \p begin to \p end with \p value in parallel.
 //!
@@ -182,7 +185,10 @@ void parallelRangeFor(IndexType beginIndexX, IndexType endIndexX,
 //! \brief      Performs reduce operation in parallel.
 //!
 //! This function reduces the series of values into a single value using the
-//! provided reduce function.
+//! provided reduce function. With ReductionMode::kDeterministic, the range is
+//! split into fixed subranges and the partial results are combined with a
+//! fixed-shape pairwise tree, so the result only depends on the input range and
+//! not on the number of threads or the tasking backend.
 //!
 //! \param[in]  beginIndex The begin index.
 //! \param[in]  endIndex   The end index.
@@ -190,6 +196,7 @@ void parallelRangeFor(IndexType beginIndexX, IndexType endIndexX,
 //! \param[in]  function   The function for reducing subrange.
 //! \param[in]  reduce     The reduce operator.
 //! \param[in]  policy     The execution policy (parallel or serial).
+//! \param[in]  mode       The reduction mode (default or deterministic).
 //!
 //! \tparam     IndexType  Index type.
 //! \tparam     Value      Value type.
@@ -200,7 +207,8 @@ template <typename IndexType, typename Value, typename Function,
 Value parallelReduce(IndexType beginIndex, IndexType endIndex,
                      const Value& identity, const Function& func,
                      const Reduce& reduce,
-                     ExecutionPolicy policy = ExecutionPolicy::kParallel);
+                     ExecutionPolicy policy = ExecutionPolicy::kParallel,
+                     ReductionMode mode = ReductionMode::kDefault);
 
 //!
 //! \brief      Sorts a container in parallel.
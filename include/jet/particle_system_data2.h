@@ -8,6 +8,7 @@
 #define INCLUDE_JET_PARTICLE_SYSTEM_DATA2_H_
 
 #include <jet/array1.h>
+#include <jet/neighbor_lists.h>
 #include <jet/point_neighbor_searcher2.h>
 #include <jet/serialization.h>
 
@@ -197,12 +198,13 @@ class ParticleSystemData2 : public Serializable {
     //! \brief      Returns neighbor lists.
     //!
     //! This function returns neighbor lists which is available after calling
-    //! PointParallelHashGridSearcher2::buildNeighborLists. Each list stores
-    //! indices of the neighbors.
+    //! PointParallelHashGridSearcher2::buildNeighborLists. The lists are
+    //! stored in compressed-row form and each list stores 32-bit indices of
+    //! the neighbors.
     //!
     //! \return     Neighbor lists.
     //!
-    const std::vector<std::vector<size_t>>& neighborLists() const;
+    const NeighborLists& neighborLists() const;
 
     //! Builds neighbor searcher with given search radius.
     void buildNeighborSearcher(double maxSearchRadius);
@@ -243,7 +245,7 @@ class ParticleSystemData2 : public Serializable {
     std::vector<VectorData> _vectorDataList;
 
     PointNeighborSearcher2Ptr _neighborSearcher;
-    std::vector<std::vector<size_t>> _neighborLists;
+    NeighborLists _neighborLists;
 };
 
 //! Shared pointer type of ParticleSystemData2.
@@ -8,10 +8,14 @@
 #define INCLUDE_JET_PARTICLE_SYSTEM_DATA3_H_
 
 #include <jet/array1.h>
+#include <jet/neighbor_lists.h>
 #include <jet/serialization.h>
 #include <jet/point_neighbor_searcher3.h>
+#include <jet/point_sparse_hash_grid_searcher3.h>
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #ifndef JET_DOXYGEN
@@ -50,6 +54,9 @@ class ParticleSystemData3 : public Serializable {
     //! Vector data chunk.
     typedef Array1<Vector3D> VectorData;
 
+    //! Maximum number of neighbors per batch of forEachNeighborBatch.
+    static const size_t kNeighborBatchSize = 64;
+
     //! Default constructor.
     ParticleSystemData3();
 
@@ -78,6 +85,22 @@ class ParticleSystemData3 : public Serializable {
     //! Returns the number of particles.
     size_t numberOfParticles() const;
 
+    //!
+    //! \brief      Reserves the storage for the given number of particles.
+    //!
+    //! This function reserves the storage of all the data layers, including
+    //! the custom ones, without changing the number of particles. Adding
+    //! particles within the capacity does not reallocate the storage. When
+    //! the capacity is exceeded, ParticleSystemData3::resize grows it
+    //! geometrically so that continuous emission is amortized.
+    //!
+    //! \param[in]  newCapacity The new capacity.
+    //!
+    void reserve(size_t newCapacity);
+
+    //! Returns the number of particles that can be held without reallocation.
+    size_t capacity() const;
+
     //!
     //! \brief      Adds a scalar data layer and returns its index.
     //!
@@ -183,7 +206,9 @@ class ParticleSystemData3 : public Serializable {
     //! \brief      Returns neighbor searcher.
     //!
     //! This function returns currently set neighbor searcher object. By
-    //! default, PointParallelHashGridSearcher3 is used.
+    //! default, PointParallelHashGridSearcher3 is used. If the searcher has
+    //! been invalidated by reordering the particles, it is rebuilt with the
+    //! current positions before returning.
     //!
     //! \return     Current neighbor searcher.
     //!
@@ -193,21 +218,163 @@ class ParticleSystemData3 : public Serializable {
     void setNeighborSearcher(
         const PointNeighborSearcher3Ptr& newNeighborSearcher);
 
+    //!
+    //! \brief      Returns true if the sparse hash grid searcher is used.
+    //!
+    //! If true, ParticleSystemData3::buildNeighborSearcher builds
+    //! PointSparseHashGridSearcher3 instead of the default
+    //! PointParallelHashGridSearcher3. The sparse hash grid does not wrap the
+    //! grid cells around a fixed resolution, so it is preferred for large or
+    //! thin domains. Default is false.
+    //!
+    bool useSparseNeighborSearcher() const;
+
+    //! Sets true to use the sparse hash grid searcher.
+    void setUseSparseNeighborSearcher(bool onoff);
+
     //!
     //! \brief      Returns neighbor lists.
     //!
     //! This function returns neighbor lists which is available after calling
-    //! PointParallelHashGridSearcher3::buildNeighborLists. Each list stores
-    //! indices of the neighbors.
+    //! PointParallelHashGridSearcher3::buildNeighborLists. The lists are
+    //! stored in compressed-row form and each list stores 32-bit indices of
+    //! the neighbors.
     //!
     //! \return     Neighbor lists.
     //!
-    const std::vector<std::vector<size_t>>& neighborLists() const;
+    const NeighborLists& neighborLists() const;
 
-    //! Builds neighbor searcher with given search radius.
+    //!
+    //! \brief      Returns true if the neighbor lists are stored.
+    //!
+    //! If false, ParticleSystemData3::buildNeighborLists does not store the
+    //! per-particle neighbor lists which take O(N k) memory. Instead,
+    //! ParticleSystemData3::forEachNeighbor visits the 27 cells around each
+    //! particle directly from the sorted points of
+    //! PointSparseHashGridSearcher3 whose grid spacing is set to the search
+    //! radius. Since the cells are never wrapped, the three cells of each row
+    //! are scanned as one contiguous range. The skin radius and the sparse
+    //! hash grid searcher flag are not used in this mode. This trades speed
+    //! for memory: gathering the neighbors on the fly tests every point in the
+    //! 27 cells, so a neighbor loop is slower than reading the stored lists.
+    //! SphSolver3 compensates by visiting the neighbors once for both the
+    //! viscosity and the pressure forces. Default is true.
+    //!
+    bool useNeighborLists() const;
+
+    //! Sets true to store the neighbor lists.
+    void setUseNeighborLists(bool onoff);
+
+    //!
+    //! \brief      Invokes the callback function for each neighbor of the
+    //!             particle.
+    //!
+    //! The callback takes the index of the neighbor. The particle itself is
+    //! excluded. The neighbors are either read from the neighbor lists or
+    //! gathered from the hash grid buckets depending on
+    //! ParticleSystemData3::useNeighborLists. In both cases,
+    //! ParticleSystemData3::buildNeighborLists should be called beforehand.
+    //!
+    //! \param[in]  i        The particle index.
+    //! \param[in]  callback The callback function.
+    //!
+    template <typename Callback>
+    void forEachNeighbor(size_t i, const Callback& callback) const;
+
+    //!
+    //! \brief      Invokes the callback function for each batch of neighbors
+    //!             of the particle.
+    //!
+    //! Same as ParticleSystemData3::forEachNeighbor, but the callback takes a
+    //! contiguous array of up to kNeighborBatchSize neighbor indices and its
+    //! size. With the neighbor lists, the batches point directly into the
+    //! lists. This lets the callers evaluate the SPH kernels in batch.
+    //!
+    //! \param[in]  i        The particle index.
+    //! \param[in]  callback The callback function.
+    //!
+    template <typename Callback>
+    void forEachNeighborBatch(size_t i, const Callback& callback) const;
+
+    //!
+    //! \brief      Returns the skin radius of the neighbor lists.
+    //!
+    //! With a positive skin radius, the neighbor searcher and the neighbor
+    //! lists are built with the search radius plus the skin radius, so the
+    //! lists stay valid while no particle moves more than half of the skin
+    //! radius. Zero (default) disables the skin.
+    //!
+    double skinRadius() const;
+
+    //! Sets the skin radius of the neighbor lists.
+    void setSkinRadius(double newSkinRadius);
+
+    //!
+    //! \brief      Returns true if the neighbor lists should be rebuilt.
+    //!
+    //! Without skin or without neighbor lists, this function always returns
+    //! true. With skin, it returns true if the lists have not been built with
+    //! the given search radius and the current particles, or if any particle
+    //! has moved more than half of the skin radius since the last build.
+    //!
+    //! \param[in]  maxSearchRadius    The search radius without skin.
+    //!
+    bool needsNeighborListsRebuild(double maxSearchRadius) const;
+
+    //! Returns the maximum particle displacement since the last list build.
+    double maxDisplacementSinceNeighborListsBuild() const;
+
+    //!
+    //! \brief      Marks the neighbor lists as outdated.
+    //!
+    //! This should be called if particles are rearranged without changing the
+    //! number of particles so that needsNeighborListsRebuild returns true.
+    //!
+    void invalidateNeighborLists();
+
+    //!
+    //! \brief      Reorders the particles along the Z-order (Morton) curve.
+    //!
+    //! This function sorts all the particles, including the custom data
+    //! layers, by the Morton code of their positions so that particles close
+    //! in space are also close in memory. Particles with the same code keep
+    //! their relative order, so the result is deterministic. Since the
+    //! particle indices are changed, this will invalidate neighbor searcher
+    //! and neighbor lists. The searcher is rebuilt on demand the next time it
+    //! is used.
+    //!
+    //! \param[out] permutation Optional output of the permutation where the
+    //!                         i-th particle after sorting was the
+    //!                         permutation[i]-th particle before sorting.
+    //!                         Use it to reorder any external per-particle
+    //!                         data.
+    //!
+    void sortParticles(Array1<size_t>* permutation = nullptr);
+
+    //!
+    //! \brief      Removes the particles with nonzero mask values.
+    //!
+    //! This function compacts all the particles, including the custom data
+    //! layers, by removing the particles whose mask is nonzero. The remaining
+    //! particles keep their relative order. Since the particle indices are
+    //! changed, this will invalidate neighbor searcher and neighbor lists.
+    //! The searcher is rebuilt on demand the next time it is used.
+    //!
+    //! \param[in]  mask        The removal mask for each particle.
+    //! \param[out] remaining   Optional output of the indices where the i-th
+    //!                         particle after the removal was the
+    //!                         remaining[i]-th particle before the removal.
+    //!                         Use it to compact any external per-particle
+    //!                         data.
+    //!
+    void removeParticles(
+        const ConstArrayAccessor1<char>& mask,
+        Array1<size_t>* remaining = nullptr);
+
+    //! Builds neighbor searcher with given search radius (plus skin radius).
     void buildNeighborSearcher(double maxSearchRadius);
 
-    //! Builds neighbor lists with given search radius.
+    //! Builds neighbor lists with given search radius (plus skin radius).
     void buildNeighborLists(double maxSearchRadius);
 
     //! Serializes this particle system data to the buffer.
@@ -242,8 +409,24 @@ class ParticleSystemData3 : public Serializable {
     std::vector<ScalarData> _scalarDataList;
     std::vector<VectorData> _vectorDataList;
 
+    // Scratch layers whose storage is swapped with the reordered layers
+    ScalarData _scalarDataBuffer;
+    VectorData _vectorDataBuffer;
+
     PointNeighborSearcher3Ptr _neighborSearcher;
-    std::vector<std::vector<size_t>> _neighborLists;
+    mutable std::atomic<bool> _isNeighborSearcherValid{true};
+    mutable std::mutex _neighborSearcherMutex;
+    NeighborLists _neighborLists;
+
+    bool _useSparseNeighborSearcher = false;
+
+    bool _useNeighborLists = true;
+    PointSparseHashGridSearcher3Ptr _cellSearcher;
+
+    double _skinRadius = 0.0;
+    double _neighborListsSearchRadius = 0.0;
+    bool _isNeighborListsValid = false;
+    VectorData _neighborListsPositions;
 };
 
 //! Shared pointer type of ParticleSystemData3.
@@ -251,4 +434,6 @@ typedef std::shared_ptr<ParticleSystemData3> ParticleSystemData3Ptr;
 
 }  // namespace jet
 
+#include "detail/particle_system_data3-inl.h"
+
 #endif  // INCLUDE_JET_PARTICLE_SYSTEM_DATA3_H_
@@ -7,6 +7,7 @@
 #ifndef INCLUDE_JET_PARTICLE_SYSTEM_SOLVER3_H_
 #define INCLUDE_JET_PARTICLE_SYSTEM_SOLVER3_H_
 
+#include <jet/bounding_box3.h>
 #include <jet/collider3.h>
 #include <jet/constants.h>
 #include <jet/vector_field3.h>
@@ -111,6 +112,49 @@ class ParticleSystemSolver3 : public PhysicsAnimation {
     //!
     void setWind(const VectorField3Ptr& newWind);
 
+    //! Returns the number of sub-steps between particle sorting.
+    unsigned int particleSortingInterval() const;
+
+    //!
+    //! \brief      Sets the number of sub-steps between particle sorting.
+    //!
+    //! When the interval is positive, the particles are reordered along the
+    //! Z-order curve every given number of sub-steps to improve the memory
+    //! locality of the neighbor search and the particle loops. Zero (default)
+    //! disables the sorting.
+    //!
+    //! \param[in]  newInterval The new interval.
+    //!
+    void setParticleSortingInterval(unsigned int newInterval);
+
+    //! Returns true if the particles outside the domain are removed.
+    bool removesParticlesOutsideDomain() const;
+
+    //!
+    //! \brief      Sets true to remove the particles outside the domain.
+    //!
+    //! When enabled, the particles that are outside of the particle domain
+    //! are removed at the beginning of each sub-step so that the particles
+    //! leaving the scene do not slow down the simulation. Default is false.
+    //!
+    //! \param[in]  onoff True to remove the particles outside the domain.
+    //!
+    void setRemovesParticlesOutsideDomain(bool onoff);
+
+    //! Returns the particle domain.
+    const BoundingBox3D& particleDomain() const;
+
+    //!
+    //! \brief      Sets the particle domain.
+    //!
+    //! The particles outside of this box are removed if
+    //! ParticleSystemSolver3::removesParticlesOutsideDomain is true. Default
+    //! is an unbounded box, which keeps all the particles.
+    //!
+    //! \param[in]  newDomain The new domain.
+    //!
+    void setParticleDomain(const BoundingBox3D& newDomain);
+
     //! Returns builder fox ParticleSystemSolver3.
     static Builder builder();
 
@@ -130,6 +174,24 @@ class ParticleSystemSolver3 : public PhysicsAnimation {
     //! Called after a time-step is completed.
     virtual void onEndAdvanceTimeStep(double timeStepInSeconds);
 
+    //!
+    //! \brief      Reorders the particles along the Z-order curve.
+    //!
+    //! Subclasses that hold persistent per-particle data outside of the
+    //! particle system data should override this function and apply the
+    //! permutation to the data as well.
+    //!
+    virtual void sortParticles();
+
+    //!
+    //! \brief      Removes the particles with nonzero mask values.
+    //!
+    //! Subclasses that hold persistent per-particle data outside of the
+    //! particle system data should override this function and compact the
+    //! data as well.
+    //!
+    virtual void removeParticles(const ConstArrayAccessor1<char>& mask);
+
     //! Resolves any collisions occured by the particles.
     void resolveCollision();
 
@@ -153,6 +215,11 @@ class ParticleSystemSolver3 : public PhysicsAnimation {
     Collider3Ptr _collider;
     ParticleEmitter3Ptr _emitter;
     VectorField3Ptr _wind;
+    unsigned int _particleSortingInterval = 0;
+    unsigned int _numberOfStepsSinceSort = 0;
+    bool _removesParticlesOutsideDomain = false;
+    BoundingBox3D _particleDomain{Vector3D(-kMaxD, -kMaxD, -kMaxD),
+                                  Vector3D(kMaxD, kMaxD, kMaxD)};
 
     void beginAdvanceTimeStep(double timeStepInSeconds);
 
@@ -165,6 +232,8 @@ class ParticleSystemSolver3 : public PhysicsAnimation {
     void updateCollider(double timeStepInSeconds);
 
     void updateEmitter(double timeStepInSeconds);
+
+    void removeParticlesOutsideDomain();
 };
 
 //! Shared pointer type for the ParticleSystemSolver3.
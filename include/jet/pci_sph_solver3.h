@@ -57,6 +57,13 @@ class PciSphSolver3 : public SphSolver3 {
     //!
     void setMaxNumberOfIterations(unsigned int n);
 
+    //! Returns the number of PCISPH iterations in the last time-step.
+    unsigned int lastNumberOfIterations() const;
+
+    //! Returns the average wall time of a PCISPH iteration in the last
+    //! time-step.
+    double lastIterationTimeInSeconds() const;
+
     //! Returns builder fox PciSphSolver3.
     static Builder builder();
 
@@ -74,8 +81,9 @@ class PciSphSolver3 : public SphSolver3 {
 
     ParticleSystemData3::VectorData _tempPositions;
     ParticleSystemData3::VectorData _tempVelocities;
-    ParticleSystemData3::VectorData _pressureForces;
-    ParticleSystemData3::ScalarData _densityErrors;
+
+    unsigned int _lastNumberOfIterations = 0;
+    double _lastIterationTimeInSeconds = 0.0;
 
     double computeDelta(double timeStepInSeconds);
     double computeBeta(double timeStepInSeconds);
@@ -7,6 +7,8 @@
 #ifndef INCLUDE_JET_PIC_SOLVER3_H_
 #define INCLUDE_JET_PIC_SOLVER3_H_
 
+#include <jet/cell_centered_scalar_grid3.h>
+#include <jet/face_centered_grid3.h>
 #include <jet/grid_fluid_solver3.h>
 #include <jet/particle_emitter3.h>
 #include <jet/particle_system_data3.h>
@@ -51,6 +53,74 @@ class PicSolver3 : public GridFluidSolver3 {
     //! Sets the particle emitter.
     void setParticleEmitter(const ParticleEmitter3Ptr& newEmitter);
 
+    //! Returns the number of sub-steps between particle sorting.
+    unsigned int particleSortingInterval() const;
+
+    //!
+    //! \brief      Sets the number of sub-steps between particle sorting.
+    //!
+    //! When the interval is positive, the particles are reordered along the
+    //! Z-order curve every given number of sub-steps before the
+    //! particle-to-grid transfer to improve the memory locality of the grid
+    //! access. Zero (default) disables the sorting.
+    //!
+    //! \param[in]  newInterval The new interval.
+    //!
+    void setParticleSortingInterval(unsigned int newInterval);
+
+    //! Returns true if the particles outside the grid domain are removed.
+    bool removesParticlesOutsideDomain() const;
+
+    //!
+    //! \brief      Sets true to remove the particles outside the grid domain.
+    //!
+    //! When enabled, the particles that have left the bounding box of the
+    //! grid, for instance through an open domain boundary, are removed at the
+    //! beginning of each sub-step. Default is false.
+    //!
+    //! \param[in]  onoff True to remove the particles outside the domain.
+    //!
+    void setRemovesParticlesOutsideDomain(bool onoff);
+
+    //! Returns true if the particles are kept only near the liquid surface.
+    bool isUsingNarrowBand() const;
+
+    //!
+    //! \brief      Sets true to keep the particles only near the liquid
+    //!             surface.
+    //!
+    //! In the narrow-band mode, the particles deeper than the band width from
+    //! the surface are removed, and the liquid interior is represented by a
+    //! grid level set and a grid velocity which are advected with the
+    //! semi-Lagrangian method. The faces which receive no particle velocity
+    //! take the advected grid velocity, and the cells deeper than the band
+    //! take the interior level set. When the band moves down, for instance
+    //! while the liquid drains, the band cells without any particles are
+    //! resampled with new particles. This keeps the number of particles
+    //! proportional to the surface area rather than the volume of the liquid.
+    //! Default is false.
+    //!
+    //! \see Ferstl, Florian, et al. "Narrow band FLIP for liquid
+    //!      simulations." Computer Graphics Forum. Vol. 35. No. 2. 2016.
+    //!
+    //! \param[in]  onoff True to enable the narrow-band mode.
+    //!
+    void setIsUsingNarrowBand(bool onoff);
+
+    //! Returns the narrow-band width in number of grid cells.
+    double narrowBandWidth() const;
+
+    //!
+    //! \brief      Sets the narrow-band width in number of grid cells.
+    //!
+    //! The particles are kept within the given number of the largest grid
+    //! spacing below the liquid surface. Default is 3. The input value is
+    //! clamped to be at least 1.
+    //!
+    //! \param[in]  newWidth The new band width.
+    //!
+    void setNarrowBandWidth(double newWidth);
+
     //! Returns builder fox PicSolver3.
     static Builder builder();
 
@@ -80,16 +150,65 @@ class PicSolver3 : public GridFluidSolver3 {
     //! Moves particles.
     virtual void moveParticles(double timeIntervalInSeconds);
 
+    //!
+    //! \brief      Reorders the particles along the Z-order curve.
+    //!
+    //! Subclasses that hold persistent per-particle data outside of the
+    //! particle system data should override this function and apply the
+    //! permutation to the data as well.
+    //!
+    virtual void sortParticles();
+
+    //!
+    //! \brief      Removes the particles with nonzero mask values.
+    //!
+    //! Subclasses that hold persistent per-particle data outside of the
+    //! particle system data should override this function and compact the
+    //! data as well.
+    //!
+    virtual void removeParticles(const ConstArrayAccessor1<char>& mask);
+
+    //!
+    //! \brief      Fills the liquid interior faces from the grid velocity.
+    //!
+    //! In the narrow-band mode, this function sets the velocity of the faces
+    //! which received no particle velocity but lie inside the liquid interior
+    //! from the advected grid velocity, and marks them as valid. Subclasses
+    //! that override transferFromParticlesToGrids should call this function
+    //! after the transfer.
+    //!
+    void transferFromLiquidInteriorToGrids();
+
  private:
     size_t _signedDistanceFieldId;
     ParticleSystemData3Ptr _particles;
     ParticleEmitter3Ptr _particleEmitter;
+    unsigned int _particleSortingInterval = 0;
+    unsigned int _numberOfStepsSinceSort = 0;
+    bool _removesParticlesOutsideDomain = false;
+    bool _isUsingNarrowBand = false;
+    double _narrowBandWidth = 3.0;
+    unsigned int _numberOfNarrowBandSteps = 0;
+    CellCenteredScalarGrid3 _liquidSdf;
+    FaceCenteredGrid3 _liquidVelocity;
 
     void extrapolateVelocityToAir();
 
     void buildSignedDistanceField();
 
     void updateParticleEmitter(double timeIntervalInSeconds);
+
+    void removeParticlesOutsideDomain();
+
+    bool hasLiquidInterior() const;
+
+    double narrowBandWidthInMeters() const;
+
+    void reinitializeLiquidSdf();
+
+    void advectLiquidInterior(double timeIntervalInSeconds);
+
+    void updateNarrowBandParticles();
 };
 
 //! Shared pointer type for the PicSolver3.
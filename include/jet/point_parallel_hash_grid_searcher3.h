@@ -31,8 +31,9 @@ class PointParallelHashGridSearcher3 final : public PointNeighborSearcher3 {
     //! \brief      Constructs hash grid with given resolution and grid spacing.
     //!
     //! This constructor takes hash grid resolution and its grid spacing as
-    //! its input parameters. The grid spacing must be 2x or greater than
-    //! search radius.
+    //! its input parameters. The query is fastest when the grid spacing is
+    //! 2x or greater than search radius. Smaller grid spacing is also
+    //! supported by visiting all the buckets overlapping the search sphere.
     //!
     //! \param[in]  resolution  The resolution.
     //! \param[in]  gridSpacing The grid spacing.
@@ -44,8 +45,9 @@ class PointParallelHashGridSearcher3 final : public PointNeighborSearcher3 {
     //! \brief      Constructs hash grid with given resolution and grid spacing.
     //!
     //! This constructor takes hash grid resolution and its grid spacing as
-    //! its input parameters. The grid spacing must be 2x or greater than
-    //! search radius.
+    //! its input parameters. The query is fastest when the grid spacing is
+    //! 2x or greater than search radius. Smaller grid spacing is also
+    //! supported by visiting all the buckets overlapping the search sphere.
     //!
     //! \param[in]  resolutionX The resolution x.
     //! \param[in]  resolutionY The resolution y.
@@ -95,6 +97,24 @@ class PointParallelHashGridSearcher3 final : public PointNeighborSearcher3 {
     bool hasNearbyPoint(
         const Vector3D& origin, double radius) const override;
 
+    //! Returns the grid spacing.
+    double gridSpacing() const;
+
+    //! Returns the resolution of the hash grid.
+    Size3 resolution() const;
+
+    //!
+    //! \brief      Returns the sorted points.
+    //!
+    //! The list this function returns maps sorted index i to the position of
+    //! the sortedIndices()[i]-th original point. The points in the same
+    //! bucket are stored contiguously from startIndexTable()[key] to
+    //! endIndexTable()[key].
+    //!
+    //! \return     The sorted points.
+    //!
+    const std::vector<Vector3D>& points() const;
+
     //!
     //! \brief      Returns the hash key list.
     //!
@@ -221,6 +241,12 @@ class PointParallelHashGridSearcher3 final : public PointNeighborSearcher3 {
     size_t getHashKeyFromPosition(const Vector3D& position) const;
 
     void getNearbyKeys(const Vector3D& position, size_t* bucketIndices) const;
+
+    void getNearbyBucketRange(
+        const Vector3D& position,
+        double radius,
+        Point3I* lower,
+        Point3I* upper) const;
 };
 
 //! Shared pointer for the PointParallelHashGridSearcher3 type.
@@ -0,0 +1,230 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_POINT_SPARSE_HASH_GRID_SEARCHER3_H_
+#define INCLUDE_JET_POINT_SPARSE_HASH_GRID_SEARCHER3_H_
+
+#include <jet/point_neighbor_searcher3.h>
+#include <jet/point3.h>
+#include <jet/size3.h>
+#include <vector>
+
+namespace jet {
+
+//!
+//! \brief Sparse hash grid-based 3-D point searcher.
+//!
+//! This class implements 3-D point searcher by using an unbounded hash grid
+//! for its internal acceleration data structure. Unlike
+//! PointParallelHashGridSearcher3, the grid cells are not wrapped around a
+//! fixed resolution. Only the cells that contain points are stored in an
+//! open-addressing (linear probing) hash table whose size is determined from
+//! the number of occupied cells, which is bounded by the number of points. So
+//! the points in different cells never share a bucket regardless of the
+//! extent or the shape of the domain. If the occupied cells fill most of their
+//! bounding box, such as a block of fluid, a dense table over the box is used
+//! instead so that the cells are looked up without hashing.
+//!
+class PointSparseHashGridSearcher3 final : public PointNeighborSearcher3 {
+ public:
+    JET_NEIGHBOR_SEARCHER3_TYPE_NAME(PointSparseHashGridSearcher3)
+
+    class Builder;
+
+    //!
+    //! \brief      Constructs hash grid with given grid spacing.
+    //!
+    //! The queries are fastest if the grid spacing is 2x or greater than the
+    //! search radius, in which case only 8 cells are visited. Smaller spacing
+    //! is also supported by visiting every cell overlapping the search box.
+    //!
+    //! \param[in]  gridSpacing The grid spacing.
+    //!
+    explicit PointSparseHashGridSearcher3(double gridSpacing = 1.0);
+
+    //! Copy constructor
+    PointSparseHashGridSearcher3(const PointSparseHashGridSearcher3& other);
+
+    //!
+    //! \brief Builds internal acceleration structure for given points list.
+    //!
+    //! This function sorts the points by their grid cells in parallel and
+    //! builds the hash table of the occupied cells.
+    //!
+    //! \param[in]  points The points to be added.
+    //!
+    void build(const ConstArrayAccessor1<Vector3D>& points) override;
+
+    //!
+    //! Invokes the callback function for each nearby point around the origin
+    //! within given radius.
+    //!
+    //! \param[in]  origin   The origin position.
+    //! \param[in]  radius   The search radius.
+    //! \param[in]  callback The callback function.
+    //!
+    void forEachNearbyPoint(
+        const Vector3D& origin,
+        double radius,
+        const ForEachNearbyPointFunc& callback) const override;
+
+    //!
+    //! Returns true if there are any nearby points for given origin within
+    //! radius.
+    //!
+    //! \param[in]  origin The origin.
+    //! \param[in]  radius The radius.
+    //!
+    //! \return     True if has nearby point, false otherwise.
+    //!
+    bool hasNearbyPoint(
+        const Vector3D& origin, double radius) const override;
+
+    //! Returns the grid spacing.
+    double gridSpacing() const;
+
+    //! Returns the number of non-empty grid cells.
+    size_t numberOfOccupiedCells() const;
+
+    //! Returns the size of the cell table, either dense or hashed.
+    size_t numberOfBuckets() const;
+
+    //! Returns true if the cells are stored in a dense table.
+    bool usesDenseTable() const;
+
+    //!
+    //! \brief      Returns the sorted indices of the points.
+    //!
+    //! When the hash grid is built, it sorts the points by their grid cells.
+    //! But rather than sorting the original points, this class keeps the
+    //! shuffled indices of the points. The list this function returns maps
+    //! sorted index i to original index j.
+    //!
+    //! \return     The sorted indices of the points.
+    //!
+    const std::vector<size_t>& sortedIndices() const;
+
+    //!
+    //! \brief      Returns the sorted points.
+    //!
+    //! The list this function returns maps sorted index i to the position of
+    //! the sortedIndices()[i]-th original point. The points are sorted by
+    //! their grid cells in (z, y, x) order, so the points of adjacent cells
+    //! along the x-axis are stored next to each other.
+    //!
+    //! \return     The sorted points.
+    //!
+    const std::vector<Vector3D>& points() const;
+
+    //!
+    //! \brief      Gets the range of the sorted points in a grid cell.
+    //!
+    //! The points in the cell are points()[start] to points()[end - 1]. Both
+    //! start and end are zero if the cell is empty.
+    //!
+    //! \param[in]  cell  The grid cell index.
+    //! \param[out] start The first sorted index in the cell.
+    //! \param[out] end   One past the last sorted index in the cell.
+    //!
+    void getBucketRange(
+        const Point3I& cell, size_t* start, size_t* end) const;
+
+    //!
+    //! Gets the grid cell index from a point.
+    //!
+    //! \param[in]  position The position of the point.
+    //!
+    //! \return     The grid cell index.
+    //!
+    Point3I getBucketIndex(const Vector3D& position) const;
+
+    //!
+    //! \brief      Creates a new instance of the object with same properties
+    //!             than original.
+    //!
+    //! \return     Copy of this object.
+    //!
+    PointNeighborSearcher3Ptr clone() const override;
+
+    //! Assignment operator.
+    PointSparseHashGridSearcher3& operator=(
+        const PointSparseHashGridSearcher3& other);
+
+    //! Copy from the other instance.
+    void set(const PointSparseHashGridSearcher3& other);
+
+    //! Serializes the neighbor searcher into the buffer.
+    void serialize(std::vector<uint8_t>* buffer) const override;
+
+    //! Deserializes the neighbor searcher from the buffer.
+    void deserialize(const std::vector<uint8_t>& buffer) override;
+
+    //! Returns builder fox PointSparseHashGridSearcher3.
+    static Builder builder();
+
+ private:
+    struct Bucket {
+        Point3I cell;
+        size_t start;
+        size_t end;
+    };
+
+    double _gridSpacing = 1.0;
+    size_t _numberOfOccupiedCells = 0;
+    std::vector<Vector3D> _points;
+    std::vector<size_t> _sortedIndices;
+    std::vector<Bucket> _buckets;
+
+    bool _usesDenseTable = false;
+    Point3I _denseTableOrigin;
+    Size3 _denseTableResolution;
+    std::vector<size_t> _startIndexTable;
+    std::vector<size_t> _endIndexTable;
+
+    void buildBuckets();
+
+    size_t denseTableKey(const Point3I& cell) const;
+
+    void getNearbyBucketIndices(
+        const Vector3D& position, Point3I* nearbyBucketIndices) const;
+
+    bool getNearbyBucketRange(
+        const Vector3D& position,
+        double radius,
+        Point3I* lower,
+        Point3I* upper) const;
+};
+
+//! Shared pointer for the PointSparseHashGridSearcher3 type.
+typedef std::shared_ptr<PointSparseHashGridSearcher3>
+    PointSparseHashGridSearcher3Ptr;
+
+//!
+//! \brief Front-end to create PointSparseHashGridSearcher3 objects step by
+//!        step.
+//!
+class PointSparseHashGridSearcher3::Builder final
+    : public PointNeighborSearcherBuilder3 {
+ public:
+    //! Returns builder with grid spacing.
+    Builder& withGridSpacing(double gridSpacing);
+
+    //! Builds PointSparseHashGridSearcher3 instance.
+    PointSparseHashGridSearcher3 build() const;
+
+    //! Builds shared pointer of PointSparseHashGridSearcher3 instance.
+    PointSparseHashGridSearcher3Ptr makeShared() const;
+
+    //! Returns shared pointer of PointNeighborSearcher3 type.
+    PointNeighborSearcher3Ptr buildPointNeighborSearcher() const override;
+
+ private:
+    double _gridSpacing = 1.0;
+};
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_POINT_SPARSE_HASH_GRID_SEARCHER3_H_
@@ -156,6 +156,15 @@ class ScalarGrid3 : public ScalarField3, public Grid3 {
     //!
     std::function<double(const Vector3D&)> sampler() const override;
 
+    //!
+    //! \brief Returns the linear sampler.
+    //!
+    //! Unlike ScalarGrid3::sampler, the returned sampler is statically typed
+    //! so that it can be inlined in the hot loops. The sampler refers to the
+    //! grid data and becomes invalid when the grid is resized.
+    //!
+    const LinearArraySampler3<double, double>& linearSampler() const;
+
     //! Returns the gradient vector at given position \p x.
     Vector3D gradient(const Vector3D& x) const override;
 
@@ -8,10 +8,37 @@
 #define INCLUDE_JET_SEMI_LAGRANGIAN3_H_
 
 #include <jet/advection_solver3.h>
+#include <jet/array_samplers3.h>
+#include <functional>
 #include <limits>
 
 namespace jet {
 
+namespace internal {
+
+//!
+//! \brief Flow sampler for the semi-Lagrangian back-tracing.
+//!
+//! If the flow is a face-centered grid, which is the most common case for the
+//! grid-based fluid solvers, the flow is sampled with the statically typed
+//! linear samplers. Otherwise, it falls back to VectorField3::sample.
+//!
+class SemiLagrangianFlowSampler3 {
+ public:
+    explicit SemiLagrangianFlowSampler3(const VectorField3& flow);
+
+    Vector3D operator()(const Vector3D& x) const;
+
+ private:
+    const VectorField3& _flow;
+    bool _isFaceCentered = false;
+    LinearArraySampler3<double, double> _uSampler;
+    LinearArraySampler3<double, double> _vSampler;
+    LinearArraySampler3<double, double> _wSampler;
+};
+
+}  // namespace internal
+
 //!
 //! \brief Implementation of 3-D semi-Lagrangian advection solver.
 //!
@@ -20,8 +47,12 @@ namespace jet {
 //! For the back-tracing, this class uses 2nd-order mid-point rule with adaptive
 //! time-stepping (CFL <= 1).
 //! To extend the class using higher-order spatial interpolation, the inheriting
-//! classes can override SemiLagrangian2::getScalarSamplerFunc and
-//! SemiLagrangian2::getVectorSamplerFunc. See CubicSemiLagrangian2 for example.
+//! classes can override SemiLagrangian3::getScalarSamplerFunc and
+//! SemiLagrangian3::getVectorSamplerFunc. For faster sampling, they can also
+//! override SemiLagrangian3::advect and call SemiLagrangian3::advectScalar,
+//! SemiLagrangian3::advectCollocated, or SemiLagrangian3::advectFaceCentered
+//! with their own statically typed samplers. See CubicSemiLagrangian3 for
+//! example.
 //!
 class SemiLagrangian3 : public AdvectionSolver3 {
  public:
@@ -50,7 +81,7 @@ class SemiLagrangian3 : public AdvectionSolver3 {
     void advect(const ScalarGrid3& input, const VectorField3& flow, double dt,
                 ScalarGrid3* output,
                 const ScalarField3& boundarySdf = ConstantScalarField3(
-                    std::numeric_limits<double>::max())) final;
+                    std::numeric_limits<double>::max())) override;
 
     //!
     //! \brief Computes semi-Langian for given collocated vector grid.
@@ -73,7 +104,7 @@ class SemiLagrangian3 : public AdvectionSolver3 {
     void advect(const CollocatedVectorGrid3& input, const VectorField3& flow,
                 double dt, CollocatedVectorGrid3* output,
                 const ScalarField3& boundarySdf = ConstantScalarField3(
-                    std::numeric_limits<double>::max())) final;
+                    std::numeric_limits<double>::max())) override;
 
     //!
     //! \brief Computes semi-Langian for given face-centered vector grid.
@@ -97,7 +128,32 @@ class SemiLagrangian3 : public AdvectionSolver3 {
     void advect(const FaceCenteredGrid3& input, const VectorField3& flow,
                 double dt, FaceCenteredGrid3* output,
                 const ScalarField3& boundarySdf = ConstantScalarField3(
-                    std::numeric_limits<double>::max())) final;
+                    std::numeric_limits<double>::max())) override;
+
+    //!
+    //! \brief Computes semi-Langian for multiple scalar grids at once.
+    //!
+    //! This function computes semi-Lagrangian method for each scalar grid in
+    //! \p inputs and stores the solution in the grid with the same index in
+    //! \p outputs. If the grids are co-located, meaning that they have the same
+    //! data points, the departure point of each data point is back-traced only
+    //! once and shared by all the grids. The result is identical to calling
+    //! SemiLagrangian3::advect for each grid. For the inheriting classes, which
+    //! may customize the sampling, this function calls advect for each grid
+    //! unless they override this function as well.
+    //!
+    //! \param inputs Input scalar grids.
+    //! \param flow Vector field that advects the input fields.
+    //! \param dt Time-step for the advection.
+    //! \param outputs Output scalar grids.
+    //! \param boundarySdf Boundary interface defined by signed-distance
+    //!     field.
+    //!
+    void advectScalars(const std::vector<const ScalarGrid3*>& inputs,
+                       const VectorField3& flow, double dt,
+                       const std::vector<ScalarGrid3*>& outputs,
+                       const ScalarField3& boundarySdf = ConstantScalarField3(
+                           std::numeric_limits<double>::max())) override;
 
  protected:
     //!
@@ -136,13 +192,76 @@ class SemiLagrangian3 : public AdvectionSolver3 {
     virtual std::function<Vector3D(const Vector3D&)> getVectorSamplerFunc(
         const FaceCenteredGrid3& input) const;
 
+    //!
+    //! \brief Computes semi-Lagrangian for given scalar grid and sampler.
+    //!
+    //! This function back-traces the data points of \p output and evaluates
+    //! \p inputSampler at the traced positions. The sampler can be any
+    //! callable object that maps Vector3D to double, and it is statically
+    //! typed so that the sampling can be inlined in the loop.
+    //!
+    template <typename InputSampler>
+    void advectScalar(const ScalarGrid3& input,
+                      const InputSampler& inputSampler,
+                      const VectorField3& flow, double dt, ScalarGrid3* output,
+                      const ScalarField3& boundarySdf);
+
+    //!
+    //! \brief Computes semi-Lagrangian for given scalar grids and samplers.
+    //!
+    //! This function groups the co-located grids and back-traces the data
+    //! points once per group. The i-th output is the advection of the i-th
+    //! input evaluated by the i-th sampler of \p inputSamplers.
+    //!
+    template <typename InputSampler>
+    void advectCoLocatedScalars(const std::vector<const ScalarGrid3*>& inputs,
+                                const std::vector<InputSampler>& inputSamplers,
+                                const VectorField3& flow, double dt,
+                                const std::vector<ScalarGrid3*>& outputs,
+                                const ScalarField3& boundarySdf);
+
+    //!
+    //! \brief Computes semi-Lagrangian for given collocated vector grid and
+    //! sampler.
+    //!
+    //! This function back-traces the data points of \p output and evaluates
+    //! \p inputSampler at the traced positions. The sampler can be any
+    //! callable object that maps Vector3D to Vector3D.
+    //!
+    template <typename InputSampler>
+    void advectCollocated(const CollocatedVectorGrid3& input,
+                          const InputSampler& inputSampler,
+                          const VectorField3& flow, double dt,
+                          CollocatedVectorGrid3* output,
+                          const ScalarField3& boundarySdf);
+
+    //!
+    //! \brief Computes semi-Lagrangian for given face-centered vector grid and
+    //! samplers.
+    //!
+    //! This function back-traces the u, v, and w data points of \p output and
+    //! evaluates the corresponding component sampler at the traced positions.
+    //! Each sampler can be any callable object that maps Vector3D to double.
+    //!
+    template <typename ComponentSampler>
+    void advectFaceCentered(const FaceCenteredGrid3& input,
+                            const ComponentSampler& uSampler,
+                            const ComponentSampler& vSampler,
+                            const ComponentSampler& wSampler,
+                            const VectorField3& flow, double dt,
+                            FaceCenteredGrid3* output,
+                            const ScalarField3& boundarySdf);
+
  private:
-    Vector3D backTrace(const VectorField3& flow, double dt, double h,
-                       const Vector3D& pt0, const ScalarField3& boundarySdf);
+    Vector3D backTrace(const internal::SemiLagrangianFlowSampler3& flow,
+                       double dt, double h, const Vector3D& pt0,
+                       const ScalarField3& boundarySdf);
 };
 
 typedef std::shared_ptr<SemiLagrangian3> SemiLagrangian3Ptr;
 
 }  // namespace jet
 
+#include "detail/semi_lagrangian3-inl.h"
+
 #endif  // INCLUDE_JET_SEMI_LAGRANGIAN3_H_
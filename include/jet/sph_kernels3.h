@@ -61,6 +61,39 @@ struct SphStdKernel3 {
 
     //! Returns the second derivative at given distance.
     double secondDerivative(double distance) const;
+
+    //!
+    //! \brief      Computes kernel function values for given distances.
+    //!
+    //! This function and the other batch functions below evaluate the kernel
+    //! for \p n contiguous inputs with a branch-free loop so that the
+    //! compiler can vectorize it. The results are identical to the
+    //! single-distance functions. \p results may point to the input array.
+    //!
+    //! \param[in]  distances The distances.
+    //! \param[in]  n         The number of distances.
+    //! \param[out] results   The kernel function values.
+    //!
+    void values(const double* distances, size_t n, double* results) const;
+
+    //! Computes kernel function values for given squared distances.
+    void valuesFromSquaredDistances(
+        const double* squaredDistances, size_t n, double* results) const;
+
+    //! Computes the first derivatives for given distances.
+    void firstDerivatives(
+        const double* distances, size_t n, double* results) const;
+
+    //! Computes the gradients for given distances and directions.
+    void gradients(
+        const double* distances,
+        const Vector3D* directions,
+        size_t n,
+        Vector3D* results) const;
+
+    //! Computes the second derivatives for given distances.
+    void secondDerivatives(
+        const double* distances, size_t n, double* results) const;
 };
 
 //!
@@ -110,6 +143,39 @@ struct SphSpikyKernel3 {
 
     //! Returns the second derivative at given distance.
     double secondDerivative(double distance) const;
+
+    //!
+    //! \brief      Computes kernel function values for given distances.
+    //!
+    //! This function and the other batch functions below evaluate the kernel
+    //! for \p n contiguous inputs with a branch-free loop so that the
+    //! compiler can vectorize it. The results are identical to the
+    //! single-distance functions. \p results may point to the input array.
+    //!
+    //! \param[in]  distances The distances.
+    //! \param[in]  n         The number of distances.
+    //! \param[out] results   The kernel function values.
+    //!
+    void values(const double* distances, size_t n, double* results) const;
+
+    //! Computes kernel function values for given squared distances.
+    void valuesFromSquaredDistances(
+        const double* squaredDistances, size_t n, double* results) const;
+
+    //! Computes the first derivatives for given distances.
+    void firstDerivatives(
+        const double* distances, size_t n, double* results) const;
+
+    //! Computes the gradients for given distances and directions.
+    void gradients(
+        const double* distances,
+        const Vector3D* directions,
+        size_t n,
+        Vector3D* results) const;
+
+    //! Computes the second derivatives for given distances.
+    void secondDerivatives(
+        const double* distances, size_t n, double* results) const;
 };
 
 }  // namespace jet
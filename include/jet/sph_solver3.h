@@ -114,6 +114,58 @@ class SphSolver3 : public ParticleSystemSolver3 {
     //!
     void setTimeStepLimitScale(double newScale);
 
+    //! Returns true if the quiescent particles are put to sleep.
+    bool isUsingSleeping() const;
+
+    //!
+    //! \brief Sets true to put the quiescent particles to sleep.
+    //!
+    //! When enabled, a particle whose speed and density error ratio stay below
+    //! the thresholds for the given number of steps falls asleep. A sleeping
+    //! particle is held at rest and skipped by the force passes. Its density
+    //! and pressure are only updated while it has an awake neighbor. A
+    //! sleeping particle wakes up when any of its neighbors has moved in the
+    //! previous step. Default is false.
+    //!
+    void setIsUsingSleeping(bool onoff);
+
+    //! Returns the speed below which a particle is considered at rest.
+    double sleepingVelocityThreshold() const;
+
+    //!
+    //! \brief Sets the speed below which a particle is considered at rest.
+    //!
+    //! Default is 0.1 m/s. The input value should be non-negative.
+    //!
+    void setSleepingVelocityThreshold(double newThreshold);
+
+    //! Returns the density error ratio below which a particle is at rest.
+    double sleepingDensityErrorThreshold() const;
+
+    //!
+    //! \brief Sets the density error ratio below which a particle is at rest.
+    //!
+    //! The density error ratio is |density / target density - 1| where the
+    //! expansion is scaled by the negative pressure scale, so the particles
+    //! near the free surface can fall asleep unless the negative pressure is
+    //! enabled. Default is 0.01 (1%). The input value should be non-negative.
+    //!
+    void setSleepingDensityErrorThreshold(double newThreshold);
+
+    //! Returns the number of quiescent steps before a particle falls asleep.
+    unsigned int sleepingStepCount() const;
+
+    //!
+    //! \brief Sets the number of quiescent steps before a particle falls
+    //!        asleep.
+    //!
+    //! Default is 10. The input value is clamped to be at least 1.
+    //!
+    void setSleepingStepCount(unsigned int n);
+
+    //! Returns the number of sleeping particles in the last step.
+    size_t numberOfSleepingParticles() const;
+
     //! Returns the SPH system data.
     SphSystemData3Ptr sphSystemData() const;
 
@@ -152,13 +204,44 @@ class SphSolver3 : public ParticleSystemSolver3 {
         const ConstArrayAccessor1<double>& pressures,
         ArrayAccessor1<Vector3D> pressureForces);
 
+    //! Returns the pressure force of the i-th particle in \p particles.
+    static Vector3D computePressureForce(
+        const SphSystemData3& particles,
+        size_t i,
+        const ConstArrayAccessor1<Vector3D>& positions,
+        const ConstArrayAccessor1<double>& densities,
+        const ConstArrayAccessor1<double>& pressures);
+
     //! Accumulates the viscosity force to the forces array in the particle
     //! system.
     void accumulateViscosityForce();
 
+    //!
+    //! \brief Accumulates both the viscosity and the pressure forces to the
+    //!        forces array in the particle system.
+    //!
+    //! The neighbors of each particle are visited only once for both forces,
+    //! which is cheaper if the neighbors are gathered on the fly instead of
+    //! read from the neighbor lists. The pressures should be computed before
+    //! calling this function.
+    //!
+    void accumulateViscosityAndPressureForces();
+
     //! Computes pseudo viscosity.
     void computePseudoViscosity(double timeStepInSeconds);
 
+    //! Returns true if the i-th particle is asleep in the current step.
+    bool isSleeping(size_t i) const;
+
+    //!
+    //! \brief Returns true if the density of the i-th particle is updated in
+    //!        the current step.
+    //!
+    //! This is true for the awake particles and the sleeping particles with an
+    //! awake neighbor.
+    //!
+    bool needsDensityUpdate(size_t i) const;
+
  private:
     //! Exponent component of equation-of-state (or Tait's equation).
     double _eosExponent = 7.0;
@@ -182,6 +265,24 @@ class SphSolver3 : public ParticleSystemSolver3 {
 
     //! Scales the max allowed time-step.
     double _timeStepLimitScale = 1.0;
+
+    bool _isUsingSleeping = false;
+    double _sleepingVelocityThreshold = 0.1;
+    double _sleepingDensityErrorThreshold = 0.01;
+    unsigned int _sleepingStepCount = 10;
+    size_t _numberOfSleepingParticles = 0;
+
+    //! Number of consecutive quiescent steps per particle.
+    size_t _sleepCounterIdx = kMaxSize;
+
+    //! Sleep states of the current step.
+    Array1<char> _sleepStates;
+
+    void updateSleepStates();
+
+    void updateSleepCounters();
+
+    void cancelSleepingForces(double timeStepInSeconds);
 };
 
 //! Shared pointer type for the SphSolver3.
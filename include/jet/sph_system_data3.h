@@ -63,9 +63,25 @@ class SphSystemData3 : public ParticleSystemData3 {
     //! Returns the pressure array accessor (mutable).
     ArrayAccessor1<double> pressures();
 
-    //! Updates the density array with the latest particle positions.
+    //!
+    //! \brief Updates the density array with the latest particle positions.
+    //!
+    //! If the skin radius is positive, the densities are computed from the
+    //! neighbor lists since the neighbor searcher may hold outdated positions.
+    //! Otherwise, the neighbor searcher is used.
+    //!
     void updateDensities();
 
+    //!
+    //! \brief Updates the densities of the particles with nonzero mask values.
+    //!
+    //! The densities of the other particles are left unchanged. If the mask is
+    //! empty, all densities are updated.
+    //!
+    //! \param[in] mask The mask with the same size as the particles.
+    //!
+    void updateDensities(const ConstArrayAccessor1<char>& mask);
+
     //! Sets the target density of this particle system.
     void setTargetDensity(double targetDensity);
 
@@ -157,6 +173,9 @@ class SphSystemData3 : public ParticleSystemData3 {
     //! Builds neighbor lists with kernel radius.
     void buildNeighborLists();
 
+    //! Returns true if the neighbor lists for kernel radius should be rebuilt.
+    bool needsNeighborListsRebuild() const;
+
     //! Serializes this SPH system data to the buffer.
     void serialize(std::vector<uint8_t>* buffer) const override;
 
@@ -12,16 +12,19 @@
 #include <jet/particle_emitter3.h>
 #include <jet/point_generator3.h>
 
+#include <cstdint>
 #include <limits>
 #include <memory>
-#include <random>
 
 namespace jet {
 
 //!
 //! \brief 3-D volumetric particle emitter.
 //!
-//! This class emits particles from volumetric geometry.
+//! This class emits particles from volumetric geometry. The candidate points
+//! are evaluated in parallel and jittered with a counter-based random number
+//! generator, so the emitted particles only depend on the random seed and do
+//! not change with the number of threads.
 //!
 class VolumeParticleEmitter3 final : public ParticleEmitter3 {
  public:
@@ -148,7 +151,7 @@ class VolumeParticleEmitter3 final : public ParticleEmitter3 {
     static Builder builder();
 
  private:
-    std::mt19937 _rng;
+    uint32_t _seed;
 
     ImplicitSurface3Ptr _implicitSurface;
     BoundingBox3D _bounds;
@@ -160,6 +163,7 @@ class VolumeParticleEmitter3 final : public ParticleEmitter3 {
 
     size_t _maxNumberOfParticles = kMaxSize;
     size_t _numberOfEmittedParticles = 0;
+    uint64_t _numberOfEmissions = 0;
 
     double _jitter = 0.0;
     bool _isOneShot = true;
@@ -180,8 +184,6 @@ class VolumeParticleEmitter3 final : public ParticleEmitter3 {
         Array1<Vector3D>* newPositions,
         Array1<Vector3D>* newVelocities);
 
-    double random();
-
     Vector3D velocityAt(const Vector3D& point) const;
 };
 
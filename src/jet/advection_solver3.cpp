@@ -41,3 +41,16 @@ void AdvectionSolver3::advect(
     UNUSED_VARIABLE(target);
     UNUSED_VARIABLE(boundarySdf);
 }
+
+void AdvectionSolver3::advectScalars(
+    const std::vector<const ScalarGrid3*>& inputs,
+    const VectorField3& flow,
+    double dt,
+    const std::vector<ScalarGrid3*>& outputs,
+    const ScalarField3& boundarySdf) {
+    JET_THROW_INVALID_ARG_IF(inputs.size() != outputs.size());
+
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        advect(*inputs[i], flow, dt, outputs[i], boundarySdf);
+    }
+}
@@ -6,6 +6,7 @@
 
 #include <pch.h>
 #include <jet/apic_solver2.h>
+#include <jet/array_scatter.h>
 
 using namespace jet;
 
@@ -35,20 +36,13 @@ void ApicSolver2::transferFromParticlesToGrids() {
     _cX.resize(numberOfParticles);
     _cY.resize(numberOfParticles);
 
-    // Clear velocity to zero
-    flow->fill(Vector2D());
-
     // Weighted-average velocity
     auto u = flow->uAccessor();
     auto v = flow->vAccessor();
     const auto uPos = flow->uPosition();
     const auto vPos = flow->vPosition();
-    Array2<double> uWeight(u.size());
-    Array2<double> vWeight(v.size());
     _uMarkers.resize(u.size());
     _vMarkers.resize(v.size());
-    _uMarkers.set(0);
-    _vMarkers.set(0);
     LinearArraySampler2<double, double> uSampler(
         flow->uConstAccessor(),
         flow->gridSpacing(),
@@ -58,49 +52,39 @@ void ApicSolver2::transferFromParticlesToGrids() {
         flow->gridSpacing(),
         flow->vOrigin());
 
-    for (size_t i = 0; i < numberOfParticles; ++i) {
-        std::array<Point2UI, 4> indices;
-        std::array<double, 4> weights;
-
-        auto uPosClamped = positions[i];
-        uPosClamped.y = clamp(
-            uPosClamped.y,
+    auto uPosClamped = [&](size_t i) {
+        auto pos = positions[i];
+        pos.y = clamp(
+            pos.y,
             bbox.lowerCorner.y + hh.y,
             bbox.upperCorner.y - hh.y);
-        uSampler.getCoordinatesAndWeights(uPosClamped, &indices, &weights);
-        for (int j = 0; j < 4; ++j) {
-            Vector2D gridPos = uPos(indices[j].x, indices[j].y);
-            double apicTerm = _cX[i].dot(gridPos - uPosClamped);
-            u(indices[j]) += weights[j] * (velocities[i].x + apicTerm);
-            uWeight(indices[j]) += weights[j];
-            _uMarkers(indices[j]) = 1;
-        }
-
-        auto vPosClamped = positions[i];
-        vPosClamped.x = clamp(
-            vPosClamped.x,
+        return pos;
+    };
+    auto vPosClamped = [&](size_t i) {
+        auto pos = positions[i];
+        pos.x = clamp(
+            pos.x,
             bbox.lowerCorner.x + hh.x,
             bbox.upperCorner.x - hh.x);
-        vSampler.getCoordinatesAndWeights(vPosClamped, &indices, &weights);
-        for (int j = 0; j < 4; ++j) {
-            Vector2D gridPos = vPos(indices[j].x, indices[j].y);
-            double apicTerm = _cY[i].dot(gridPos - vPosClamped);
-            v(indices[j]) += weights[j] * (velocities[i].y + apicTerm);
-            vWeight(indices[j]) += weights[j];
-            _vMarkers(indices[j]) = 1;
-        }
-    }
-
-    uWeight.parallelForEachIndex([&](size_t i, size_t j) {
-        if (uWeight(i, j) > 0.0) {
-            u(i, j) /= uWeight(i, j);
-        }
-    });
-    vWeight.parallelForEachIndex([&](size_t i, size_t j) {
-        if (vWeight(i, j) > 0.0) {
-            v(i, j) /= vWeight(i, j);
-        }
-    });
+        return pos;
+    };
+
+    scatterWeightedAverage(
+        numberOfParticles, uSampler, uPosClamped,
+        [&](size_t i, const Point2UI& idx) {
+            Vector2D gridPos = uPos(idx.x, idx.y);
+            double apicTerm = _cX[i].dot(gridPos - uPosClamped(i));
+            return velocities[i].x + apicTerm;
+        },
+        u, _uMarkers.accessor());
+    scatterWeightedAverage(
+        numberOfParticles, vSampler, vPosClamped,
+        [&](size_t i, const Point2UI& idx) {
+            Vector2D gridPos = vPos(idx.x, idx.y);
+            double apicTerm = _cY[i].dot(gridPos - vPosClamped(i));
+            return velocities[i].y + apicTerm;
+        },
+        v, _vMarkers.accessor());
 }
 
 void ApicSolver2::transferFromGridsToParticles() {
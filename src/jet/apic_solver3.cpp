@@ -6,6 +6,8 @@
 
 #include <pch.h>
 #include <jet/apic_solver3.h>
+#include <jet/array_scatter.h>
+#include <jet/parallel.h>
 
 using namespace jet;
 
@@ -23,6 +25,41 @@ ApicSolver3::ApicSolver3(
 ApicSolver3::~ApicSolver3() {
 }
 
+void ApicSolver3::sortParticles() {
+    Array1<size_t> permutation;
+    particleSystemData()->sortParticles(&permutation);
+
+    gatherCoefficients(permutation, permutation.size());
+}
+
+void ApicSolver3::removeParticles(const ConstArrayAccessor1<char>& mask) {
+    Array1<size_t> remaining;
+    particleSystemData()->removeParticles(mask, &remaining);
+
+    gatherCoefficients(remaining, mask.size());
+}
+
+void ApicSolver3::gatherCoefficients(
+    const Array1<size_t>& indices, size_t oldNumberOfParticles) {
+    // Newly emitted particles get zero coefficients as in the P2G transfer
+    _cX.resize(oldNumberOfParticles);
+    _cY.resize(oldNumberOfParticles);
+    _cZ.resize(oldNumberOfParticles);
+
+    const size_t numberOfParticles = indices.size();
+    Array1<Vector3D> cX(numberOfParticles);
+    Array1<Vector3D> cY(numberOfParticles);
+    Array1<Vector3D> cZ(numberOfParticles);
+    parallelFor(kZeroSize, numberOfParticles, [&](size_t i) {
+        cX[i] = _cX[indices[i]];
+        cY[i] = _cY[indices[i]];
+        cZ[i] = _cZ[indices[i]];
+    });
+    _cX.swap(cX);
+    _cY.swap(cY);
+    _cZ.swap(cZ);
+}
+
 void ApicSolver3::transferFromParticlesToGrids() {
     auto flow = gridSystemData()->velocity();
     const auto particles = particleSystemData();
@@ -37,9 +74,6 @@ void ApicSolver3::transferFromParticlesToGrids() {
     _cY.resize(numberOfParticles);
     _cZ.resize(numberOfParticles);
 
-    // Clear velocity to zero
-    flow->fill(Vector3D());
-
     // Weighted-average velocity
     auto u = flow->uAccessor();
     auto v = flow->vAccessor();
@@ -47,15 +81,9 @@ void ApicSolver3::transferFromParticlesToGrids() {
     const auto uPos = flow->uPosition();
     const auto vPos = flow->vPosition();
     const auto wPos = flow->wPosition();
-    Array3<double> uWeight(u.size());
-    Array3<double> vWeight(v.size());
-    Array3<double> wWeight(w.size());
     _uMarkers.resize(u.size());
     _vMarkers.resize(v.size());
     _wMarkers.resize(w.size());
-    _uMarkers.set(0);
-    _vMarkers.set(0);
-    _wMarkers.set(0);
     LinearArraySampler3<double, double> uSampler(
         flow->uConstAccessor(),
         flow->gridSpacing(),
@@ -69,80 +97,69 @@ void ApicSolver3::transferFromParticlesToGrids() {
         flow->gridSpacing(),
         flow->wOrigin());
 
-    for (size_t i = 0; i < numberOfParticles; ++i) {
-        std::array<Point3UI, 8> indices;
-        std::array<double, 8> weights;
-
-        auto uPosClamped = positions[i];
-        uPosClamped.y = clamp(
-            uPosClamped.y,
+    auto uPosClamped = [&](size_t i) {
+        auto pos = positions[i];
+        pos.y = clamp(
+            pos.y,
             bbox.lowerCorner.y + hh.y,
             bbox.upperCorner.y - hh.y);
-        uPosClamped.z = clamp(
-            uPosClamped.z,
+        pos.z = clamp(
+            pos.z,
             bbox.lowerCorner.z + hh.z,
             bbox.upperCorner.z - hh.z);
-        uSampler.getCoordinatesAndWeights(uPosClamped, &indices, &weights);
-        for (int j = 0; j < 8; ++j) {
-            Vector3D gridPos = uPos(indices[j].x, indices[j].y, indices[j].z);
-            double apicTerm = _cX[i].dot(gridPos - uPosClamped);
-            u(indices[j]) += weights[j] * (velocities[i].x + apicTerm);
-            uWeight(indices[j]) += weights[j];
-            _uMarkers(indices[j]) = 1;
-        }
-
-        auto vPosClamped = positions[i];
-        vPosClamped.x = clamp(
-            vPosClamped.x,
+        return pos;
+    };
+    auto vPosClamped = [&](size_t i) {
+        auto pos = positions[i];
+        pos.x = clamp(
+            pos.x,
             bbox.lowerCorner.x + hh.x,
             bbox.upperCorner.x - hh.x);
-        vPosClamped.z = clamp(
-            vPosClamped.z,
+        pos.z = clamp(
+            pos.z,
             bbox.lowerCorner.z + hh.z,
             bbox.upperCorner.z - hh.z);
-        vSampler.getCoordinatesAndWeights(vPosClamped, &indices, &weights);
-        for (int j = 0; j < 8; ++j) {
-            Vector3D gridPos = vPos(indices[j].x, indices[j].y, indices[j].z);
-            double apicTerm = _cY[i].dot(gridPos - vPosClamped);
-            v(indices[j]) += weights[j] * (velocities[i].y + apicTerm);
-            vWeight(indices[j]) += weights[j];
-            _vMarkers(indices[j]) = 1;
-        }
-
-        auto wPosClamped = positions[i];
-        wPosClamped.x = clamp(
-            wPosClamped.x,
+        return pos;
+    };
+    auto wPosClamped = [&](size_t i) {
+        auto pos = positions[i];
+        pos.x = clamp(
+            pos.x,
             bbox.lowerCorner.x + hh.x,
             bbox.upperCorner.x - hh.x);
-        wPosClamped.y = clamp(
-            wPosClamped.y,
+        pos.y = clamp(
+            pos.y,
             bbox.lowerCorner.y + hh.y,
             bbox.upperCorner.y - hh.y);
-        wSampler.getCoordinatesAndWeights(wPosClamped, &indices, &weights);
-        for (int j = 0; j < 8; ++j) {
-            Vector3D gridPos = wPos(indices[j].x, indices[j].y, indices[j].z);
-            double apicTerm = _cZ[i].dot(gridPos - wPosClamped);
-            w(indices[j]) += weights[j] * (velocities[i].z + apicTerm);
-            wWeight(indices[j]) += weights[j];
-            _wMarkers(indices[j]) = 1;
-        }
-    }
+        return pos;
+    };
 
-    uWeight.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        if (uWeight(i, j, k) > 0.0) {
-            u(i, j, k) /= uWeight(i, j, k);
-        }
-    });
-    vWeight.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        if (vWeight(i, j, k) > 0.0) {
-            v(i, j, k) /= vWeight(i, j, k);
-        }
-    });
-    wWeight.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        if (wWeight(i, j, k) > 0.0) {
-            w(i, j, k) /= wWeight(i, j, k);
-        }
-    });
+    scatterWeightedAverage(
+        numberOfParticles, uSampler, uPosClamped,
+        [&](size_t i, const Point3UI& idx) {
+            Vector3D gridPos = uPos(idx.x, idx.y, idx.z);
+            double apicTerm = _cX[i].dot(gridPos - uPosClamped(i));
+            return velocities[i].x + apicTerm;
+        },
+        u, _uMarkers.accessor());
+    scatterWeightedAverage(
+        numberOfParticles, vSampler, vPosClamped,
+        [&](size_t i, const Point3UI& idx) {
+            Vector3D gridPos = vPos(idx.x, idx.y, idx.z);
+            double apicTerm = _cY[i].dot(gridPos - vPosClamped(i));
+            return velocities[i].y + apicTerm;
+        },
+        v, _vMarkers.accessor());
+    scatterWeightedAverage(
+        numberOfParticles, wSampler, wPosClamped,
+        [&](size_t i, const Point3UI& idx) {
+            Vector3D gridPos = wPos(idx.x, idx.y, idx.z);
+            double apicTerm = _cZ[i].dot(gridPos - wPosClamped(i));
+            return velocities[i].z + apicTerm;
+        },
+        w, _wMarkers.accessor());
+
+    transferFromLiquidInteriorToGrids();
 }
 
 void ApicSolver3::transferFromGridsToParticles() {
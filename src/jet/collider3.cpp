@@ -6,12 +6,18 @@
 
 #include <pch.h>
 
+#include <jet/array3.h>
 #include <jet/collider3.h>
+#include <jet/parallel.h>
 
 #include <algorithm>
+#include <cmath>
 
 using namespace jet;
 
+// Target number of points per broad-phase grid node
+static const double kBroadPhasePointsPerNode = 8.0;
+
 Collider3::Collider3() {}
 
 Collider3::~Collider3() {}
@@ -26,6 +32,12 @@ void Collider3::resolveCollision(double radius, double restitutionCoefficient,
 
     ColliderQueryResult colliderPoint;
 
+    // Query the rest of the closest point only for the penetrating point
+    colliderPoint.distance = _surface->closestDistance(*newPosition);
+    if (!isPenetrating(colliderPoint, *newPosition, radius)) {
+        return;
+    }
+
     getClosestPoint(_surface, *newPosition, &colliderPoint);
 
     // Check if the new position is penetrating the surface
@@ -73,6 +85,92 @@ void Collider3::resolveCollision(double radius, double restitutionCoefficient,
     }
 }
 
+void Collider3::resolveCollision(double radius, double restitutionCoefficient,
+                                 ArrayAccessor1<Vector3D> positions,
+                                 ArrayAccessor1<Vector3D> velocities) {
+    JET_ASSERT(_surface);
+    JET_THROW_INVALID_ARG_IF(positions.size() != velocities.size());
+
+    const size_t numberOfPoints = positions.size();
+    if (numberOfPoints == 0 || !_surface->isValidGeometry()) {
+        return;
+    }
+
+    auto resolve = [&](size_t i) {
+        resolveCollision(radius, restitutionCoefficient, &positions[i],
+                         &velocities[i]);
+    };
+
+    if (!_isUsingBroadPhase) {
+        parallelFor(kZeroSize, numberOfPoints, resolve);
+        return;
+    }
+
+    // Grid that covers the points with the spacing of at least the diameter
+    BoundingBox3D bound = parallelReduce(
+        kZeroSize, numberOfPoints, BoundingBox3D(),
+        [&](size_t begin, size_t end, BoundingBox3D result) {
+            for (size_t i = begin; i < end; ++i) {
+                result.merge(positions[i]);
+            }
+            return result;
+        },
+        [](BoundingBox3D a, const BoundingBox3D& b) {
+            a.merge(b);
+            return a;
+        });
+    const Vector3D extent = bound.upperCorner - bound.lowerCorner;
+    const double volume =
+        (extent.x + 2.0 * radius) * (extent.y + 2.0 * radius) *
+        (extent.z + 2.0 * radius);
+    const double spacing = std::max(
+        2.0 * radius,
+        std::cbrt(kBroadPhasePointsPerNode * volume / numberOfPoints));
+    const Size3 resolution(static_cast<size_t>(extent.x / spacing) + 2,
+                           static_cast<size_t>(extent.y / spacing) + 2,
+                           static_cast<size_t>(extent.z / spacing) + 2);
+
+    // Not worth it if the grid is as large as the points
+    const size_t numberOfNodes = resolution.x * resolution.y * resolution.z;
+    if (numberOfNodes * 2 > numberOfPoints) {
+        parallelFor(kZeroSize, numberOfPoints, resolve);
+        return;
+    }
+
+    // Distances from the nodes outside the surface. Since the distance is
+    // 1-Lipschitz, a point farther than the radius plus the distance to its
+    // node from the surface cannot be penetrating it.
+    const Vector3D origin = bound.lowerCorner;
+    Array3<double> margins(resolution);
+    margins.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        const Vector3D node = origin + spacing * Vector3D(i, j, k);
+        margins(i, j, k) =
+            _surface->isInside(node) ? 0.0 : _surface->closestDistance(node);
+    });
+
+    parallelFor(kZeroSize, numberOfPoints, [&](size_t idx) {
+        const Vector3D g = (positions[idx] - origin) / spacing;
+        const size_t i = std::min(static_cast<size_t>(g.x + 0.5),
+                                  resolution.x - 1);
+        const size_t j = std::min(static_cast<size_t>(g.y + 0.5),
+                                  resolution.y - 1);
+        const size_t k = std::min(static_cast<size_t>(g.z + 0.5),
+                                  resolution.z - 1);
+        const Vector3D node = origin + spacing * Vector3D(i, j, k);
+        if (margins(i, j, k) - positions[idx].distanceTo(node) > radius) {
+            return;
+        }
+
+        resolve(idx);
+    });
+}
+
+bool Collider3::isUsingBroadPhase() const { return _isUsingBroadPhase; }
+
+void Collider3::setIsUsingBroadPhase(bool onoff) {
+    _isUsingBroadPhase = onoff;
+}
+
 double Collider3::frictionCoefficient() const { return _frictionCoeffient; }
 
 void Collider3::setFrictionCoefficient(double newFrictionCoeffient) {
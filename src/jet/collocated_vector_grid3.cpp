@@ -86,7 +86,7 @@ Vector3D CollocatedVectorGrid3::curlAtDataPoint(
 }
 
 Vector3D CollocatedVectorGrid3::sample(const Vector3D& x) const {
-    return _sampler(x);
+    return _linearSampler(x);
 }
 
 double CollocatedVectorGrid3::divergence(const Vector3D& x) const {
@@ -124,6 +124,11 @@ CollocatedVectorGrid3::sampler() const {
     return _sampler;
 }
 
+const LinearArraySampler3<Vector3D, double>&
+CollocatedVectorGrid3::linearSampler() const {
+    return _linearSampler;
+}
+
 VectorGrid3::VectorDataAccessor CollocatedVectorGrid3::dataAccessor() {
     return _data.accessor();
 }
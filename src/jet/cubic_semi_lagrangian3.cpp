@@ -8,11 +8,80 @@
 #include <jet/array_samplers3.h>
 #include <jet/cubic_semi_lagrangian3.h>
 
+#include <vector>
+
 using namespace jet;
 
 CubicSemiLagrangian3::CubicSemiLagrangian3() {
 }
 
+void CubicSemiLagrangian3::advect(
+    const ScalarGrid3& input,
+    const VectorField3& flow,
+    double dt,
+    ScalarGrid3* output,
+    const ScalarField3& boundarySdf) {
+    CubicArraySampler3<double, double> inputSampler(
+        input.constDataAccessor(),
+        input.gridSpacing(),
+        input.dataOrigin());
+    advectScalar(input, inputSampler, flow, dt, output, boundarySdf);
+}
+
+void CubicSemiLagrangian3::advect(
+    const CollocatedVectorGrid3& input,
+    const VectorField3& flow,
+    double dt,
+    CollocatedVectorGrid3* output,
+    const ScalarField3& boundarySdf) {
+    CubicArraySampler3<Vector3D, double> inputSampler(
+        input.constDataAccessor(),
+        input.gridSpacing(),
+        input.dataOrigin());
+    advectCollocated(input, inputSampler, flow, dt, output, boundarySdf);
+}
+
+void CubicSemiLagrangian3::advect(
+    const FaceCenteredGrid3& input,
+    const VectorField3& flow,
+    double dt,
+    FaceCenteredGrid3* output,
+    const ScalarField3& boundarySdf) {
+    CubicArraySampler3<double, double> uSampler(
+        input.uConstAccessor(),
+        input.gridSpacing(),
+        input.uOrigin());
+    CubicArraySampler3<double, double> vSampler(
+        input.vConstAccessor(),
+        input.gridSpacing(),
+        input.vOrigin());
+    CubicArraySampler3<double, double> wSampler(
+        input.wConstAccessor(),
+        input.gridSpacing(),
+        input.wOrigin());
+    advectFaceCentered(
+        input, uSampler, vSampler, wSampler, flow, dt, output, boundarySdf);
+}
+
+void CubicSemiLagrangian3::advectScalars(
+    const std::vector<const ScalarGrid3*>& inputs,
+    const VectorField3& flow,
+    double dt,
+    const std::vector<ScalarGrid3*>& outputs,
+    const ScalarField3& boundarySdf) {
+    std::vector<CubicArraySampler3<double, double>> inputSamplers;
+    inputSamplers.reserve(inputs.size());
+    for (const auto& input : inputs) {
+        inputSamplers.emplace_back(
+            input->constDataAccessor(),
+            input->gridSpacing(),
+            input->dataOrigin());
+    }
+
+    advectCoLocatedScalars(
+        inputs, inputSamplers, flow, dt, outputs, boundarySdf);
+}
+
 std::function<double(const Vector3D&)>
 CubicSemiLagrangian3::getScalarSamplerFunc(const ScalarGrid3& source) const {
     auto sourceSampler = CubicArraySampler3<double, double>(
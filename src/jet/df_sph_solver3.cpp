@@ -0,0 +1,455 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+#include <jet/df_sph_solver3.h>
+#include <jet/parallel.h>
+#include <jet/sph_kernels3.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+using namespace jet;
+
+// Particles with smaller denominator have too few neighbors to be corrected
+const double kAlphaDenominatorThreshold = 1e-6;
+
+static const size_t kNeighborBatchSize
+    = ParticleSystemData3::kNeighborBatchSize;
+
+DfSphSolver3::DfSphSolver3() {
+}
+
+DfSphSolver3::DfSphSolver3(
+    double targetDensity,
+    double targetSpacing,
+    double relativeKernelRadius)
+: SphSolver3(targetDensity, targetSpacing, relativeKernelRadius) {
+}
+
+DfSphSolver3::~DfSphSolver3() {
+}
+
+double DfSphSolver3::maxDensityErrorRatio() const {
+    return _maxDensityErrorRatio;
+}
+
+void DfSphSolver3::setMaxDensityErrorRatio(double ratio) {
+    _maxDensityErrorRatio = std::max(ratio, 0.0);
+}
+
+double DfSphSolver3::maxDivergenceErrorRatio() const {
+    return _maxDivergenceErrorRatio;
+}
+
+void DfSphSolver3::setMaxDivergenceErrorRatio(double ratio) {
+    _maxDivergenceErrorRatio = std::max(ratio, 0.0);
+}
+
+unsigned int DfSphSolver3::maxNumberOfIterations() const {
+    return _maxNumberOfIterations;
+}
+
+void DfSphSolver3::setMaxNumberOfIterations(unsigned int n) {
+    _maxNumberOfIterations = n;
+}
+
+double DfSphSolver3::maxCfl() const {
+    return _maxCfl;
+}
+
+void DfSphSolver3::setMaxCfl(double newCfl) {
+    _maxCfl = std::max(newCfl, kEpsilonD);
+}
+
+unsigned int DfSphSolver3::numberOfSubTimeSteps(
+    double timeIntervalInSeconds) const {
+    auto particles = sphSystemData();
+    size_t numberOfParticles = particles->numberOfParticles();
+    auto v = particles->velocities();
+    auto f = particles->forces();
+
+    const double mass = particles->mass();
+
+    const double maxSpeed = parallelReduce(
+        kZeroSize, numberOfParticles, 0.0,
+        [&](size_t iBegin, size_t iEnd, double init) {
+            double result = init;
+            for (size_t i = iBegin; i < iEnd; ++i) {
+                result = std::max(result, v[i].length());
+            }
+            return result;
+        },
+        [](double a, double b) { return std::max(a, b); },
+        ExecutionPolicy::kParallel, ReductionMode::kDeterministic);
+
+    const double maxForceMagnitude = parallelReduce(
+        kZeroSize, numberOfParticles, 0.0,
+        [&](size_t iBegin, size_t iEnd, double init) {
+            double result = init;
+            for (size_t i = iBegin; i < iEnd; ++i) {
+                result = std::max(result, f[i].length());
+            }
+            return result;
+        },
+        [](double a, double b) { return std::max(a, b); },
+        ExecutionPolicy::kParallel, ReductionMode::kDeterministic);
+
+    // Largest time step that satisfies v * dt + a * dt^2 <= maxDisplacement
+    const double maxDisplacement = _maxCfl * particles->targetSpacing();
+    const double maxAcceleration = maxForceMagnitude / mass;
+    const double denom
+        = maxSpeed
+        + std::sqrt(square(maxSpeed) + 4.0 * maxAcceleration * maxDisplacement);
+
+    if (denom <= 0.0) {
+        return 1;
+    }
+
+    const double desiredTimeStep = 2.0 * maxDisplacement / denom;
+
+    return static_cast<unsigned int>(std::max(
+        std::ceil(timeIntervalInSeconds / desiredTimeStep), 1.0));
+}
+
+void DfSphSolver3::accumulatePressureForce(double timeIntervalInSeconds) {
+    auto particles = sphSystemData();
+    const size_t numberOfParticles = particles->numberOfParticles();
+    const double mass = particles->mass();
+
+    auto v = particles->velocities();
+    auto f = particles->forces();
+
+    // Predict velocity with the non-pressure forces
+    parallelFor(
+        kZeroSize,
+        numberOfParticles,
+        [&] (size_t i) {
+            _tempVelocities[i] = v[i] + timeIntervalInSeconds / mass * f[i];
+        });
+
+    correctDensityError(timeIntervalInSeconds);
+
+    // Convert the velocity correction to the pressure force
+    parallelFor(
+        kZeroSize,
+        numberOfParticles,
+        [&] (size_t i) {
+            f[i] = mass * (_tempVelocities[i] - v[i]) / timeIntervalInSeconds;
+        });
+}
+
+void DfSphSolver3::onBeginAdvanceTimeStep(double timeStepInSeconds) {
+    SphSolver3::onBeginAdvanceTimeStep(timeStepInSeconds);
+
+    // Allocate temp buffers
+    size_t numberOfParticles = particleSystemData()->numberOfParticles();
+    _alphas.resize(numberOfParticles);
+    _kappas.resize(numberOfParticles);
+    _densityErrors.resize(numberOfParticles);
+    _tempPositions.resize(numberOfParticles);
+    _tempVelocities.resize(numberOfParticles);
+
+    computeAlphas();
+
+    // Make the velocity field divergence-free with the updated neighbors
+    auto v = particleSystemData()->velocities();
+    parallelFor(
+        kZeroSize,
+        numberOfParticles,
+        [&] (size_t i) {
+            _tempVelocities[i] = v[i];
+        });
+
+    correctDivergenceError(timeStepInSeconds);
+
+    parallelFor(
+        kZeroSize,
+        numberOfParticles,
+        [&] (size_t i) {
+            v[i] = _tempVelocities[i];
+        });
+}
+
+void DfSphSolver3::computeAlphas() {
+    auto particles = sphSystemData();
+    const size_t numberOfParticles = particles->numberOfParticles();
+    const double mass = particles->mass();
+
+    auto x = particles->positions();
+    auto d = particles->densities();
+
+    const SphSpikyKernel3 kernel(particles->kernelRadius());
+
+    parallelFor(
+        kZeroSize,
+        numberOfParticles,
+        [&](size_t i) {
+            double dists[kNeighborBatchSize];
+            Vector3D dirs[kNeighborBatchSize];
+            Vector3D gradients[kNeighborBatchSize];
+
+            Vector3D sumGradients;
+            double sumSquaredGradients = 0.0;
+
+            particles->forEachNeighborBatch(
+                i, [&](const NeighborLists::IndexType* neighbors, size_t n) {
+                    for (size_t k = 0; k < n; ++k) {
+                        Vector3D r = x[neighbors[k]] - x[i];
+                        dists[k] = r.length();
+                        dirs[k] = (dists[k] > 0.0) ? r / dists[k] : r;
+                    }
+                    kernel.gradients(dists, dirs, n, gradients);
+
+                    for (size_t k = 0; k < n; ++k) {
+                        Vector3D gradient = mass * gradients[k];
+                        sumGradients += gradient;
+                        sumSquaredGradients += gradient.lengthSquared();
+                    }
+                });
+
+            double denom = sumGradients.lengthSquared() + sumSquaredGradients;
+            _alphas[i] = (denom > kAlphaDenominatorThreshold)
+                ? d[i] / denom : 0.0;
+        });
+}
+
+void DfSphSolver3::correctDivergenceError(double timeStepInSeconds) {
+    auto particles = sphSystemData();
+    const size_t numberOfParticles = particles->numberOfParticles();
+    const double targetDensity = particles->targetDensity();
+    const double invTimeStepSquared = 1.0 / square(timeStepInSeconds);
+
+    if (numberOfParticles == 0) {
+        return;
+    }
+
+    unsigned int numIter = 0;
+    double avgDensityChange = 0.0;
+
+    for (unsigned int k = 0; k < _maxNumberOfIterations; ++k) {
+        computeDensityChanges(timeStepInSeconds);
+
+        // Only the compression is corrected unless negative pressure is
+        // allowed.
+        parallelFor(
+            kZeroSize,
+            numberOfParticles,
+            [&] (size_t i) {
+                double densityError = _densityErrors[i];
+                if (densityError < 0.0) {
+                    densityError *= negativePressureScale();
+                }
+                _densityErrors[i] = densityError;
+                _kappas[i] = densityError * invTimeStepSquared * _alphas[i];
+            });
+
+        avgDensityChange = parallelReduce(
+            kZeroSize, numberOfParticles, 0.0,
+            [&](size_t iBegin, size_t iEnd, double init) {
+                double result = init;
+                for (size_t i = iBegin; i < iEnd; ++i) {
+                    result += _densityErrors[i];
+                }
+                return result;
+            },
+            std::plus<double>(),
+            ExecutionPolicy::kParallel, ReductionMode::kDeterministic)
+            / numberOfParticles;
+
+        numIter = k;
+        if (avgDensityChange / targetDensity < _maxDivergenceErrorRatio) {
+            break;
+        }
+
+        applyKappas(timeStepInSeconds);
+        numIter = k + 1;
+    }
+
+    JET_INFO << "Number of DFSPH divergence iterations: " << numIter;
+    JET_INFO << "Average density change: " << avgDensityChange;
+}
+
+void DfSphSolver3::correctDensityError(double timeStepInSeconds) {
+    auto particles = sphSystemData();
+    const size_t numberOfParticles = particles->numberOfParticles();
+    const double targetDensity = particles->targetDensity();
+    const double invTimeStepSquared = 1.0 / square(timeStepInSeconds);
+
+    auto x = particles->positions();
+    auto d = particles->densities();
+
+    if (numberOfParticles == 0) {
+        return;
+    }
+
+    unsigned int numIter = 0;
+    double maxDensityError = 0.0;
+
+    for (unsigned int k = 0; k < _maxNumberOfIterations; ++k) {
+        // Resolve collisions of the predicted state as PCISPH does, so that
+        // the particles stopped by the collider are not predicted to move
+        // away from the ones pushing into them
+        parallelFor(
+            kZeroSize,
+            numberOfParticles,
+            [&] (size_t i) {
+                _tempPositions[i]
+                    = x[i] + timeStepInSeconds * _tempVelocities[i];
+            });
+        resolveCollision(_tempPositions, _tempVelocities);
+
+        computeDensityChanges(timeStepInSeconds);
+
+        // Predicted density error
+        parallelFor(
+            kZeroSize,
+            numberOfParticles,
+            [&] (size_t i) {
+                double densityError
+                    = d[i] + _densityErrors[i] - targetDensity;
+                if (densityError < 0.0) {
+                    densityError *= negativePressureScale();
+                }
+                _densityErrors[i] = densityError;
+                _kappas[i] = densityError * invTimeStepSquared * _alphas[i];
+            });
+
+        // Converge on the worst particle like PCISPH so that a compressed
+        // layer cannot hide behind the uncompressed bulk
+        maxDensityError = parallelReduce(
+            kZeroSize, numberOfParticles, 0.0,
+            [&](size_t iBegin, size_t iEnd, double init) {
+                double result = init;
+                for (size_t i = iBegin; i < iEnd; ++i) {
+                    result = absmax(result, _densityErrors[i]);
+                }
+                return result;
+            },
+            [](double a, double b) { return absmax(a, b); },
+            ExecutionPolicy::kParallel, ReductionMode::kDeterministic);
+
+        numIter = k;
+        if (std::fabs(maxDensityError) / targetDensity
+            < _maxDensityErrorRatio) {
+            break;
+        }
+
+        applyKappas(timeStepInSeconds);
+        numIter = k + 1;
+    }
+
+    JET_INFO << "Number of DFSPH density iterations: " << numIter;
+    JET_INFO << "Max density error: " << maxDensityError;
+    if (std::fabs(maxDensityError) / targetDensity > _maxDensityErrorRatio) {
+        JET_WARN << "Max density error ratio is greater than the threshold!";
+        JET_WARN << "Ratio: " << std::fabs(maxDensityError) / targetDensity
+                 << " Threshold: " << _maxDensityErrorRatio;
+    }
+}
+
+void DfSphSolver3::computeDensityChanges(double timeStepInSeconds) {
+    auto particles = sphSystemData();
+    const size_t numberOfParticles = particles->numberOfParticles();
+    const double mass = particles->mass();
+
+    auto x = particles->positions();
+
+    const SphSpikyKernel3 kernel(particles->kernelRadius());
+
+    parallelFor(
+        kZeroSize,
+        numberOfParticles,
+        [&](size_t i) {
+            double dists[kNeighborBatchSize];
+            Vector3D dirs[kNeighborBatchSize];
+            Vector3D gradients[kNeighborBatchSize];
+
+            double densityRate = 0.0;
+
+            particles->forEachNeighborBatch(
+                i, [&](const NeighborLists::IndexType* neighbors, size_t n) {
+                    for (size_t k = 0; k < n; ++k) {
+                        Vector3D r = x[neighbors[k]] - x[i];
+                        dists[k] = r.length();
+                        dirs[k] = (dists[k] > 0.0) ? r / dists[k] : r;
+                    }
+                    kernel.gradients(dists, dirs, n, gradients);
+
+                    for (size_t k = 0; k < n; ++k) {
+                        size_t j = neighbors[k];
+                        densityRate += mass
+                            * (_tempVelocities[i] - _tempVelocities[j])
+                                .dot(gradients[k]);
+                    }
+                });
+
+            _densityErrors[i] = timeStepInSeconds * densityRate;
+        });
+}
+
+void DfSphSolver3::applyKappas(double timeStepInSeconds) {
+    auto particles = sphSystemData();
+    const size_t numberOfParticles = particles->numberOfParticles();
+    const double mass = particles->mass();
+
+    auto x = particles->positions();
+    auto d = particles->densities();
+
+    const SphSpikyKernel3 kernel(particles->kernelRadius());
+
+    parallelFor(
+        kZeroSize,
+        numberOfParticles,
+        [&](size_t i) {
+            double dists[kNeighborBatchSize];
+            Vector3D dirs[kNeighborBatchSize];
+            Vector3D gradients[kNeighborBatchSize];
+
+            const double ki = _kappas[i] / d[i];
+            Vector3D dv;
+
+            particles->forEachNeighborBatch(
+                i, [&](const NeighborLists::IndexType* neighbors, size_t n) {
+                    for (size_t k = 0; k < n; ++k) {
+                        Vector3D r = x[neighbors[k]] - x[i];
+                        dists[k] = r.length();
+                        dirs[k] = (dists[k] > 0.0) ? r / dists[k] : r;
+                    }
+                    kernel.gradients(dists, dirs, n, gradients);
+
+                    for (size_t k = 0; k < n; ++k) {
+                        size_t j = neighbors[k];
+                        dv -= mass * (ki + _kappas[j] / d[j]) * gradients[k];
+                    }
+                });
+
+            _tempVelocities[i] += timeStepInSeconds * dv;
+        });
+}
+
+DfSphSolver3::Builder DfSphSolver3::builder() {
+    return Builder();
+}
+
+DfSphSolver3 DfSphSolver3::Builder::build() const {
+    return DfSphSolver3(
+        _targetDensity,
+        _targetSpacing,
+        _relativeKernelRadius);
+}
+
+DfSphSolver3Ptr DfSphSolver3::Builder::makeShared() const {
+    return std::shared_ptr<DfSphSolver3>(
+        new DfSphSolver3(
+            _targetDensity,
+            _targetSpacing,
+            _relativeKernelRadius),
+        [] (DfSphSolver3* obj) {
+            delete obj;
+        });
+}
@@ -333,13 +333,28 @@ void FaceCenteredGrid3::parallelForEachWIndex(
 }
 
 Vector3D FaceCenteredGrid3::sample(const Vector3D& x) const {
-    return _sampler(x);
+    return Vector3D(_uLinearSampler(x), _vLinearSampler(x), _wLinearSampler(x));
 }
 
 std::function<Vector3D(const Vector3D&)> FaceCenteredGrid3::sampler() const {
     return _sampler;
 }
 
+const LinearArraySampler3<double, double>&
+FaceCenteredGrid3::uLinearSampler() const {
+    return _uLinearSampler;
+}
+
+const LinearArraySampler3<double, double>&
+FaceCenteredGrid3::vLinearSampler() const {
+    return _vLinearSampler;
+}
+
+const LinearArraySampler3<double, double>&
+FaceCenteredGrid3::wLinearSampler() const {
+    return _wLinearSampler;
+}
+
 double FaceCenteredGrid3::divergence(const Vector3D& x) const {
     Size3 res = resolution();
     ssize_t i, j, k;
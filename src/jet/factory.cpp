@@ -22,6 +22,7 @@
 #include <jet/point_parallel_hash_grid_searcher3.h>
 #include <jet/point_simple_list_searcher2.h>
 #include <jet/point_simple_list_searcher3.h>
+#include <jet/point_sparse_hash_grid_searcher3.h>
 #include <jet/vertex_centered_scalar_grid2.h>
 #include <jet/vertex_centered_scalar_grid3.h>
 #include <jet/vertex_centered_vector_grid2.h>
@@ -95,6 +96,7 @@ class Registry {
             PointParallelHashGridSearcher3)
         REGISTER_POINT_NEIGHBOR_SEARCHER3_BUILDER(PointSimpleListSearcher3)
         REGISTER_POINT_NEIGHBOR_SEARCHER3_BUILDER(PointKdTreeSearcher3)
+        REGISTER_POINT_NEIGHBOR_SEARCHER3_BUILDER(PointSparseHashGridSearcher3)
     }
 };
 
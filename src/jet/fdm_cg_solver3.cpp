@@ -39,8 +39,9 @@ bool FdmCgSolver3::solve(FdmLinearSystem3* system) {
     _q.set(0.0);
     _s.set(0.0);
 
-    cg<FdmBlas3>(matrix, rhs, _maxNumberOfIterations, _tolerance, &solution,
-                 &_r, &_d, &_q, &_s, &_lastNumberOfIterations, &_lastResidual);
+    cgFused<FdmBlas3>(matrix, rhs, _maxNumberOfIterations, _tolerance,
+                      &solution, &_r, &_d, &_q, &_s, &_lastNumberOfIterations,
+                      &_lastResidual);
 
     return _lastResidual <= _tolerance ||
            _lastNumberOfIterations < _maxNumberOfIterations;
@@ -65,9 +66,40 @@ bool FdmCgSolver3::solveCompressed(FdmCompressedLinearSystem3* system) {
     _qComp.set(0.0);
     _sComp.set(0.0);
 
-    cg<FdmCompressedBlas3>(matrix, rhs, _maxNumberOfIterations, _tolerance,
-                           &solution, &_rComp, &_dComp, &_qComp, &_sComp,
-                           &_lastNumberOfIterations, &_lastResidual);
+    cgFused<FdmCompressedBlas3>(matrix, rhs, _maxNumberOfIterations,
+                                _tolerance, &solution, &_rComp, &_dComp,
+                                &_qComp, &_sComp, &_lastNumberOfIterations,
+                                &_lastResidual);
+
+    return _lastResidual <= _tolerance ||
+           _lastNumberOfIterations < _maxNumberOfIterations;
+}
+
+bool FdmCgSolver3::solveMatrixFree(FdmMatrixFreeLinearSystem3* system) {
+    FdmMatrixFree3& matrix = system->A;
+    FdmVector3& solution = system->x;
+    FdmVector3& rhs = system->b;
+
+    JET_ASSERT(matrix.size() == rhs.size());
+    JET_ASSERT(matrix.size() == solution.size());
+
+    clearCompressedVectors();
+
+    Size3 size = matrix.size();
+    _r.resize(size);
+    _d.resize(size);
+    _q.resize(size);
+    _s.resize(size);
+
+    system->x.set(0.0);
+    _r.set(0.0);
+    _d.set(0.0);
+    _q.set(0.0);
+    _s.set(0.0);
+
+    cgFused<FdmMatrixFreeBlas3>(matrix, rhs, _maxNumberOfIterations,
+                                _tolerance, &solution, &_r, &_d, &_q, &_s,
+                                &_lastNumberOfIterations, &_lastResidual);
 
     return _lastResidual <= _tolerance ||
            _lastNumberOfIterations < _maxNumberOfIterations;
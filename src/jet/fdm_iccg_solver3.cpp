@@ -11,20 +11,40 @@
 
 using namespace jet;
 
-void FdmIccgSolver3::Preconditioner::build(const FdmMatrix3& matrix) {
+namespace {
+
+inline const FdmMatrixRow3& matrixRow(const FdmMatrix3& matrix, size_t i,
+                                      size_t j, size_t k) {
+    return matrix(i, j, k);
+}
+
+inline FdmMatrixRow3 matrixRow(const FdmMatrixFree3& matrix, size_t i,
+                               size_t j, size_t k) {
+    return matrix.row(i, j, k);
+}
+
+}  // namespace
+
+template <typename BlasType>
+void FdmIccgSolver3::Preconditioner<BlasType>::build(
+    const typename BlasType::MatrixType& matrix) {
     Size3 size = matrix.size();
-    A = matrix.constAccessor();
+    A = &matrix;
 
     d.resize(size, 0.0);
     y.resize(size, 0.0);
 
-    matrix.forEachIndex([&](size_t i, size_t j, size_t k) {
+    d.forEachIndex([&](size_t i, size_t j, size_t k) {
         double denom =
-            matrix(i, j, k).center -
-            ((i > 0) ? square(matrix(i - 1, j, k).right) * d(i - 1, j, k)
+            matrixRow(matrix, i, j, k).center -
+            ((i > 0) ? square(matrixRow(matrix, i - 1, j, k).right) *
+                           d(i - 1, j, k)
+                     : 0.0) -
+            ((j > 0) ? square(matrixRow(matrix, i, j - 1, k).up) *
+                           d(i, j - 1, k)
                      : 0.0) -
-            ((j > 0) ? square(matrix(i, j - 1, k).up) * d(i, j - 1, k) : 0.0) -
-            ((k > 0) ? square(matrix(i, j, k - 1).front) * d(i, j, k - 1)
+            ((k > 0) ? square(matrixRow(matrix, i, j, k - 1).front) *
+                           d(i, j, k - 1)
                      : 0.0);
 
         if (std::fabs(denom) > 0.0) {
@@ -35,30 +55,35 @@ void FdmIccgSolver3::Preconditioner::build(const FdmMatrix3& matrix) {
     });
 }
 
-void FdmIccgSolver3::Preconditioner::solve(const FdmVector3& b, FdmVector3* x) {
+template <typename BlasType>
+void FdmIccgSolver3::Preconditioner<BlasType>::solve(const FdmVector3& b,
+                                                     FdmVector3* x) {
     Size3 size = b.size();
     ssize_t sx = static_cast<ssize_t>(size.x);
     ssize_t sy = static_cast<ssize_t>(size.y);
     ssize_t sz = static_cast<ssize_t>(size.z);
 
     b.forEachIndex([&](size_t i, size_t j, size_t k) {
-        y(i, j, k) = (b(i, j, k) -
-                      ((i > 0) ? A(i - 1, j, k).right * y(i - 1, j, k) : 0.0) -
-                      ((j > 0) ? A(i, j - 1, k).up * y(i, j - 1, k) : 0.0) -
-                      ((k > 0) ? A(i, j, k - 1).front * y(i, j, k - 1) : 0.0)) *
-                     d(i, j, k);
+        y(i, j, k) =
+            (b(i, j, k) -
+             ((i > 0) ? matrixRow(*A, i - 1, j, k).right * y(i - 1, j, k)
+                      : 0.0) -
+             ((j > 0) ? matrixRow(*A, i, j - 1, k).up * y(i, j - 1, k)
+                      : 0.0) -
+             ((k > 0) ? matrixRow(*A, i, j, k - 1).front * y(i, j, k - 1)
+                      : 0.0)) *
+            d(i, j, k);
     });
 
     for (ssize_t k = sz - 1; k >= 0; --k) {
         for (ssize_t j = sy - 1; j >= 0; --j) {
             for (ssize_t i = sx - 1; i >= 0; --i) {
+                const FdmMatrixRow3 row = matrixRow(*A, i, j, k);
                 (*x)(i, j, k) =
                     (y(i, j, k) -
-                     ((i + 1 < sx) ? A(i, j, k).right * (*x)(i + 1, j, k)
-                                   : 0.0) -
-                     ((j + 1 < sy) ? A(i, j, k).up * (*x)(i, j + 1, k) : 0.0) -
-                     ((k + 1 < sz) ? A(i, j, k).front * (*x)(i, j, k + 1)
-                                   : 0.0)) *
+                     ((i + 1 < sx) ? row.right * (*x)(i + 1, j, k) : 0.0) -
+                     ((j + 1 < sy) ? row.up * (*x)(i, j + 1, k) : 0.0) -
+                     ((k + 1 < sz) ? row.front * (*x)(i, j, k + 1) : 0.0)) *
                     d(i, j, k);
             }
         }
@@ -175,7 +200,7 @@ bool FdmIccgSolver3::solve(FdmLinearSystem3* system) {
 
     _precond.build(matrix);
 
-    pcg<FdmBlas3, Preconditioner>(
+    pcg<FdmBlas3, Preconditioner<FdmBlas3>>(
         matrix, rhs, _maxNumberOfIterations, _tolerance, &_precond, &solution,
         &_r, &_d, &_q, &_s, &_lastNumberOfIterations, &_lastResidualNorm);
 
@@ -219,6 +244,42 @@ bool FdmIccgSolver3::solveCompressed(FdmCompressedLinearSystem3* system) {
            _lastNumberOfIterations < _maxNumberOfIterations;
 }
 
+bool FdmIccgSolver3::solveMatrixFree(FdmMatrixFreeLinearSystem3* system) {
+    FdmMatrixFree3& matrix = system->A;
+    FdmVector3& solution = system->x;
+    FdmVector3& rhs = system->b;
+
+    JET_ASSERT(matrix.size() == rhs.size());
+    JET_ASSERT(matrix.size() == solution.size());
+
+    clearCompressedVectors();
+
+    Size3 size = matrix.size();
+    _r.resize(size);
+    _d.resize(size);
+    _q.resize(size);
+    _s.resize(size);
+
+    system->x.set(0.0);
+    _r.set(0.0);
+    _d.set(0.0);
+    _q.set(0.0);
+    _s.set(0.0);
+
+    _precondMatrixFree.build(matrix);
+
+    pcg<FdmMatrixFreeBlas3, Preconditioner<FdmMatrixFreeBlas3>>(
+        matrix, rhs, _maxNumberOfIterations, _tolerance, &_precondMatrixFree,
+        &solution, &_r, &_d, &_q, &_s, &_lastNumberOfIterations,
+        &_lastResidualNorm);
+
+    JET_INFO << "Residual norm after solving ICCG: " << _lastResidualNorm
+             << " Number of ICCG iterations: " << _lastNumberOfIterations;
+
+    return _lastResidualNorm <= _tolerance ||
+           _lastNumberOfIterations < _maxNumberOfIterations;
+}
+
 unsigned int FdmIccgSolver3::maxNumberOfIterations() const {
     return _maxNumberOfIterations;
 }
@@ -51,15 +51,19 @@ double FdmBlas2::dot(const FdmVector2& a, const FdmVector2& b) {
 
     JET_THROW_INVALID_ARG_IF(size != b.size());
 
-    double result = 0.0;
-
-    for (size_t j = 0; j < size.y; ++j) {
-        for (size_t i = 0; i < size.x; ++i) {
-            result += a(i, j) * b(i, j);
-        }
-    }
-
-    return result;
+    return parallelReduce(
+        kZeroSize, size.y, 0.0,
+        [&](size_t jBegin, size_t jEnd, double init) {
+            double result = init;
+            for (size_t j = jBegin; j < jEnd; ++j) {
+                for (size_t i = 0; i < size.x; ++i) {
+                    result += a(i, j) * b(i, j);
+                }
+            }
+            return result;
+        },
+        std::plus<double>(), ExecutionPolicy::kParallel,
+        ReductionMode::kDeterministic);
 }
 
 void FdmBlas2::axpy(double a, const FdmVector2& x, const FdmVector2& y,
@@ -113,15 +117,21 @@ double FdmBlas2::l2Norm(const FdmVector2& v) { return std::sqrt(dot(v, v)); }
 double FdmBlas2::lInfNorm(const FdmVector2& v) {
     Size2 size = v.size();
 
-    double result = 0.0;
-
-    for (size_t j = 0; j < size.y; ++j) {
-        for (size_t i = 0; i < size.x; ++i) {
-            result = absmax(result, v(i, j));
-        }
-    }
-
-    return std::fabs(result);
+    double maxValue = parallelReduce(
+        kZeroSize, size.y, 0.0,
+        [&](size_t jBegin, size_t jEnd, double init) {
+            double result = init;
+            for (size_t j = jBegin; j < jEnd; ++j) {
+                for (size_t i = 0; i < size.x; ++i) {
+                    result = absmax(result, v(i, j));
+                }
+            }
+            return result;
+        },
+        [](double a, double b) { return absmax(a, b); },
+        ExecutionPolicy::kParallel, ReductionMode::kDeterministic);
+
+    return std::fabs(maxValue);
 }
 
 //
@@ -12,6 +12,143 @@
 
 using namespace jet;
 
+namespace {
+
+// Matrix-free stencil applied to x-lines of the grid. The coefficients are
+// looked up from tables indexed by the flags, so the inner loop has no
+// branches. The neighbor lines outside of the grid read zero flags, so they
+// never couple with the center line.
+class MatrixFreeStencil {
+ public:
+    explicit MatrixFreeStencil(const FdmMatrixFree3& m)
+        : _m(m), _closed(m.size().x, 0) {
+        // Diagonal, activity, and the couplings toward the right, up, and
+        // front neighbors (before checking the neighbor's activity)
+        for (unsigned int f = 0; f < kNumFlags; ++f) {
+            const bool isActive = (f & FdmMatrixFree3::kActive) != 0;
+            auto count = [f](uint8_t lower, uint8_t upper) {
+                return ((f & lower) ? 1.0 : 0.0) + ((f & upper) ? 1.0 : 0.0);
+            };
+
+            _center[f] = isActive
+                ? m.invHSqr.x * count(FdmMatrixFree3::kOpenLeft,
+                                      FdmMatrixFree3::kOpenRight) +
+                  m.invHSqr.y * count(FdmMatrixFree3::kOpenDown,
+                                      FdmMatrixFree3::kOpenUp) +
+                  m.invHSqr.z * count(FdmMatrixFree3::kOpenBack,
+                                      FdmMatrixFree3::kOpenFront)
+                : 1.0;
+            _active[f] = isActive ? 1.0 : 0.0;
+            _right[f] = (isActive && (f & FdmMatrixFree3::kOpenRight))
+                ? m.invHSqr.x : 0.0;
+            _up[f] = (isActive && (f & FdmMatrixFree3::kOpenUp))
+                ? m.invHSqr.y : 0.0;
+            _front[f] = (isActive && (f & FdmMatrixFree3::kOpenFront))
+                ? m.invHSqr.z : 0.0;
+        }
+    }
+
+    // Stores A * x of the x-line (j, k) to r.
+    void apply(const FdmVector3& x, size_t j, size_t k, double* r) const {
+        const Size3 size = _m.size();
+        const bool hasDown = j > 0;
+        const bool hasUp = j + 1 < size.y;
+        const bool hasBack = k > 0;
+        const bool hasFront = k + 1 < size.z;
+
+        const uint8_t* f = &_m.flags(0, j, k);
+        const uint8_t* fd = hasDown ? &_m.flags(0, j - 1, k) : _closed.data();
+        const uint8_t* fu = hasUp ? &_m.flags(0, j + 1, k) : _closed.data();
+        const uint8_t* fb = hasBack ? &_m.flags(0, j, k - 1) : _closed.data();
+        const uint8_t* ff = hasFront ? &_m.flags(0, j, k + 1) : _closed.data();
+        const double* xc = &x(0, j, k);
+        const double* xd = hasDown ? &x(0, j - 1, k) : xc;
+        const double* xu = hasUp ? &x(0, j + 1, k) : xc;
+        const double* xb = hasBack ? &x(0, j, k - 1) : xc;
+        const double* xf = hasFront ? &x(0, j, k + 1) : xc;
+
+        // The couplings are decided by the lower-index cells, so the matrix
+        // stays symmetric.
+        auto stencil = [&](size_t i, uint8_t fl, double xl, uint8_t fr,
+                           double xr) {
+            const uint8_t fi = f[i];
+            return _center[fi] * xc[i] -
+                   _active[fi] * (_right[fl] * xl + _up[fd[i]] * xd[i] +
+                                  _front[fb[i]] * xb[i]) -
+                   (_right[fi] * _active[fr] * xr +
+                    _up[fi] * _active[fu[i]] * xu[i] +
+                    _front[fi] * _active[ff[i]] * xf[i]);
+        };
+
+        const size_t n = size.x;
+        if (n == 1) {
+            r[0] = stencil(0, 0, 0.0, 0, 0.0);
+        } else {
+            r[0] = stencil(0, 0, 0.0, f[1], xc[1]);
+            for (size_t i = 1; i + 1 < n; ++i) {
+                r[i] = stencil(i, f[i - 1], xc[i - 1], f[i + 1], xc[i + 1]);
+            }
+            r[n - 1] = stencil(n - 1, f[n - 2], xc[n - 2], 0, 0.0);
+        }
+    }
+
+ private:
+    static const unsigned int kNumFlags = 256;
+
+    const FdmMatrixFree3& _m;
+    std::vector<uint8_t> _closed;
+    double _center[kNumFlags];
+    double _active[kNumFlags];
+    double _right[kNumFlags];
+    double _up[kNumFlags];
+    double _front[kNumFlags];
+};
+
+// Applies the matrix-free matrix to x. If b is not null, stores b - Ax
+// instead of Ax.
+void applyMatrixFree(const FdmMatrixFree3& m, const FdmVector3& x,
+                     const FdmVector3* b, FdmVector3* result) {
+    const Size3 size = m.size();
+
+    JET_THROW_INVALID_ARG_IF(size != x.size());
+    JET_THROW_INVALID_ARG_IF(b != nullptr && size != b->size());
+    JET_THROW_INVALID_ARG_IF(size != result->size());
+
+    if (size.x == 0 || size.y == 0 || size.z == 0) {
+        return;
+    }
+
+    const MatrixFreeStencil stencil(m);
+
+    parallelFor(kZeroSize, size.y, kZeroSize, size.z, [&](size_t j, size_t k) {
+        double* r = &(*result)(0, j, k);
+        stencil.apply(x, j, k, r);
+
+        if (b != nullptr) {
+            const double* bc = &(*b)(0, j, k);
+            for (size_t i = 0; i < size.x; ++i) {
+                r[i] = bc[i] - r[i];
+            }
+        }
+    });
+}
+
+// Performs p = r + beta * p, s = w + beta * s, x = x + alpha * p and
+// r = r - alpha * s in a single sweep.
+void fusedCgUpdate(size_t n, double alpha, double beta, const double* w,
+                   double* r, double* p, double* s, double* x) {
+    parallelFor(kZeroSize, n, [&](size_t i) {
+        const double pi = r[i] + beta * p[i];
+        const double si = w[i] + beta * s[i];
+        p[i] = pi;
+        s[i] = si;
+        x[i] += alpha * pi;
+        r[i] -= alpha * si;
+    });
+}
+
+}  // namespace
+
 void FdmLinearSystem3::clear() {
     A.clear();
     x.clear();
@@ -26,6 +163,73 @@ void FdmLinearSystem3::resize(const Size3& size) {
 
 //
 
+const uint8_t FdmMatrixFree3::kActive;
+const uint8_t FdmMatrixFree3::kOpenLeft;
+const uint8_t FdmMatrixFree3::kOpenRight;
+const uint8_t FdmMatrixFree3::kOpenDown;
+const uint8_t FdmMatrixFree3::kOpenUp;
+const uint8_t FdmMatrixFree3::kOpenBack;
+const uint8_t FdmMatrixFree3::kOpenFront;
+
+Size3 FdmMatrixFree3::size() const { return flags.size(); }
+
+void FdmMatrixFree3::clear() { flags.clear(); }
+
+void FdmMatrixFree3::resize(const Size3& size) { flags.resize(size); }
+
+FdmMatrixRow3 FdmMatrixFree3::row(size_t i, size_t j, size_t k) const {
+    const Size3 n = flags.size();
+    const uint8_t f = flags(i, j, k);
+
+    FdmMatrixRow3 result;
+    if (!(f & kActive)) {
+        result.center = 1.0;
+        return result;
+    }
+
+    result.center = invHSqr.x * (((f & kOpenLeft) ? 1 : 0) +
+                                 ((f & kOpenRight) ? 1 : 0)) +
+                    invHSqr.y * (((f & kOpenDown) ? 1 : 0) +
+                                 ((f & kOpenUp) ? 1 : 0)) +
+                    invHSqr.z * (((f & kOpenBack) ? 1 : 0) +
+                                 ((f & kOpenFront) ? 1 : 0));
+
+    if ((f & kOpenRight) && i + 1 < n.x && (flags(i + 1, j, k) & kActive)) {
+        result.right = -invHSqr.x;
+    }
+    if ((f & kOpenUp) && j + 1 < n.y && (flags(i, j + 1, k) & kActive)) {
+        result.up = -invHSqr.y;
+    }
+    if ((f & kOpenFront) && k + 1 < n.z && (flags(i, j, k + 1) & kActive)) {
+        result.front = -invHSqr.z;
+    }
+
+    return result;
+}
+
+void FdmMatrixFree3::toMatrix(FdmMatrix3* result) const {
+    result->resize(flags.size());
+    result->parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        (*result)(i, j, k) = row(i, j, k);
+    });
+}
+
+//
+
+void FdmMatrixFreeLinearSystem3::clear() {
+    A.clear();
+    x.clear();
+    b.clear();
+}
+
+void FdmMatrixFreeLinearSystem3::resize(const Size3& size) {
+    A.resize(size);
+    x.resize(size);
+    b.resize(size);
+}
+
+//
+
 void FdmCompressedLinearSystem3::clear() {
     A.clear();
     x.clear();
@@ -51,17 +255,21 @@ double FdmBlas3::dot(const FdmVector3& a, const FdmVector3& b) {
 
     JET_THROW_INVALID_ARG_IF(size != b.size());
 
-    double result = 0.0;
-
-    for (size_t k = 0; k < size.z; ++k) {
-        for (size_t j = 0; j < size.y; ++j) {
-            for (size_t i = 0; i < size.x; ++i) {
-                result += a(i, j, k) * b(i, j, k);
+    return parallelReduce(
+        kZeroSize, size.z, 0.0,
+        [&](size_t kBegin, size_t kEnd, double init) {
+            double result = init;
+            for (size_t k = kBegin; k < kEnd; ++k) {
+                for (size_t j = 0; j < size.y; ++j) {
+                    for (size_t i = 0; i < size.x; ++i) {
+                        result += a(i, j, k) * b(i, j, k);
+                    }
+                }
             }
-        }
-    }
-
-    return result;
+            return result;
+        },
+        std::plus<double>(), ExecutionPolicy::kParallel,
+        ReductionMode::kDeterministic);
 }
 
 void FdmBlas3::axpy(double a, const FdmVector3& x, const FdmVector3& y,
@@ -95,6 +303,96 @@ void FdmBlas3::mvm(const FdmMatrix3& m, const FdmVector3& v,
     });
 }
 
+void FdmBlas3::mvm(const FdmMatrixFree3& m, const FdmVector3& v,
+                   FdmVector3* result) {
+    applyMatrixFree(m, v, nullptr, result);
+}
+
+void FdmBlas3::mvmDot(const FdmMatrix3& m, const FdmVector3& v,
+                      FdmVector3* result, double* vDotV, double* vDotResult) {
+    Size3 size = m.size();
+
+    JET_THROW_INVALID_ARG_IF(size != v.size());
+    JET_THROW_INVALID_ARG_IF(size != result->size());
+
+    const Vector2D dots = parallelReduce(
+        kZeroSize, size.z, Vector2D(),
+        [&](size_t kBegin, size_t kEnd, Vector2D init) {
+            Vector2D sum = init;
+            for (size_t k = kBegin; k < kEnd; ++k) {
+                for (size_t j = 0; j < size.y; ++j) {
+                    for (size_t i = 0; i < size.x; ++i) {
+                        const double mv =
+                            m(i, j, k).center * v(i, j, k) +
+                            ((i > 0) ? m(i - 1, j, k).right * v(i - 1, j, k)
+                                     : 0.0) +
+                            ((i + 1 < size.x)
+                                 ? m(i, j, k).right * v(i + 1, j, k)
+                                 : 0.0) +
+                            ((j > 0) ? m(i, j - 1, k).up * v(i, j - 1, k)
+                                     : 0.0) +
+                            ((j + 1 < size.y) ? m(i, j, k).up * v(i, j + 1, k)
+                                              : 0.0) +
+                            ((k > 0) ? m(i, j, k - 1).front * v(i, j, k - 1)
+                                     : 0.0) +
+                            ((k + 1 < size.z)
+                                 ? m(i, j, k).front * v(i, j, k + 1)
+                                 : 0.0);
+                        (*result)(i, j, k) = mv;
+                        sum.x += v(i, j, k) * v(i, j, k);
+                        sum.y += v(i, j, k) * mv;
+                    }
+                }
+            }
+            return sum;
+        },
+        std::plus<Vector2D>(), ExecutionPolicy::kParallel,
+        ReductionMode::kDeterministic);
+
+    *vDotV = dots.x;
+    *vDotResult = dots.y;
+}
+
+void FdmBlas3::mvmDot(const FdmMatrixFree3& m, const FdmVector3& v,
+                      FdmVector3* result, double* vDotV, double* vDotResult) {
+    Size3 size = m.size();
+
+    JET_THROW_INVALID_ARG_IF(size != v.size());
+    JET_THROW_INVALID_ARG_IF(size != result->size());
+
+    *vDotV = 0.0;
+    *vDotResult = 0.0;
+    if (size.x == 0 || size.y == 0 || size.z == 0) {
+        return;
+    }
+
+    const MatrixFreeStencil stencil(m);
+
+    const Vector2D dots = parallelReduce(
+        kZeroSize, size.z, Vector2D(),
+        [&](size_t kBegin, size_t kEnd, Vector2D init) {
+            Vector2D sum = init;
+            for (size_t k = kBegin; k < kEnd; ++k) {
+                for (size_t j = 0; j < size.y; ++j) {
+                    const double* vc = &v(0, j, k);
+                    double* r = &(*result)(0, j, k);
+                    stencil.apply(v, j, k, r);
+
+                    for (size_t i = 0; i < size.x; ++i) {
+                        sum.x += vc[i] * vc[i];
+                        sum.y += vc[i] * r[i];
+                    }
+                }
+            }
+            return sum;
+        },
+        std::plus<Vector2D>(), ExecutionPolicy::kParallel,
+        ReductionMode::kDeterministic);
+
+    *vDotV = dots.x;
+    *vDotResult = dots.y;
+}
+
 void FdmBlas3::residual(const FdmMatrix3& a, const FdmVector3& x,
                         const FdmVector3& b, FdmVector3* result) {
     Size3 size = a.size();
@@ -115,22 +413,97 @@ void FdmBlas3::residual(const FdmMatrix3& a, const FdmVector3& x,
     });
 }
 
+void FdmBlas3::residual(const FdmMatrixFree3& a, const FdmVector3& x,
+                        const FdmVector3& b, FdmVector3* result) {
+    applyMatrixFree(a, x, &b, result);
+}
+
+void FdmBlas3::cgUpdate(double alpha, double beta, const FdmVector3& w,
+                        FdmVector3* r, FdmVector3* p, FdmVector3* s,
+                        FdmVector3* x) {
+    Size3 size = w.size();
+
+    JET_THROW_INVALID_ARG_IF(size != r->size());
+    JET_THROW_INVALID_ARG_IF(size != p->size());
+    JET_THROW_INVALID_ARG_IF(size != s->size());
+    JET_THROW_INVALID_ARG_IF(size != x->size());
+
+    fusedCgUpdate(size.x * size.y * size.z, alpha, beta, w.data(), r->data(),
+                  p->data(), s->data(), x->data());
+}
+
 double FdmBlas3::l2Norm(const FdmVector3& v) { return std::sqrt(dot(v, v)); }
 
 double FdmBlas3::lInfNorm(const FdmVector3& v) {
     Size3 size = v.size();
 
-    double result = 0.0;
-
-    for (size_t k = 0; k < size.z; ++k) {
-        for (size_t j = 0; j < size.y; ++j) {
-            for (size_t i = 0; i < size.x; ++i) {
-                result = absmax(result, v(i, j, k));
+    double maxValue = parallelReduce(
+        kZeroSize, size.z, 0.0,
+        [&](size_t kBegin, size_t kEnd, double init) {
+            double result = init;
+            for (size_t k = kBegin; k < kEnd; ++k) {
+                for (size_t j = 0; j < size.y; ++j) {
+                    for (size_t i = 0; i < size.x; ++i) {
+                        result = absmax(result, v(i, j, k));
+                    }
+                }
             }
-        }
-    }
+            return result;
+        },
+        [](double a, double b) { return absmax(a, b); },
+        ExecutionPolicy::kParallel, ReductionMode::kDeterministic);
+
+    return std::fabs(maxValue);
+}
+
+//
+
+void FdmMatrixFreeBlas3::set(double s, FdmVector3* result) {
+    FdmBlas3::set(s, result);
+}
+
+void FdmMatrixFreeBlas3::set(const FdmVector3& v, FdmVector3* result) {
+    FdmBlas3::set(v, result);
+}
+
+double FdmMatrixFreeBlas3::dot(const FdmVector3& a, const FdmVector3& b) {
+    return FdmBlas3::dot(a, b);
+}
+
+void FdmMatrixFreeBlas3::axpy(double a, const FdmVector3& x,
+                              const FdmVector3& y, FdmVector3* result) {
+    FdmBlas3::axpy(a, x, y, result);
+}
+
+void FdmMatrixFreeBlas3::mvm(const FdmMatrixFree3& m, const FdmVector3& v,
+                             FdmVector3* result) {
+    FdmBlas3::mvm(m, v, result);
+}
+
+void FdmMatrixFreeBlas3::residual(const FdmMatrixFree3& a, const FdmVector3& x,
+                                  const FdmVector3& b, FdmVector3* result) {
+    FdmBlas3::residual(a, x, b, result);
+}
+
+void FdmMatrixFreeBlas3::mvmDot(const FdmMatrixFree3& m,
+                                const FdmVector3& v, FdmVector3* result,
+                                double* vDotV, double* vDotResult) {
+    FdmBlas3::mvmDot(m, v, result, vDotV, vDotResult);
+}
 
-    return std::fabs(result);
+void FdmMatrixFreeBlas3::cgUpdate(double alpha, double beta,
+                                  const FdmVector3& w, FdmVector3* r,
+                                  FdmVector3* p, FdmVector3* s,
+                                  FdmVector3* x) {
+    FdmBlas3::cgUpdate(alpha, beta, w, r, p, s, x);
+}
+
+double FdmMatrixFreeBlas3::l2Norm(const FdmVector3& v) {
+    return FdmBlas3::l2Norm(v);
+}
+
+double FdmMatrixFreeBlas3::lInfNorm(const FdmVector3& v) {
+    return FdmBlas3::lInfNorm(v);
 }
 
 //
@@ -198,6 +571,53 @@ void FdmCompressedBlas3::residual(const MatrixCsrD& a, const VectorND& x,
     });
 }
 
+void FdmCompressedBlas3::mvmDot(const MatrixCsrD& m, const VectorND& v,
+                                VectorND* result, double* vDotV,
+                                double* vDotResult) {
+    const auto rp = m.rowPointersBegin();
+    const auto ci = m.columnIndicesBegin();
+    const auto nnz = m.nonZeroBegin();
+
+    const Vector2D dots = parallelReduce(
+        kZeroSize, v.size(), Vector2D(),
+        [&](size_t iBegin, size_t iEnd, Vector2D init) {
+            Vector2D sum = init;
+            for (size_t i = iBegin; i < iEnd; ++i) {
+                const size_t rowBegin = rp[i];
+                const size_t rowEnd = rp[i + 1];
+
+                double mv = 0.0;
+                for (size_t jj = rowBegin; jj < rowEnd; ++jj) {
+                    mv += nnz[jj] * v[ci[jj]];
+                }
+
+                (*result)[i] = mv;
+                sum.x += v[i] * v[i];
+                sum.y += v[i] * mv;
+            }
+            return sum;
+        },
+        std::plus<Vector2D>(), ExecutionPolicy::kParallel,
+        ReductionMode::kDeterministic);
+
+    *vDotV = dots.x;
+    *vDotResult = dots.y;
+}
+
+void FdmCompressedBlas3::cgUpdate(double alpha, double beta, const VectorND& w,
+                                  VectorND* r, VectorND* p, VectorND* s,
+                                  VectorND* x) {
+    const size_t size = w.size();
+
+    JET_THROW_INVALID_ARG_IF(size != r->size());
+    JET_THROW_INVALID_ARG_IF(size != p->size());
+    JET_THROW_INVALID_ARG_IF(size != s->size());
+    JET_THROW_INVALID_ARG_IF(size != x->size());
+
+    fusedCgUpdate(size, alpha, beta, w.data(), r->data(), p->data(),
+                  s->data(), x->data());
+}
+
 double FdmCompressedBlas3::l2Norm(const VectorND& v) {
     return std::sqrt(v.dot(v));
 }
@@ -0,0 +1,24 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+
+#include <jet/fdm_linear_system_solver3.h>
+
+using namespace jet;
+
+bool FdmLinearSystemSolver3::solveMatrixFree(
+    FdmMatrixFreeLinearSystem3* system) {
+    FdmLinearSystem3 expanded;
+    system->A.toMatrix(&expanded.A);
+    expanded.x.resize(system->x.size());
+    expanded.b = system->b;
+
+    const bool result = solve(&expanded);
+    system->x.swap(expanded.x);
+
+    return result;
+}
@@ -7,8 +7,12 @@
 #include <jet/flip_solver3.h>
 #include <pch.h>
 
+#include <algorithm>
+
 using namespace jet;
 
+static const size_t kTransferBlockSize = 256;
+
 FlipSolver3::FlipSolver3() : FlipSolver3({1, 1, 1}, {1, 1, 1}, {0, 0, 0}) {}
 
 FlipSolver3::FlipSolver3(const Size3& resolution, const Vector3D& gridSpacing,
@@ -79,23 +83,50 @@ void FlipSolver3::transferFromGridsToParticles() {
         _wDelta.constAccessor(), flow->gridSpacing().castTo<float>(),
         flow->wOrigin().castTo<float>());
 
-    auto sampler = [uSampler, vSampler, wSampler](const Vector3D& x) {
-        const auto xf = x.castTo<float>();
-        double u = uSampler(xf);
-        double v = vSampler(xf);
-        double w = wSampler(xf);
-        return Vector3D(u, v, w);
-    };
-
-    // Transfer delta to the particles
-    parallelFor(kZeroSize, numberOfParticles, [&](size_t i) {
-        Vector3D flipVel = velocities[i] + sampler(positions[i]);
-        if (_picBlendingFactor > 0.0) {
-            Vector3D picVel = flow->sample(positions[i]);
-            flipVel = lerp(flipVel, picVel, _picBlendingFactor);
-        }
-        velocities[i] = flipVel;
-    });
+    const auto& uPicSampler = flow->uLinearSampler();
+    const auto& vPicSampler = flow->vLinearSampler();
+    const auto& wPicSampler = flow->wLinearSampler();
+
+    // Transfer delta to the particles in fixed-size batches
+    parallelRangeFor(
+        kZeroSize, numberOfParticles, [&](size_t begin, size_t end) {
+            Vector3F xf[kTransferBlockSize];
+            float du[kTransferBlockSize];
+            float dv[kTransferBlockSize];
+            float dw[kTransferBlockSize];
+            double u[kTransferBlockSize];
+            double v[kTransferBlockSize];
+            double w[kTransferBlockSize];
+
+            for (size_t b = begin; b < end; b += kTransferBlockSize) {
+                const size_t n = std::min(kTransferBlockSize, end - b);
+                for (size_t i = 0; i < n; ++i) {
+                    xf[i] = positions[b + i].castTo<float>();
+                }
+
+                ConstArrayAccessor1<Vector3F> xfAcc(n, xf);
+                uSampler.sample(xfAcc, ArrayAccessor1<float>(n, du));
+                vSampler.sample(xfAcc, ArrayAccessor1<float>(n, dv));
+                wSampler.sample(xfAcc, ArrayAccessor1<float>(n, dw));
+
+                if (_picBlendingFactor > 0.0) {
+                    ConstArrayAccessor1<Vector3D> x(n, positions.data() + b);
+                    uPicSampler.sample(x, ArrayAccessor1<double>(n, u));
+                    vPicSampler.sample(x, ArrayAccessor1<double>(n, v));
+                    wPicSampler.sample(x, ArrayAccessor1<double>(n, w));
+                }
+
+                for (size_t i = 0; i < n; ++i) {
+                    Vector3D flipVel
+                        = velocities[b + i] + Vector3D(du[i], dv[i], dw[i]);
+                    if (_picBlendingFactor > 0.0) {
+                        Vector3D picVel(u[i], v[i], w[i]);
+                        flipVel = lerp(flipVel, picVel, _picBlendingFactor);
+                    }
+                    velocities[b + i] = flipVel;
+                }
+            }
+        });
 }
 
 FlipSolver3::Builder FlipSolver3::builder() { return Builder(); }
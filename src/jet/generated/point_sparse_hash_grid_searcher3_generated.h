@@ -0,0 +1,108 @@
+// automatically generated by the FlatBuffers compiler, do not modify
+
+
+#ifndef FLATBUFFERS_GENERATED_POINTSPARSEHASHGRIDSEARCHER3_JET_FBS_H_
+#define FLATBUFFERS_GENERATED_POINTSPARSEHASHGRIDSEARCHER3_JET_FBS_H_
+
+#include "flatbuffers/flatbuffers.h"
+
+#include "basic_types_generated.h"
+
+namespace jet {
+namespace fbs {
+
+struct PointSparseHashGridSearcher3;
+
+struct PointSparseHashGridSearcher3 FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  enum {
+    VT_GRIDSPACING = 4,
+    VT_POINTS = 6,
+    VT_SORTEDINDICES = 8
+  };
+  double gridSpacing() const {
+    return GetField<double>(VT_GRIDSPACING, 0.0);
+  }
+  const flatbuffers::Vector<const jet::fbs::Vector3D *> *points() const {
+    return GetPointer<const flatbuffers::Vector<const jet::fbs::Vector3D *> *>(VT_POINTS);
+  }
+  const flatbuffers::Vector<uint64_t> *sortedIndices() const {
+    return GetPointer<const flatbuffers::Vector<uint64_t> *>(VT_SORTEDINDICES);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<double>(verifier, VT_GRIDSPACING) &&
+           VerifyOffset(verifier, VT_POINTS) &&
+           verifier.Verify(points()) &&
+           VerifyOffset(verifier, VT_SORTEDINDICES) &&
+           verifier.Verify(sortedIndices()) &&
+           verifier.EndTable();
+  }
+};
+
+struct PointSparseHashGridSearcher3Builder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_gridSpacing(double gridSpacing) {
+    fbb_.AddElement<double>(PointSparseHashGridSearcher3::VT_GRIDSPACING, gridSpacing, 0.0);
+  }
+  void add_points(flatbuffers::Offset<flatbuffers::Vector<const jet::fbs::Vector3D *>> points) {
+    fbb_.AddOffset(PointSparseHashGridSearcher3::VT_POINTS, points);
+  }
+  void add_sortedIndices(flatbuffers::Offset<flatbuffers::Vector<uint64_t>> sortedIndices) {
+    fbb_.AddOffset(PointSparseHashGridSearcher3::VT_SORTEDINDICES, sortedIndices);
+  }
+  PointSparseHashGridSearcher3Builder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  PointSparseHashGridSearcher3Builder &operator=(const PointSparseHashGridSearcher3Builder &);
+  flatbuffers::Offset<PointSparseHashGridSearcher3> Finish() {
+    const auto end = fbb_.EndTable(start_, 3);
+    auto o = flatbuffers::Offset<PointSparseHashGridSearcher3>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<PointSparseHashGridSearcher3> CreatePointSparseHashGridSearcher3(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    double gridSpacing = 0.0,
+    flatbuffers::Offset<flatbuffers::Vector<const jet::fbs::Vector3D *>> points = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint64_t>> sortedIndices = 0) {
+  PointSparseHashGridSearcher3Builder builder_(_fbb);
+  builder_.add_gridSpacing(gridSpacing);
+  builder_.add_sortedIndices(sortedIndices);
+  builder_.add_points(points);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<PointSparseHashGridSearcher3> CreatePointSparseHashGridSearcher3Direct(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    double gridSpacing = 0.0,
+    const std::vector<const jet::fbs::Vector3D *> *points = nullptr,
+    const std::vector<uint64_t> *sortedIndices = nullptr) {
+  return jet::fbs::CreatePointSparseHashGridSearcher3(
+      _fbb,
+      gridSpacing,
+      points ? _fbb.CreateVector<const jet::fbs::Vector3D *>(*points) : 0,
+      sortedIndices ? _fbb.CreateVector<uint64_t>(*sortedIndices) : 0);
+}
+
+inline const jet::fbs::PointSparseHashGridSearcher3 *GetPointSparseHashGridSearcher3(const void *buf) {
+  return flatbuffers::GetRoot<jet::fbs::PointSparseHashGridSearcher3>(buf);
+}
+
+inline bool VerifyPointSparseHashGridSearcher3Buffer(
+    flatbuffers::Verifier &verifier) {
+  return verifier.VerifyBuffer<jet::fbs::PointSparseHashGridSearcher3>(nullptr);
+}
+
+inline void FinishPointSparseHashGridSearcher3Buffer(
+    flatbuffers::FlatBufferBuilder &fbb,
+    flatbuffers::Offset<jet::fbs::PointSparseHashGridSearcher3> root) {
+  fbb.Finish(root);
+}
+
+}  // namespace fbs
+}  // namespace jet
+
+#endif  // FLATBUFFERS_GENERATED_POINTSPARSEHASHGRIDSEARCHER3_JET_FBS_H_
@@ -19,6 +19,7 @@
 #include <jet/timer.h>
 
 #include <algorithm>
+#include <vector>
 
 using namespace jet;
 
@@ -231,7 +232,8 @@ void GridFluidSolver3::computeExternalForces(double timeIntervalInSeconds) {
 void GridFluidSolver3::computeViscosity(double timeIntervalInSeconds) {
     if (_diffusionSolver != nullptr && _viscosityCoefficient > kEpsilonD) {
         auto vel = velocity();
-        auto vel0 = std::dynamic_pointer_cast<FaceCenteredGrid3>(vel->clone());
+        auto vel0 = _grids->velocityBackBuffer();
+        _grids->copyAdvectableVectorDataToBackBuffer(_grids->velocityIndex());
 
         _diffusionSolver->solve(*vel0, _viscosityCoefficient,
                                 timeIntervalInSeconds, vel.get(),
@@ -243,7 +245,8 @@ void GridFluidSolver3::computeViscosity(double timeIntervalInSeconds) {
 void GridFluidSolver3::computePressure(double timeIntervalInSeconds) {
     if (_pressureSolver != nullptr) {
         auto vel = velocity();
-        auto vel0 = std::dynamic_pointer_cast<FaceCenteredGrid3>(vel->clone());
+        auto vel0 = _grids->velocityBackBuffer();
+        _grids->copyAdvectableVectorDataToBackBuffer(_grids->velocityIndex());
 
         _pressureSolver->solve(*vel0, timeIntervalInSeconds, vel.get(),
                                *colliderSdf(), *colliderVelocityField(),
@@ -256,13 +259,21 @@ void GridFluidSolver3::computeAdvection(double timeIntervalInSeconds) {
     auto vel = velocity();
     if (_advectionSolver != nullptr) {
         // Solve advections for custom scalar fields
+        // (all at once so that the back-tracing can be shared)
         size_t n = _grids->numberOfAdvectableScalarData();
+        std::vector<const ScalarGrid3*> scalarGrids0;
+        std::vector<ScalarGrid3*> scalarGrids;
         for (size_t i = 0; i < n; ++i) {
-            auto grid = _grids->advectableScalarDataAt(i);
-            auto grid0 = grid->clone();
-            _advectionSolver->advect(*grid0, *vel, timeIntervalInSeconds,
-                                     grid.get(), *colliderSdf());
-            extrapolateIntoCollider(grid.get());
+            _grids->copyAdvectableScalarDataToBackBuffer(i);
+            scalarGrids0.push_back(
+                _grids->advectableScalarDataBackBufferAt(i).get());
+            scalarGrids.push_back(_grids->advectableScalarDataAt(i).get());
+        }
+        _advectionSolver->advectScalars(scalarGrids0, *vel,
+                                        timeIntervalInSeconds, scalarGrids,
+                                        *colliderSdf());
+        for (auto grid : scalarGrids) {
+            extrapolateIntoCollider(grid);
         }
 
         // Solve advections for custom vector fields
@@ -275,7 +286,8 @@ void GridFluidSolver3::computeAdvection(double timeIntervalInSeconds) {
             }
 
             auto grid = _grids->advectableVectorDataAt(i);
-            auto grid0 = grid->clone();
+            auto grid0 = _grids->advectableVectorDataBackBufferAt(i);
+            _grids->copyAdvectableVectorDataToBackBuffer(i);
 
             auto collocated =
                 std::dynamic_pointer_cast<CollocatedVectorGrid3>(grid);
@@ -303,7 +315,8 @@ void GridFluidSolver3::computeAdvection(double timeIntervalInSeconds) {
         }
 
         // Solve velocity advection
-        auto vel0 = std::dynamic_pointer_cast<FaceCenteredGrid3>(vel->clone());
+        auto vel0 = _grids->velocityBackBuffer();
+        _grids->copyAdvectableVectorDataToBackBuffer(velIdx);
         _advectionSolver->advect(*vel0, *vel0, timeIntervalInSeconds, vel.get(),
                                  *colliderSdf());
         applyBoundaryCondition();
@@ -170,6 +170,53 @@ void buildSingleSystem(MatrixCsrD* A, VectorND* x, VectorND* b,
     x->resize(b->size(), 0.0);
 }
 
+void buildSingleSystem(FdmMatrixFree3* A, FdmVector3* b,
+                       const Array3<char>& markers,
+                       const FaceCenteredGrid3& input) {
+    Size3 size = input.resolution();
+    Vector3D invH = 1.0 / input.gridSpacing();
+    A->invHSqr = invH * invH;
+
+    // Build linear system
+    A->flags.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        uint8_t& flags = A->flags(i, j, k);
+
+        // initialize
+        flags = 0;
+        (*b)(i, j, k) = 0.0;
+
+        if (markers(i, j, k) == kFluid) {
+            (*b)(i, j, k) = input.divergenceAtCellCenter(i, j, k);
+
+            flags |= FdmMatrixFree3::kActive;
+        }
+
+        if (i + 1 < size.x && markers(i + 1, j, k) != kBoundary) {
+            flags |= FdmMatrixFree3::kOpenRight;
+        }
+
+        if (i > 0 && markers(i - 1, j, k) != kBoundary) {
+            flags |= FdmMatrixFree3::kOpenLeft;
+        }
+
+        if (j + 1 < size.y && markers(i, j + 1, k) != kBoundary) {
+            flags |= FdmMatrixFree3::kOpenUp;
+        }
+
+        if (j > 0 && markers(i, j - 1, k) != kBoundary) {
+            flags |= FdmMatrixFree3::kOpenDown;
+        }
+
+        if (k + 1 < size.z && markers(i, j, k + 1) != kBoundary) {
+            flags |= FdmMatrixFree3::kOpenFront;
+        }
+
+        if (k > 0 && markers(i, j, k - 1) != kBoundary) {
+            flags |= FdmMatrixFree3::kOpenBack;
+        }
+    });
+}
+
 }  // namespace
 
 GridSinglePhasePressureSolver3::GridSinglePhasePressureSolver3() {
@@ -199,6 +246,10 @@ void GridSinglePhasePressureSolver3::solve(const FaceCenteredGrid3& input,
                 _system.clear();
                 _systemSolver->solveCompressed(&_compSystem);
                 decompressSolution();
+            } else if (_isUsingMatrixFreeSystem) {
+                _compSystem.clear();
+                _systemSolver->solveMatrixFree(&_mfSystem);
+                _system.x.swap(_mfSystem.x);
             } else {
                 _compSystem.clear();
                 _systemSolver->solve(&_system);
@@ -234,6 +285,7 @@ void GridSinglePhasePressureSolver3::setLinearSystemSolver(
         // In case of mg system, use multi-level structure.
         _system.clear();
         _compSystem.clear();
+        _mfSystem.clear();
     }
 }
 
@@ -245,6 +297,14 @@ const FdmVector3& GridSinglePhasePressureSolver3::pressure() const {
     }
 }
 
+bool GridSinglePhasePressureSolver3::isUsingMatrixFreeSystem() const {
+    return _isUsingMatrixFreeSystem;
+}
+
+void GridSinglePhasePressureSolver3::setIsUsingMatrixFreeSystem(bool isUsing) {
+    _isUsingMatrixFreeSystem = isUsing;
+}
+
 void GridSinglePhasePressureSolver3::buildMarkers(
     const Size3& size,
     const std::function<Vector3D(size_t, size_t, size_t)>& pos,
@@ -346,7 +406,14 @@ void GridSinglePhasePressureSolver3::buildSystem(const FaceCenteredGrid3& input,
     size_t numLevels = 1;
 
     if (_mgSystemSolver == nullptr) {
-        if (!useCompressed) {
+        if (useCompressed) {
+            _mfSystem.clear();
+        } else if (_isUsingMatrixFreeSystem) {
+            // Only the solution is kept in the regular system
+            _system.clear();
+            _mfSystem.resize(size);
+        } else {
+            _mfSystem.clear();
             _system.resize(size);
         }
     } else {
@@ -368,6 +435,8 @@ void GridSinglePhasePressureSolver3::buildSystem(const FaceCenteredGrid3& input,
         if (useCompressed) {
             buildSingleSystem(&_compSystem.A, &_compSystem.x, &_compSystem.b,
                               _markers[0], *finer);
+        } else if (_isUsingMatrixFreeSystem) {
+            buildSingleSystem(&_mfSystem.A, &_mfSystem.b, _markers[0], *finer);
         } else {
             buildSingleSystem(&_system.A, &_system.b, _markers[0], *finer);
         }
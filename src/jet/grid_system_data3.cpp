@@ -14,7 +14,9 @@
 #include <fbs_helpers.h>
 #include <generated/grid_system_data3_generated.h>
 
+#include <jet/collocated_vector_grid3.h>
 #include <jet/grid_system_data3.h>
+#include <jet/parallel.h>
 
 #include <flatbuffers/flatbuffers.h>
 
@@ -23,6 +25,53 @@
 
 using namespace jet;
 
+template <typename T>
+static void copyData(
+    const ConstArrayAccessor3<T>& src,
+    ArrayAccessor3<T> dst) {
+    JET_ASSERT(src.size() == dst.size());
+
+    size_t n = src.width() * src.height() * src.depth();
+    parallelFor(kZeroSize, n, [&](size_t i) {
+        dst[i] = src[i];
+    });
+}
+
+static void copyGrid(const ScalarGrid3& src, ScalarGrid3* dst) {
+    if (!dst->hasSameShape(src)) {
+        dst->resize(src.resolution(), src.gridSpacing(), src.origin());
+    }
+
+    copyData(src.constDataAccessor(), dst->dataAccessor());
+}
+
+static void copyGrid(const VectorGrid3& src, VectorGrid3* dst) {
+    if (!dst->hasSameShape(src)) {
+        dst->resize(src.resolution(), src.gridSpacing(), src.origin());
+    }
+
+    auto faceCenteredSrc = dynamic_cast<const FaceCenteredGrid3*>(&src);
+    auto faceCenteredDst = dynamic_cast<FaceCenteredGrid3*>(dst);
+    if (faceCenteredSrc != nullptr && faceCenteredDst != nullptr) {
+        copyData(faceCenteredSrc->uConstAccessor(),
+                 faceCenteredDst->uAccessor());
+        copyData(faceCenteredSrc->vConstAccessor(),
+                 faceCenteredDst->vAccessor());
+        copyData(faceCenteredSrc->wConstAccessor(),
+                 faceCenteredDst->wAccessor());
+        return;
+    }
+
+    auto collocatedSrc = dynamic_cast<const CollocatedVectorGrid3*>(&src);
+    auto collocatedDst = dynamic_cast<CollocatedVectorGrid3*>(dst);
+    JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(
+        collocatedSrc == nullptr || collocatedDst == nullptr,
+        "Unknown vector grid type.");
+
+    copyData(collocatedSrc->constDataAccessor(),
+             collocatedDst->dataAccessor());
+}
+
 GridSystemData3::GridSystemData3()
 : GridSystemData3({0, 0, 0}, {1, 1, 1}, {0, 0, 0}) {
 }
@@ -35,6 +84,7 @@ GridSystemData3::GridSystemData3(
     _advectableVectorDataList.push_back(_velocity);
     _velocityIdx = 0;
     resize(resolution, gridSpacing, origin);
+    resetBackBuffers();
 }
 
 GridSystemData3::GridSystemData3(const GridSystemData3& other) {
@@ -61,6 +111,8 @@ GridSystemData3::GridSystemData3(const GridSystemData3& other) {
     JET_ASSERT(_velocity != nullptr);
 
     _velocityIdx = 0;
+
+    resetBackBuffers();
 }
 
 GridSystemData3::~GridSystemData3() {
@@ -86,6 +138,12 @@ void GridSystemData3::resize(
     for (auto& data : _advectableVectorDataList) {
         data->resize(resolution, gridSpacing, origin);
     }
+    for (auto& data : _advectableScalarDataBackBufferList) {
+        data->resize(resolution, gridSpacing, origin);
+    }
+    for (auto& data : _advectableVectorDataBackBufferList) {
+        data->resize(resolution, gridSpacing, origin);
+    }
 }
 
 Size3 GridSystemData3::resolution() const {
@@ -128,6 +186,8 @@ size_t GridSystemData3::addAdvectableScalarData(
     size_t attrIdx = _advectableScalarDataList.size();
     _advectableScalarDataList.push_back(
         builder->build(resolution(), gridSpacing(), origin(), initialVal));
+    _advectableScalarDataBackBufferList.push_back(
+        _advectableScalarDataList.back()->clone());
     return attrIdx;
 }
 
@@ -137,6 +197,8 @@ size_t GridSystemData3::addAdvectableVectorData(
     size_t attrIdx = _advectableVectorDataList.size();
     _advectableVectorDataList.push_back(
         builder->build(resolution(), gridSpacing(), origin(), initialVal));
+    _advectableVectorDataBackBufferList.push_back(
+        _advectableVectorDataList.back()->clone());
     return attrIdx;
 }
 
@@ -166,6 +228,40 @@ GridSystemData3::advectableVectorDataAt(size_t idx) const {
     return _advectableVectorDataList[idx];
 }
 
+const ScalarGrid3Ptr&
+GridSystemData3::advectableScalarDataBackBufferAt(size_t idx) const {
+    return _advectableScalarDataBackBufferList[idx];
+}
+
+const VectorGrid3Ptr&
+GridSystemData3::advectableVectorDataBackBufferAt(size_t idx) const {
+    return _advectableVectorDataBackBufferList[idx];
+}
+
+const FaceCenteredGrid3Ptr& GridSystemData3::velocityBackBuffer() const {
+    return _velocityBackBuffer;
+}
+
+void GridSystemData3::copyAdvectableScalarDataToBackBuffer(size_t idx) {
+    copyGrid(*_advectableScalarDataList[idx],
+             _advectableScalarDataBackBufferList[idx].get());
+}
+
+void GridSystemData3::copyAdvectableVectorDataToBackBuffer(size_t idx) {
+    copyGrid(*_advectableVectorDataList[idx],
+             _advectableVectorDataBackBufferList[idx].get());
+}
+
+void GridSystemData3::swapAdvectableScalarData(size_t idx) {
+    _advectableScalarDataList[idx]->swap(
+        _advectableScalarDataBackBufferList[idx].get());
+}
+
+void GridSystemData3::swapAdvectableVectorData(size_t idx) {
+    _advectableVectorDataList[idx]->swap(
+        _advectableVectorDataBackBufferList[idx].get());
+}
+
 size_t GridSystemData3::numberOfScalarData() const {
     return _scalarDataList.size();
 }
@@ -270,4 +366,23 @@ void GridSystemData3::deserialize(const std::vector<uint8_t>& buffer) {
     _velocityIdx = static_cast<size_t>(gsd->velocityIdx());
     _velocity = std::dynamic_pointer_cast<FaceCenteredGrid3>(
         _advectableVectorDataList[_velocityIdx]);
+
+    resetBackBuffers();
+}
+
+void GridSystemData3::resetBackBuffers() {
+    _advectableScalarDataBackBufferList.clear();
+    _advectableVectorDataBackBufferList.clear();
+
+    for (auto& data : _advectableScalarDataList) {
+        _advectableScalarDataBackBufferList.push_back(data->clone());
+    }
+    for (auto& data : _advectableVectorDataList) {
+        _advectableVectorDataBackBufferList.push_back(data->clone());
+    }
+
+    _velocityBackBuffer = std::dynamic_pointer_cast<FaceCenteredGrid3>(
+        _advectableVectorDataBackBufferList[_velocityIdx]);
+
+    JET_ASSERT(_velocityBackBuffer != nullptr);
 }
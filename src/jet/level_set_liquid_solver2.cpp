@@ -10,6 +10,7 @@
 #include <jet/fmm_level_set_solver2.h>
 #include <jet/level_set_liquid_solver2.h>
 #include <jet/level_set_utils.h>
+#include <jet/parallel.h>
 #include <jet/timer.h>
 
 #include <algorithm>
@@ -61,10 +62,20 @@ double LevelSetLiquidSolver2::computeVolume() const {
     const double cellVolume = gridSpacing.x * gridSpacing.y;
     const double h = std::max(gridSpacing.x, gridSpacing.y);
 
-    double volume = 0.0;
-    sdf->forEachDataPointIndex([&](size_t i, size_t j) {
-        volume += 1.0 - smearedHeavisideSdf((*sdf)(i, j) / h);
-    });
+    const Size2 size = sdf->dataSize();
+    double volume = parallelReduce(
+        kZeroSize, size.y, 0.0,
+        [&](size_t jBegin, size_t jEnd, double init) {
+            double result = init;
+            for (size_t j = jBegin; j < jEnd; ++j) {
+                for (size_t i = 0; i < size.x; ++i) {
+                    result += 1.0 - smearedHeavisideSdf((*sdf)(i, j) / h);
+                }
+            }
+            return result;
+        },
+        std::plus<double>(), ExecutionPolicy::kParallel,
+        ReductionMode::kDeterministic);
     volume *= cellVolume;
 
     return volume;
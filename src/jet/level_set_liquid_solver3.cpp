@@ -10,6 +10,7 @@
 #include <jet/fmm_level_set_solver3.h>
 #include <jet/level_set_liquid_solver3.h>
 #include <jet/level_set_utils.h>
+#include <jet/parallel.h>
 #include <jet/timer.h>
 
 #include <algorithm>
@@ -61,10 +62,23 @@ double LevelSetLiquidSolver3::computeVolume() const {
     const double cellVolume = gridSpacing.x * gridSpacing.y * gridSpacing.z;
     const double h = max3(gridSpacing.x, gridSpacing.y, gridSpacing.z);
 
-    double volume = 0.0;
-    sdf->forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
-        volume += 1.0 - smearedHeavisideSdf((*sdf)(i, j, k) / h);
-    });
+    const Size3 size = sdf->dataSize();
+    double volume = parallelReduce(
+        kZeroSize, size.z, 0.0,
+        [&](size_t kBegin, size_t kEnd, double init) {
+            double result = init;
+            for (size_t k = kBegin; k < kEnd; ++k) {
+                for (size_t j = 0; j < size.y; ++j) {
+                    for (size_t i = 0; i < size.x; ++i) {
+                        result +=
+                            1.0 - smearedHeavisideSdf((*sdf)(i, j, k) / h);
+                    }
+                }
+            }
+            return result;
+        },
+        std::plus<double>(), ExecutionPolicy::kParallel,
+        ReductionMode::kDeterministic);
     volume *= cellVolume;
 
     return volume;
@@ -0,0 +1,67 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+
+#include <jet/neighbor_lists.h>
+
+#include <algorithm>
+#include <limits>
+
+using namespace jet;
+
+NeighborLists::NeighborLists() : _offsets(1, 0) {}
+
+NeighborLists::NeighborLists(const std::vector<std::vector<size_t>>& lists) {
+    set(lists);
+}
+
+size_t NeighborLists::size() const { return _offsets.size() - 1; }
+
+bool NeighborLists::empty() const { return size() == 0; }
+
+NeighborLists::ConstList NeighborLists::operator[](size_t i) const {
+    return ConstList(_offsets[i + 1] - _offsets[i],
+                     _indices.data() + _offsets[i]);
+}
+
+size_t NeighborLists::numberOfEntries() const { return _indices.size(); }
+
+const std::vector<size_t>& NeighborLists::offsets() const { return _offsets; }
+
+const std::vector<NeighborLists::IndexType>& NeighborLists::indices() const {
+    return _indices;
+}
+
+void NeighborLists::clear() {
+    _offsets.assign(1, 0);
+    _indices.clear();
+}
+
+void NeighborLists::set(const std::vector<std::vector<size_t>>& lists) {
+    for (const auto& list : lists) {
+        for (size_t j : list) {
+            JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(
+                j > std::numeric_limits<IndexType>::max(),
+                "The neighbor index exceeds the range of the index type.");
+        }
+    }
+
+    build(lists.size(), [&](size_t i) { return lists[i].size(); },
+          [&](size_t i, IndexType* dst) {
+              std::transform(lists[i].begin(), lists[i].end(), dst,
+                             [](size_t j) { return static_cast<IndexType>(j); });
+          });
+}
+
+std::vector<std::vector<size_t>> NeighborLists::toNestedLists() const {
+    std::vector<std::vector<size_t>> lists(size());
+    for (size_t i = 0; i < lists.size(); ++i) {
+        const ConstList list = (*this)[i];
+        lists[i].assign(list.begin(), list.end());
+    }
+    return lists;
+}
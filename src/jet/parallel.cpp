@@ -6,7 +6,10 @@
 
 #include <jet/parallel.h>
 
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <thread>
 
 #if defined(JET_TASKING_TBB)
@@ -20,6 +23,235 @@ static unsigned int sMaxNumberOfThreads = std::thread::hardware_concurrency();
 
 namespace jet {
 
+#if defined(JET_TASKING_CPP11THREADS)
+namespace internal {
+
+struct ThreadPool::Impl {
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    unsigned int numThreads = 0;
+    bool isStopping = false;
+
+    std::atomic<bool> isRunning{false};
+
+    std::atomic<size_t> numPendingTasks{0};
+    std::atomic<size_t> nextQueue{0};
+
+    std::mutex sleepMutex;
+    std::condition_variable sleepCondition;
+
+    // Wakes up the threads in waitUntil.
+    std::mutex doneMutex;
+    std::condition_variable doneCondition;
+
+    // Serializes lazy start-up and resizing.
+    std::mutex controlMutex;
+
+    static thread_local Impl* currentPool;
+    static thread_local size_t currentWorker;
+    static thread_local unsigned int taskDepth;
+
+    void start() {
+        isStopping = false;
+        workers.clear();
+        for (unsigned int i = 0; i < numThreads; ++i) {
+            workers.emplace_back(new Worker);
+        }
+        for (unsigned int i = 0; i < numThreads; ++i) {
+            workers[i]->thread = std::thread([this, i]() { run(i); });
+        }
+        isRunning = true;
+    }
+
+    void stop() {
+        if (!isRunning) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            isStopping = true;
+        }
+        sleepCondition.notify_all();
+
+        for (auto& worker : workers) {
+            if (worker->thread.joinable()) {
+                worker->thread.join();
+            }
+        }
+        workers.clear();
+        isRunning = false;
+    }
+
+    void push(std::function<void()>&& task) {
+        // Tasks spawned by a worker of this pool stay local; others are
+        // distributed round-robin.
+        size_t queueIndex = (currentPool == this)
+                                ? currentWorker
+                                : nextQueue++ % workers.size();
+        {
+            Worker& worker = *workers[queueIndex];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            worker.tasks.push_back(std::move(task));
+        }
+
+        ++numPendingTasks;
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+        }
+        sleepCondition.notify_one();
+        notifyWaiters();
+    }
+
+    void notifyWaiters() {
+        {
+            std::lock_guard<std::mutex> lock(doneMutex);
+        }
+        doneCondition.notify_all();
+    }
+
+    void execute(std::function<void()>& task) {
+        ++taskDepth;
+        task();
+        task = nullptr;
+        --taskDepth;
+        notifyWaiters();
+    }
+
+    bool pop(size_t preferredWorker, std::function<void()>& task) {
+        const size_t n = workers.size();
+        if (n == 0 || numPendingTasks == 0) {
+            return false;
+        }
+
+        // Own queue first (newest task), then steal the oldest from others.
+        for (size_t i = 0; i < n; ++i) {
+            Worker& worker = *workers[(preferredWorker + i) % n];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            if (!worker.tasks.empty()) {
+                if (i == 0 && currentPool == this) {
+                    task = std::move(worker.tasks.back());
+                    worker.tasks.pop_back();
+                } else {
+                    task = std::move(worker.tasks.front());
+                    worker.tasks.pop_front();
+                }
+                --numPendingTasks;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void run(size_t workerIndex) {
+        currentPool = this;
+        currentWorker = workerIndex;
+
+        std::function<void()> task;
+        while (true) {
+            if (pop(workerIndex, task)) {
+                execute(task);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            sleepCondition.wait(lock, [this]() {
+                return numPendingTasks > 0 || isStopping;
+            });
+            if (isStopping && numPendingTasks == 0) {
+                break;
+            }
+        }
+
+        currentPool = nullptr;
+    }
+};
+
+thread_local ThreadPool::Impl* ThreadPool::Impl::currentPool = nullptr;
+thread_local size_t ThreadPool::Impl::currentWorker = 0;
+thread_local unsigned int ThreadPool::Impl::taskDepth = 0;
+
+ThreadPool::ThreadPool() : _impl(new Impl) {
+    _impl->numThreads = (sMaxNumberOfThreads == 0u) ? 8u : sMaxNumberOfThreads;
+}
+
+ThreadPool::~ThreadPool() { _impl->stop(); }
+
+ThreadPool& ThreadPool::instance() {
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::enqueue(std::function<void()> task) {
+    if (!_impl->isRunning) {
+        std::lock_guard<std::mutex> lock(_impl->controlMutex);
+        if (!_impl->isRunning) {
+            _impl->start();
+        }
+    }
+
+    _impl->push(std::move(task));
+}
+
+bool ThreadPool::tryRunPendingTask() {
+    size_t preferredWorker =
+        (Impl::currentPool == _impl.get()) ? Impl::currentWorker : 0;
+
+    std::function<void()> task;
+    if (_impl->pop(preferredWorker, task)) {
+        _impl->execute(task);
+        return true;
+    }
+
+    return false;
+}
+
+void ThreadPool::waitUntil(const std::function<bool()>& isDone) {
+    while (!isDone()) {
+        if (tryRunPendingTask()) {
+            continue;
+        }
+
+        // Sleep until a task is finished (which may satisfy the predicate)
+        // or a new task is available to help with.
+        std::unique_lock<std::mutex> lock(_impl->doneMutex);
+        _impl->doneCondition.wait(lock, [&]() {
+            return _impl->numPendingTasks > 0 || isDone();
+        });
+    }
+}
+
+void ThreadPool::resize(unsigned int numThreads) {
+    JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(
+        Impl::taskDepth > 0 || Impl::currentPool == _impl.get(),
+        "The thread pool cannot be resized from one of its tasks.");
+
+    numThreads = std::max(numThreads, 1u);
+
+    std::lock_guard<std::mutex> lock(_impl->controlMutex);
+    if (numThreads == _impl->numThreads) {
+        return;
+    }
+
+    bool wasRunning = _impl->isRunning;
+    _impl->stop();
+    _impl->numThreads = numThreads;
+    if (wasRunning) {
+        _impl->start();
+    }
+}
+
+unsigned int ThreadPool::numberOfThreads() const { return _impl->numThreads; }
+
+}  // namespace internal
+#endif
+
 void setMaxNumberOfThreads(unsigned int numThreads) {
 #if defined(JET_TASKING_TBB)
     static std::unique_ptr<tbb::task_scheduler_init> tbbInit;
@@ -31,6 +263,8 @@ void setMaxNumberOfThreads(unsigned int numThreads) {
     }
 #elif defined(JET_TASKING_OPENMP)
     omp_set_num_threads(numThreads);
+#elif defined(JET_TASKING_CPP11THREADS)
+    internal::ThreadPool::instance().resize(numThreads);
 #endif
     sMaxNumberOfThreads = std::max(numThreads, 1u);
 }
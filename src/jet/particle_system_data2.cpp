@@ -199,8 +199,7 @@ void ParticleSystemData2::setNeighborSearcher(
     _neighborSearcher = newNeighborSearcher;
 }
 
-const std::vector<std::vector<size_t>>&
-ParticleSystemData2::neighborLists() const {
+const NeighborLists& ParticleSystemData2::neighborLists() const {
     return _neighborLists;
 }
 
@@ -223,22 +222,32 @@ void ParticleSystemData2::buildNeighborSearcher(double maxSearchRadius) {
 void ParticleSystemData2::buildNeighborLists(double maxSearchRadius) {
     Timer timer;
 
-    _neighborLists.resize(numberOfParticles());
-
     auto points = positions();
-    for (size_t i = 0; i < numberOfParticles(); ++i) {
-        Vector2D origin = points[i];
-        _neighborLists[i].clear();
-
-        _neighborSearcher->forEachNearbyPoint(
-            origin,
-            maxSearchRadius,
-            [&](size_t j, const Vector2D&) {
-                if (i != j) {
-                    _neighborLists[i].push_back(j);
-                }
-            });
-    }
+    const auto& searcher = *_neighborSearcher;
+
+    // Count first and then fill the flat index array in parallel
+    _neighborLists.build(
+        numberOfParticles(),
+        [&](size_t i) {
+            size_t count = 0;
+            searcher.forEachNearbyPoint(
+                points[i], maxSearchRadius,
+                [&](size_t j, const Vector2D&) {
+                    if (i != j) {
+                        ++count;
+                    }
+                });
+            return count;
+        },
+        [&](size_t i, NeighborLists::IndexType* dst) {
+            searcher.forEachNearbyPoint(
+                points[i], maxSearchRadius,
+                [&](size_t j, const Vector2D&) {
+                    if (i != j) {
+                        *(dst++) = static_cast<NeighborLists::IndexType>(j);
+                    }
+                });
+        });
 
     JET_INFO << "Building neighbor list took: "
              << timer.durationInSeconds()
@@ -334,7 +343,8 @@ void ParticleSystemData2::serializeParticleSystemData(
 
     // Copy neighbor lists
     std::vector<flatbuffers::Offset<fbs::ParticleNeighborList2>> neighborLists;
-    for (const auto& neighbors : _neighborLists) {
+    for (size_t i = 0; i < _neighborLists.size(); ++i) {
+        const auto neighbors = _neighborLists[i];
         std::vector<uint64_t> neighbors64(neighbors.begin(), neighbors.end());
         flatbuffers::Offset<fbs::ParticleNeighborList2> fbsNeighborList
             = fbs::CreateParticleNeighborList2(
@@ -410,16 +420,22 @@ void ParticleSystemData2::deserializeParticleSystemData(
 
     // Copy neighbor list
     auto fbsNeighborLists = fbsParticleSystemData->neighborLists();
-    _neighborLists.resize(fbsNeighborLists->size());
-    for (uint32_t i = 0; i < fbsNeighborLists->size(); ++i) {
-        auto fbsNeighborList = fbsNeighborLists->Get(i);
-        _neighborLists[i].resize(fbsNeighborList->data()->size());
-        std::transform(
-            fbsNeighborList->data()->begin(),
-            fbsNeighborList->data()->end(),
-            _neighborLists[i].begin(),
-            [] (uint64_t val) {
-                return static_cast<size_t>(val);
-            });
-    }
+    _neighborLists.build(
+        fbsNeighborLists->size(),
+        [&](size_t i) {
+            auto fbsNeighborList =
+                fbsNeighborLists->Get(static_cast<uint32_t>(i));
+            return static_cast<size_t>(fbsNeighborList->data()->size());
+        },
+        [&](size_t i, NeighborLists::IndexType* dst) {
+            auto fbsNeighborList =
+                fbsNeighborLists->Get(static_cast<uint32_t>(i));
+            std::transform(
+                fbsNeighborList->data()->begin(),
+                fbsNeighborList->data()->end(),
+                dst,
+                [](uint64_t val) {
+                    return static_cast<NeighborLists::IndexType>(val);
+                });
+        });
 }
@@ -14,18 +14,53 @@
 #include <fbs_helpers.h>
 #include <generated/particle_system_data3_generated.h>
 
+#include <jet/bounding_box3.h>
 #include <jet/parallel.h>
 #include <jet/particle_system_data3.h>
 #include <jet/point_parallel_hash_grid_searcher3.h>
+#include <jet/point_sparse_hash_grid_searcher3.h>
 #include <jet/timer.h>
 
 #include <algorithm>
+#include <utility>
 #include <vector>
 
 using namespace jet;
 
 static const size_t kDefaultHashGridResolution = 64;
 
+// Number of bits per axis for the Morton code (3 x 21 = 63 bits)
+static const uint64_t kMortonResolution = (1 << 21);
+
+// Number of particles per block of the stream compaction
+static const size_t kCompactionBlockSize = 4096;
+
+// Spreads the lower 21 bits of x so that there are two zero bits in between.
+inline uint64_t expandBits(uint64_t x) {
+    x &= 0x1fffff;
+    x = (x | (x << 32)) & 0x1f00000000ffff;
+    x = (x | (x << 16)) & 0x1f0000ff0000ff;
+    x = (x | (x << 8)) & 0x100f00f00f00f00f;
+    x = (x | (x << 4)) & 0x10c30c30c30c30c3;
+    x = (x | (x << 2)) & 0x1249249249249249;
+    return x;
+}
+
+// Gathers the data into the buffer and swaps their storage, so that the
+// storage is recycled rather than reallocated on every call.
+template <typename T>
+inline void permute(
+    const Array1<size_t>& permutation, Array1<T>* data, Array1<T>* buffer) {
+    buffer->reserve(data->capacity());
+    buffer->resize(permutation.size());
+    parallelFor(kZeroSize, permutation.size(), [&](size_t i) {
+        (*buffer)[i] = (*data)[permutation[i]];
+    });
+    data->swap(*buffer);
+}
+
+const size_t ParticleSystemData3::kNeighborBatchSize;
+
 ParticleSystemData3::ParticleSystemData3()
 : ParticleSystemData3(0) {
 }
@@ -53,7 +88,15 @@ ParticleSystemData3::~ParticleSystemData3() {
 }
 
 void ParticleSystemData3::resize(size_t newNumberOfParticles) {
+    // Grow the storage geometrically so that adding particles repeatedly
+    // takes amortized constant time per particle.
+    const size_t oldCapacity = capacity();
+    if (newNumberOfParticles > oldCapacity) {
+        reserve(std::max(newNumberOfParticles, 2 * oldCapacity));
+    }
+
     _numberOfParticles = newNumberOfParticles;
+    invalidateNeighborLists();
 
     for (auto& attr : _scalarDataList) {
         attr.resize(newNumberOfParticles, 0.0);
@@ -68,15 +111,42 @@ size_t ParticleSystemData3::numberOfParticles() const {
     return _numberOfParticles;
 }
 
+void ParticleSystemData3::reserve(size_t newCapacity) {
+    for (auto& attr : _scalarDataList) {
+        attr.reserve(newCapacity);
+    }
+
+    for (auto& attr : _vectorDataList) {
+        attr.reserve(newCapacity);
+    }
+}
+
+size_t ParticleSystemData3::capacity() const {
+    size_t result = kMaxSize;
+    for (const auto& attr : _scalarDataList) {
+        result = std::min(result, attr.capacity());
+    }
+
+    for (const auto& attr : _vectorDataList) {
+        result = std::min(result, attr.capacity());
+    }
+
+    return (result == kMaxSize) ? 0 : result;
+}
+
 size_t ParticleSystemData3::addScalarData(double initialVal) {
     size_t attrIdx = _scalarDataList.size();
+    size_t oldCapacity = capacity();
     _scalarDataList.emplace_back(numberOfParticles(), initialVal);
+    _scalarDataList.back().reserve(oldCapacity);
     return attrIdx;
 }
 
 size_t ParticleSystemData3::addVectorData(const Vector3D& initialVal) {
     size_t attrIdx = _vectorDataList.size();
+    size_t oldCapacity = capacity();
     _vectorDataList.emplace_back(numberOfParticles(), initialVal);
+    _vectorDataList.back().reserve(oldCapacity);
     return attrIdx;
 }
 
@@ -142,14 +212,12 @@ void ParticleSystemData3::addParticle(
     const Vector3D& newPosition,
     const Vector3D& newVelocity,
     const Vector3D& newForce) {
-    Array1<Vector3D> newPositions = {newPosition};
-    Array1<Vector3D> newVelocities = {newVelocity};
-    Array1<Vector3D> newForces = {newForce};
+    size_t i = numberOfParticles();
+    resize(i + 1);
 
-    addParticles(
-        newPositions.constAccessor(),
-        newVelocities.constAccessor(),
-        newForces.constAccessor());
+    positions()[i] = newPosition;
+    velocities()[i] = newVelocity;
+    forces()[i] = newForce;
 }
 
 void ParticleSystemData3::addParticles(
@@ -192,30 +260,253 @@ void ParticleSystemData3::addParticles(
 }
 
 const PointNeighborSearcher3Ptr& ParticleSystemData3::neighborSearcher() const {
+    // Rebuild lazily after the particles have been reordered
+    if (!_isNeighborSearcherValid) {
+        std::lock_guard<std::mutex> lock(_neighborSearcherMutex);
+        if (!_isNeighborSearcherValid) {
+            _neighborSearcher->build(positions());
+            _isNeighborSearcherValid = true;
+        }
+    }
+
     return _neighborSearcher;
 }
 
 void ParticleSystemData3::setNeighborSearcher(
     const PointNeighborSearcher3Ptr& newNeighborSearcher) {
     _neighborSearcher = newNeighborSearcher;
+    _isNeighborSearcherValid = true;
 }
 
-const std::vector<std::vector<size_t>>&
-ParticleSystemData3::neighborLists() const {
+bool ParticleSystemData3::useSparseNeighborSearcher() const {
+    return _useSparseNeighborSearcher;
+}
+
+void ParticleSystemData3::setUseSparseNeighborSearcher(bool onoff) {
+    _useSparseNeighborSearcher = onoff;
+}
+
+const NeighborLists& ParticleSystemData3::neighborLists() const {
     return _neighborLists;
 }
 
+bool ParticleSystemData3::useNeighborLists() const {
+    return _useNeighborLists;
+}
+
+void ParticleSystemData3::setUseNeighborLists(bool onoff) {
+    _useNeighborLists = onoff;
+    invalidateNeighborLists();
+}
+
+double ParticleSystemData3::skinRadius() const {
+    return _skinRadius;
+}
+
+void ParticleSystemData3::setSkinRadius(double newSkinRadius) {
+    _skinRadius = std::max(newSkinRadius, 0.0);
+    invalidateNeighborLists();
+}
+
+bool ParticleSystemData3::needsNeighborListsRebuild(
+    double maxSearchRadius) const {
+    if (!_useNeighborLists
+        || _skinRadius <= 0.0
+        || !_isNeighborListsValid
+        || _neighborListsSearchRadius != maxSearchRadius
+        || _neighborListsPositions.size() != numberOfParticles()) {
+        return true;
+    }
+
+    return maxDisplacementSinceNeighborListsBuild() > 0.5 * _skinRadius;
+}
+
+double ParticleSystemData3::maxDisplacementSinceNeighborListsBuild() const {
+    const size_t n
+        = std::min(numberOfParticles(), _neighborListsPositions.size());
+    auto x = positions();
+
+    double maxDistanceSquared = parallelReduce(
+        kZeroSize, n, 0.0,
+        [&](size_t iBegin, size_t iEnd, double init) {
+            double result = init;
+            for (size_t i = iBegin; i < iEnd; ++i) {
+                result = std::max(
+                    result, x[i].distanceSquaredTo(_neighborListsPositions[i]));
+            }
+            return result;
+        },
+        [](double a, double b) { return std::max(a, b); });
+
+    return std::sqrt(maxDistanceSquared);
+}
+
+void ParticleSystemData3::invalidateNeighborLists() {
+    _isNeighborListsValid = false;
+}
+
+void ParticleSystemData3::sortParticles(Array1<size_t>* permutation) {
+    Timer timer;
+
+    const size_t n = numberOfParticles();
+    auto x = positions();
+
+    BoundingBox3D bound = parallelReduce(
+        kZeroSize, n, BoundingBox3D(),
+        [&](size_t iBegin, size_t iEnd, BoundingBox3D init) {
+            for (size_t i = iBegin; i < iEnd; ++i) {
+                init.merge(x[i]);
+            }
+            return init;
+        },
+        [](BoundingBox3D a, const BoundingBox3D& b) {
+            a.merge(b);
+            return a;
+        });
+
+    // Quantize the positions within the bounding box and sort the
+    // (code, index) pairs. Ties are resolved by the original index.
+    const Vector3D extent = bound.upperCorner - bound.lowerCorner;
+    const double maxExtent = std::max(extent.max(), kEpsilonD);
+    const double scale = (kMortonResolution - 1) / maxExtent;
+
+    std::vector<std::pair<uint64_t, size_t>> codes(n);
+    parallelFor(kZeroSize, n, [&](size_t i) {
+        const Vector3D p = (x[i] - bound.lowerCorner) * scale;
+        const uint64_t cx
+            = std::min(static_cast<uint64_t>(p.x), kMortonResolution - 1);
+        const uint64_t cy
+            = std::min(static_cast<uint64_t>(p.y), kMortonResolution - 1);
+        const uint64_t cz
+            = std::min(static_cast<uint64_t>(p.z), kMortonResolution - 1);
+        codes[i].first
+            = expandBits(cx) | (expandBits(cy) << 1) | (expandBits(cz) << 2);
+        codes[i].second = i;
+    });
+
+    parallelSort(codes.begin(), codes.end());
+
+    Array1<size_t> order(n);
+    parallelFor(kZeroSize, n, [&](size_t i) {
+        order[i] = codes[i].second;
+    });
+
+    for (auto& attr : _scalarDataList) {
+        permute(order, &attr, &_scalarDataBuffer);
+    }
+    for (auto& attr : _vectorDataList) {
+        permute(order, &attr, &_vectorDataBuffer);
+    }
+
+    invalidateNeighborLists();
+    _isNeighborSearcherValid = false;
+
+    if (permutation != nullptr) {
+        permutation->swap(order);
+    }
+
+    JET_INFO << "Sorting particles took: "
+             << timer.durationInSeconds()
+             << " seconds";
+}
+
+void ParticleSystemData3::removeParticles(
+    const ConstArrayAccessor1<char>& mask,
+    Array1<size_t>* remaining) {
+    JET_THROW_INVALID_ARG_IF(mask.size() != numberOfParticles());
+
+    Timer timer;
+
+    // Count the remaining particles per block, then scan the counts so that
+    // each block can write its indices independently. The block size is
+    // fixed, so the result does not depend on the number of threads.
+    const size_t n = numberOfParticles();
+    const size_t numberOfBlocks
+        = (n + kCompactionBlockSize - 1) / kCompactionBlockSize;
+
+    std::vector<size_t> offsets(numberOfBlocks + 1, 0);
+    parallelFor(kZeroSize, numberOfBlocks, [&](size_t b) {
+        const size_t iEnd = std::min((b + 1) * kCompactionBlockSize, n);
+        size_t count = 0;
+        for (size_t i = b * kCompactionBlockSize; i < iEnd; ++i) {
+            count += (mask[i] == 0) ? 1 : 0;
+        }
+        offsets[b + 1] = count;
+    });
+
+    for (size_t b = 0; b < numberOfBlocks; ++b) {
+        offsets[b + 1] += offsets[b];
+    }
+
+    const size_t newNumberOfParticles = offsets[numberOfBlocks];
+    if (newNumberOfParticles == n) {
+        if (remaining != nullptr) {
+            remaining->resize(n);
+            parallelFor(kZeroSize, n, [&](size_t i) {
+                (*remaining)[i] = i;
+            });
+        }
+        return;
+    }
+
+    Array1<size_t> order(newNumberOfParticles);
+    parallelFor(kZeroSize, numberOfBlocks, [&](size_t b) {
+        const size_t iEnd = std::min((b + 1) * kCompactionBlockSize, n);
+        size_t offset = offsets[b];
+        for (size_t i = b * kCompactionBlockSize; i < iEnd; ++i) {
+            if (mask[i] == 0) {
+                order[offset++] = i;
+            }
+        }
+    });
+
+    for (auto& attr : _scalarDataList) {
+        permute(order, &attr, &_scalarDataBuffer);
+    }
+    for (auto& attr : _vectorDataList) {
+        permute(order, &attr, &_vectorDataBuffer);
+    }
+
+    _numberOfParticles = newNumberOfParticles;
+    invalidateNeighborLists();
+    _isNeighborSearcherValid = false;
+
+    if (remaining != nullptr) {
+        remaining->swap(order);
+    }
+
+    JET_INFO << "Removing " << n - newNumberOfParticles
+             << " particles took: " << timer.durationInSeconds()
+             << " seconds";
+}
+
 void ParticleSystemData3::buildNeighborSearcher(double maxSearchRadius) {
     Timer timer;
 
-    // Use PointParallelHashGridSearcher3 by default
-    _neighborSearcher = std::make_shared<PointParallelHashGridSearcher3>(
-        kDefaultHashGridResolution,
-        kDefaultHashGridResolution,
-        kDefaultHashGridResolution,
-        2.0 * maxSearchRadius);
+    if (!_useNeighborLists) {
+        // The grid spacing equals to the search radius so that
+        // forEachNeighbor only needs to visit the 27 adjacent cells.
+        _cellSearcher = std::make_shared<PointSparseHashGridSearcher3>(
+            maxSearchRadius);
+        _neighborSearcher = _cellSearcher;
+    } else if (_useSparseNeighborSearcher) {
+        maxSearchRadius += _skinRadius;
+
+        _neighborSearcher = std::make_shared<PointSparseHashGridSearcher3>(
+            2.0 * maxSearchRadius);
+    } else {
+        maxSearchRadius += _skinRadius;
+
+        // Use PointParallelHashGridSearcher3 by default
+        _neighborSearcher = std::make_shared<PointParallelHashGridSearcher3>(
+            kDefaultHashGridResolution,
+            kDefaultHashGridResolution,
+            kDefaultHashGridResolution,
+            2.0 * maxSearchRadius);
+    }
 
     _neighborSearcher->build(positions());
+    _isNeighborSearcherValid = true;
 
     JET_INFO << "Building neighbor searcher took: "
              << timer.durationInSeconds()
@@ -225,23 +516,68 @@ void ParticleSystemData3::buildNeighborSearcher(double maxSearchRadius) {
 void ParticleSystemData3::buildNeighborLists(double maxSearchRadius) {
     Timer timer;
 
-    _neighborLists.resize(numberOfParticles());
+    _neighborListsSearchRadius = maxSearchRadius;
+
+    if (!_useNeighborLists) {
+        JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(
+            _cellSearcher == nullptr
+                || _cellSearcher != _neighborSearcher
+                || _cellSearcher->gridSpacing() < maxSearchRadius,
+            "Neighbor searcher should be built by buildNeighborSearcher with "
+            "the same or larger search radius.");
+
+        // Neighbors are gathered from the hash grid on the fly, so the grid
+        // should follow the particles if they have been reordered
+        neighborSearcher();
+        _neighborLists = NeighborLists();
+        _neighborListsPositions.clear();
+        _isNeighborListsValid = false;
+        return;
+    }
 
-    auto points = positions();
-    for (size_t i = 0; i < numberOfParticles(); ++i) {
-        Vector3D origin = points[i];
-        _neighborLists[i].clear();
-
-        _neighborSearcher->forEachNearbyPoint(
-            origin,
-            maxSearchRadius,
-            [&](size_t j, const Vector3D&) {
-                if (i != j) {
-                    _neighborLists[i].push_back(j);
-                }
-            });
+    // Remember the positions to measure displacements for the skin test
+    if (_skinRadius > 0.0) {
+        auto x = positions();
+        _neighborListsPositions.resize(numberOfParticles());
+        parallelFor(kZeroSize, numberOfParticles(), [&](size_t i) {
+            _neighborListsPositions[i] = x[i];
+        });
+        _isNeighborListsValid = true;
+    } else {
+        _neighborListsPositions.clear();
+        _isNeighborListsValid = false;
     }
 
+    maxSearchRadius += _skinRadius;
+
+    auto points = positions();
+    const auto& searcher = *neighborSearcher();
+
+    // Count first and then fill the flat index array in parallel
+    _neighborLists.build(
+        numberOfParticles(),
+        [&](size_t i) {
+            size_t count = 0;
+            searcher.forEachNearbyPoint(
+                points[i], maxSearchRadius,
+                [&](size_t j, const Vector3D&) {
+                    if (i != j) {
+                        ++count;
+                    }
+                });
+            return count;
+        },
+        [&](size_t i, NeighborLists::IndexType* dst) {
+            searcher.forEachNearbyPoint(
+                points[i], maxSearchRadius,
+                [&](size_t j, const Vector3D&) {
+                    if (i != j) {
+                        JET_ASSERT(j < numberOfParticles());
+                        *(dst++) = static_cast<NeighborLists::IndexType>(j);
+                    }
+                });
+        });
+
     JET_INFO << "Building neighbor list took: "
              << timer.durationInSeconds()
              << " seconds";
@@ -284,7 +620,23 @@ void ParticleSystemData3::set(const ParticleSystemData3& other) {
     }
 
     _neighborSearcher = other._neighborSearcher->clone();
+    _isNeighborSearcherValid = other._isNeighborSearcherValid.load();
     _neighborLists = other._neighborLists;
+    _useSparseNeighborSearcher = other._useSparseNeighborSearcher;
+
+    _useNeighborLists = other._useNeighborLists;
+    if (other._cellSearcher != nullptr
+        && other._cellSearcher == other._neighborSearcher) {
+        _cellSearcher = std::dynamic_pointer_cast<
+            PointSparseHashGridSearcher3>(_neighborSearcher);
+    } else {
+        _cellSearcher.reset();
+    }
+
+    _skinRadius = other._skinRadius;
+    _neighborListsSearchRadius = other._neighborListsSearchRadius;
+    _isNeighborListsValid = other._isNeighborListsValid;
+    _neighborListsPositions.set(other._neighborListsPositions);
 }
 
 ParticleSystemData3& ParticleSystemData3::operator=(
@@ -323,10 +675,11 @@ void ParticleSystemData3::serializeParticleSystemData(
     auto fbsVectorDataList = builder->CreateVector(vectorDataList);
 
     // Copy neighbor searcher
+    const auto& searcher = neighborSearcher();
     auto neighborSearcherType
-        = builder->CreateString(_neighborSearcher->typeName());
+        = builder->CreateString(searcher->typeName());
     std::vector<uint8_t> neighborSearcherSerialized;
-    _neighborSearcher->serialize(&neighborSearcherSerialized);
+    searcher->serialize(&neighborSearcherSerialized);
     auto fbsNeighborSearcher = fbs::CreatePointNeighborSearcherSerialized3(
         *builder,
         neighborSearcherType,
@@ -336,7 +689,8 @@ void ParticleSystemData3::serializeParticleSystemData(
 
     // Copy neighbor lists
     std::vector<flatbuffers::Offset<fbs::ParticleNeighborList3>> neighborLists;
-    for (const auto& neighbors : _neighborLists) {
+    for (size_t i = 0; i < _neighborLists.size(); ++i) {
+        const auto neighbors = _neighborLists[i];
         std::vector<uint64_t> neighbors64(neighbors.begin(), neighbors.end());
         flatbuffers::Offset<fbs::ParticleNeighborList3> fbsNeighborList
             = fbs::CreateParticleNeighborList3(
@@ -409,19 +763,27 @@ void ParticleSystemData3::deserializeParticleSystemData(
         fbsNeighborSearcher->data()->begin(),
         fbsNeighborSearcher->data()->end());
     _neighborSearcher->deserialize(neighborSearcherSerialized);
+    _isNeighborSearcherValid = true;
+    invalidateNeighborLists();
 
     // Copy neighbor list
     auto fbsNeighborLists = fbsParticleSystemData->neighborLists();
-    _neighborLists.resize(fbsNeighborLists->size());
-    for (uint32_t i = 0; i < fbsNeighborLists->size(); ++i) {
-        auto fbsNeighborList = fbsNeighborLists->Get(i);
-        _neighborLists[i].resize(fbsNeighborList->data()->size());
-        std::transform(
-            fbsNeighborList->data()->begin(),
-            fbsNeighborList->data()->end(),
-            _neighborLists[i].begin(),
-            [](uint64_t val) {
-            return static_cast<size_t>(val);
+    _neighborLists.build(
+        fbsNeighborLists->size(),
+        [&](size_t i) {
+            auto fbsNeighborList =
+                fbsNeighborLists->Get(static_cast<uint32_t>(i));
+            return static_cast<size_t>(fbsNeighborList->data()->size());
+        },
+        [&](size_t i, NeighborLists::IndexType* dst) {
+            auto fbsNeighborList =
+                fbsNeighborLists->Get(static_cast<uint32_t>(i));
+            std::transform(
+                fbsNeighborList->data()->begin(),
+                fbsNeighborList->data()->end(),
+                dst,
+                [](uint64_t val) {
+                    return static_cast<NeighborLists::IndexType>(val);
+                });
         });
-    }
 }
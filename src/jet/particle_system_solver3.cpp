@@ -89,6 +89,32 @@ void ParticleSystemSolver3::setWind(const VectorField3Ptr& newWind) {
     _wind = newWind;
 }
 
+unsigned int ParticleSystemSolver3::particleSortingInterval() const {
+    return _particleSortingInterval;
+}
+
+void ParticleSystemSolver3::setParticleSortingInterval(
+    unsigned int newInterval) {
+    _particleSortingInterval = newInterval;
+    _numberOfStepsSinceSort = 0;
+}
+
+bool ParticleSystemSolver3::removesParticlesOutsideDomain() const {
+    return _removesParticlesOutsideDomain;
+}
+
+void ParticleSystemSolver3::setRemovesParticlesOutsideDomain(bool onoff) {
+    _removesParticlesOutsideDomain = onoff;
+}
+
+const BoundingBox3D& ParticleSystemSolver3::particleDomain() const {
+    return _particleDomain;
+}
+
+void ParticleSystemSolver3::setParticleDomain(const BoundingBox3D& newDomain) {
+    _particleDomain = newDomain;
+}
+
 void ParticleSystemSolver3::onInitialize() {
     // When initializing the solver, update the collider and emitter state as
     // well since they also affects the initial condition of the simulation.
@@ -147,6 +173,20 @@ void ParticleSystemSolver3::beginAdvanceTimeStep(double timeStepInSeconds) {
     JET_INFO << "Update emitter took "
              << timer.durationInSeconds() << " seconds";
 
+    if (_removesParticlesOutsideDomain) {
+        timer.reset();
+        removeParticlesOutsideDomain();
+        JET_INFO << "Removing particles outside domain took "
+                 << timer.durationInSeconds() << " seconds";
+    }
+
+    // Reorder particles periodically for better memory locality
+    if (_particleSortingInterval > 0
+        && ++_numberOfStepsSinceSort >= _particleSortingInterval) {
+        sortParticles();
+        _numberOfStepsSinceSort = 0;
+    }
+
     // Allocate buffers
     size_t n = _particleSystemData->numberOfParticles();
     _newPositions.resize(n);
@@ -171,6 +211,15 @@ void ParticleSystemSolver3::endAdvanceTimeStep(double timeStepInSeconds) {
     onEndAdvanceTimeStep(timeStepInSeconds);
 }
 
+void ParticleSystemSolver3::sortParticles() {
+    _particleSystemData->sortParticles();
+}
+
+void ParticleSystemSolver3::removeParticles(
+    const ConstArrayAccessor1<char>& mask) {
+    _particleSystemData->removeParticles(mask);
+}
+
 void ParticleSystemSolver3::onBeginAdvanceTimeStep(double timeStepInSeconds) {
     UNUSED_VARIABLE(timeStepInSeconds);
 }
@@ -189,19 +238,11 @@ void ParticleSystemSolver3::resolveCollision(
     ArrayAccessor1<Vector3D> newPositions,
     ArrayAccessor1<Vector3D> newVelocities) {
     if (_collider != nullptr) {
-        size_t numberOfParticles = _particleSystemData->numberOfParticles();
-        const double radius = _particleSystemData->radius();
-
-        parallelFor(
-            kZeroSize,
-            numberOfParticles,
-            [&] (size_t i) {
-                _collider->resolveCollision(
-                    radius,
-                    _restitutionCoefficient,
-                    &newPositions[i],
-                    &newVelocities[i]);
-            });
+        _collider->resolveCollision(
+            _particleSystemData->radius(),
+            _restitutionCoefficient,
+            newPositions,
+            newVelocities);
     }
 }
 
@@ -266,6 +307,21 @@ void ParticleSystemSolver3::updateEmitter(double timeStepInSeconds) {
     }
 }
 
+void ParticleSystemSolver3::removeParticlesOutsideDomain() {
+    size_t n = _particleSystemData->numberOfParticles();
+    auto positions = _particleSystemData->positions();
+
+    Array1<char> mask(n);
+    parallelFor(
+        kZeroSize,
+        n,
+        [&] (size_t i) {
+            mask[i] = _particleDomain.contains(positions[i]) ? 0 : 1;
+        });
+
+    removeParticles(mask.constAccessor());
+}
+
 ParticleSystemSolver3::Builder ParticleSystemSolver3::builder() {
     return Builder();
 }
@@ -79,7 +79,7 @@ void PciSphSolver2::accumulatePressureForce(
         });
 
     unsigned int maxNumIter = 0;
-    double maxDensityError;
+    double maxDensityError = 0.0;
     double densityErrorRatio = 0.0;
 
     for (unsigned int k = 0; k < _maxNumberOfIterations; ++k) {
@@ -107,7 +107,7 @@ void PciSphSolver2::accumulatePressureForce(
             numberOfParticles,
             [&] (size_t i) {
                 double weightSum = 0.0;
-                const auto& neighbors = particles->neighborLists()[i];
+                const auto neighbors = particles->neighborLists()[i];
 
                 for (size_t j : neighbors) {
                     double dist
@@ -136,10 +136,17 @@ void PciSphSolver2::accumulatePressureForce(
             x, ds.constAccessor(), p, _pressureForces.accessor());
 
         // Compute max density error
-        maxDensityError = 0.0;
-        for (size_t i = 0; i < numberOfParticles; ++i) {
-            maxDensityError = absmax(maxDensityError, _densityErrors[i]);
-        }
+        maxDensityError = parallelReduce(
+            kZeroSize, numberOfParticles, 0.0,
+            [&](size_t iBegin, size_t iEnd, double init) {
+                double result = init;
+                for (size_t i = iBegin; i < iEnd; ++i) {
+                    result = absmax(result, _densityErrors[i]);
+                }
+                return result;
+            },
+            [](double a, double b) { return absmax(a, b); },
+            ExecutionPolicy::kParallel, ReductionMode::kDeterministic);
 
         densityErrorRatio = maxDensityError / targetDensity;
         maxNumIter = k + 1;
@@ -9,6 +9,7 @@
 #include <jet/parallel.h>
 #include <jet/pci_sph_solver3.h>
 #include <jet/sph_kernels3.h>
+#include <jet/timer.h>
 
 #include <algorithm>
 
@@ -17,6 +18,9 @@ using namespace jet;
 // Heuristically chosen
 const double kDefaultTimeStepLimitScale = 5.0;
 
+static const size_t kNeighborBatchSize
+    = ParticleSystemData3::kNeighborBatchSize;
+
 PciSphSolver3::PciSphSolver3() {
     setTimeStepLimitScale(kDefaultTimeStepLimitScale);
 }
@@ -67,103 +71,134 @@ void PciSphSolver3::accumulatePressureForce(
 
     SphStdKernel3 kernel(particles->kernelRadius());
 
-    // Initialize buffers
+    Timer timer;
+
+    // Initialize buffers and predict velocity and position without the
+    // pressure force
     parallelFor(
         kZeroSize,
         numberOfParticles,
         [&] (size_t i) {
             p[i] = 0.0;
-            _pressureForces[i] = Vector3D();
-            _densityErrors[i] = 0.0;
             ds[i] = d[i];
+            _tempVelocities[i]
+                = v[i] + timeIntervalInSeconds / mass * f[i];
+            _tempPositions[i]
+                = x[i] + timeIntervalInSeconds * _tempVelocities[i];
         });
 
     unsigned int maxNumIter = 0;
-    double maxDensityError;
+    double maxDensityError = 0.0;
     double densityErrorRatio = 0.0;
 
     for (unsigned int k = 0; k < _maxNumberOfIterations; ++k) {
-        // Predict velocity and position
-        parallelFor(
-            kZeroSize,
-            numberOfParticles,
-            [&] (size_t i) {
-                _tempVelocities[i]
-                    = v[i]
-                    + timeIntervalInSeconds / mass
-                    * (f[i] + _pressureForces[i]);
-                _tempPositions[i]
-                    = x[i] + timeIntervalInSeconds * _tempVelocities[i];
-            });
-
         // Resolve collisions
         resolveCollision(
             _tempPositions,
             _tempVelocities);
 
-        // Compute pressure from density error
-        parallelFor(
-            kZeroSize,
-            numberOfParticles,
-            [&] (size_t i) {
-                double weightSum = 0.0;
-                const auto& neighbors = particles->neighborLists()[i];
-
-                for (size_t j : neighbors) {
-                    double dist
-                        = _tempPositions[j].distanceTo(_tempPositions[i]);
-                    weightSum += kernel(dist);
-                }
-                weightSum += kernel(0);
-
-                double density = mass * weightSum;
-                double densityError = (density - targetDensity);
-                double pressure = delta * densityError;
-
-                if (pressure < 0.0) {
-                    pressure *= negativePressureScale();
-                    densityError *= negativePressureScale();
+        // Compute pressure from density error and its max
+        maxDensityError = parallelReduce(
+            kZeroSize, numberOfParticles, 0.0,
+            [&](size_t iBegin, size_t iEnd, double init) {
+                double result = init;
+                double weights[kNeighborBatchSize];
+
+                for (size_t i = iBegin; i < iEnd; ++i) {
+                    // Sleeping particles away from the awake ones keep zero
+                    // pressure
+                    if (!needsDensityUpdate(i)) {
+                        continue;
+                    }
+
+                    double weightSum = 0.0;
+                    particles->forEachNeighborBatch(
+                        i,
+                        [&](const NeighborLists::IndexType* neighbors,
+                            size_t n) {
+                            for (size_t k = 0; k < n; ++k) {
+                                weights[k] = _tempPositions[neighbors[k]]
+                                    .distanceSquaredTo(_tempPositions[i]);
+                            }
+                            kernel.valuesFromSquaredDistances(
+                                weights, n, weights);
+
+                            for (size_t k = 0; k < n; ++k) {
+                                weightSum += weights[k];
+                            }
+                        });
+                    weightSum += kernel(0);
+
+                    double density = mass * weightSum;
+                    double densityError = (density - targetDensity);
+                    double pressure = delta * densityError;
+
+                    if (pressure < 0.0) {
+                        pressure *= negativePressureScale();
+                        densityError *= negativePressureScale();
+                    }
+
+                    p[i] += pressure;
+                    ds[i] = density;
+                    result = absmax(result, densityError);
                 }
-
-                p[i] += pressure;
-                ds[i] = density;
-                _densityErrors[i] = densityError;
-            });
-
-        // Compute pressure gradient force
-        _pressureForces.set(Vector3D());
-        SphSolver3::accumulatePressureForce(
-            x, ds.constAccessor(), p, _pressureForces.accessor());
-
-        // Compute max density error
-        maxDensityError = 0.0;
-        for (size_t i = 0; i < numberOfParticles; ++i) {
-            maxDensityError = absmax(maxDensityError, _densityErrors[i]);
-        }
+                return result;
+            },
+            [](double a, double b) { return absmax(a, b); },
+            ExecutionPolicy::kParallel, ReductionMode::kDeterministic);
 
         densityErrorRatio = maxDensityError / targetDensity;
         maxNumIter = k + 1;
 
-        if (std::fabs(densityErrorRatio) < _maxDensityErrorRatio) {
+        if (std::fabs(densityErrorRatio) < _maxDensityErrorRatio
+            || maxNumIter == _maxNumberOfIterations) {
+            // Accumulate pressure force
+            parallelFor(
+                kZeroSize,
+                numberOfParticles,
+                [&](size_t i) {
+                    if (!isSleeping(i)) {
+                        f[i] += computePressureForce(
+                            *particles, i, x, ds.constAccessor(), p);
+                    }
+                });
             break;
         }
+
+        // Compute pressure gradient force and predict velocity and position
+        // for the next iteration
+        parallelFor(
+            kZeroSize,
+            numberOfParticles,
+            [&](size_t i) {
+                Vector3D pressureForce;
+                if (!isSleeping(i)) {
+                    pressureForce = computePressureForce(
+                        *particles, i, x, ds.constAccessor(), p);
+                }
+
+                _tempVelocities[i]
+                    = v[i]
+                    + timeIntervalInSeconds / mass
+                    * (f[i] + pressureForce);
+                _tempPositions[i]
+                    = x[i] + timeIntervalInSeconds * _tempVelocities[i];
+            });
     }
 
+    _lastNumberOfIterations = maxNumIter;
+    _lastIterationTimeInSeconds
+        = timer.durationInSeconds() / std::max(maxNumIter, 1u);
+
     JET_INFO << "Number of PCI iterations: " << maxNumIter;
+    JET_INFO << "PCI iteration took " << _lastIterationTimeInSeconds
+             << " seconds";
     JET_INFO << "Max density error after PCI iteration: " << maxDensityError;
     if (std::fabs(densityErrorRatio) > _maxDensityErrorRatio) {
         JET_WARN << "Max density error ratio is greater than the threshold!";
         JET_WARN << "Ratio: " << densityErrorRatio
                  << " Threshold: " << _maxDensityErrorRatio;
     }
-
-    // Accumulate pressure force
-    parallelFor(
-        kZeroSize,
-        numberOfParticles,
-        [this, &f](size_t i) {
-            f[i] += _pressureForces[i];
-        });
 }
 
 void PciSphSolver3::onBeginAdvanceTimeStep(double timeStepInSeconds) {
@@ -173,8 +208,6 @@ void PciSphSolver3::onBeginAdvanceTimeStep(double timeStepInSeconds) {
     size_t numberOfParticles = particleSystemData()->numberOfParticles();
     _tempPositions.resize(numberOfParticles);
     _tempVelocities.resize(numberOfParticles);
-    _pressureForces.resize(numberOfParticles);
-    _densityErrors.resize(numberOfParticles);
 }
 
 double PciSphSolver3::computeDelta(double timeStepInSeconds) {
@@ -223,6 +256,14 @@ double PciSphSolver3::computeBeta(double timeStepInSeconds) {
         / particles->targetDensity());
 }
 
+unsigned int PciSphSolver3::lastNumberOfIterations() const {
+    return _lastNumberOfIterations;
+}
+
+double PciSphSolver3::lastIterationTimeInSeconds() const {
+    return _lastIterationTimeInSeconds;
+}
+
 PciSphSolver3::Builder PciSphSolver3::builder() {
     return Builder();
 }
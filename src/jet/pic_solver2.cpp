@@ -9,6 +9,7 @@
 //
 
 #include <pch.h>
+#include <jet/array_scatter.h>
 #include <jet/array_utils.h>
 #include <jet/level_set_utils.h>
 #include <jet/pic_solver2.h>
@@ -118,18 +119,11 @@ void PicSolver2::transferFromParticlesToGrids() {
     auto velocities = _particles->velocities();
     size_t numberOfParticles = _particles->numberOfParticles();
 
-    // Clear velocity to zero
-    flow->fill(Vector2D());
-
     // Weighted-average velocity
     auto u = flow->uAccessor();
     auto v = flow->vAccessor();
-    Array2<double> uWeight(u.size());
-    Array2<double> vWeight(v.size());
     _uMarkers.resize(u.size());
     _vMarkers.resize(v.size());
-    _uMarkers.set(0);
-    _vMarkers.set(0);
     LinearArraySampler2<double, double> uSampler(
         flow->uConstAccessor(),
         flow->gridSpacing(),
@@ -138,35 +132,17 @@ void PicSolver2::transferFromParticlesToGrids() {
         flow->vConstAccessor(),
         flow->gridSpacing(),
         flow->vOrigin());
-    for (size_t i = 0; i < numberOfParticles; ++i) {
-        std::array<Point2UI, 4> indices;
-        std::array<double, 4> weights;
-
-        uSampler.getCoordinatesAndWeights(positions[i], &indices, &weights);
-        for (int j = 0; j < 4; ++j) {
-            u(indices[j]) += velocities[i].x * weights[j];
-            uWeight(indices[j]) += weights[j];
-            _uMarkers(indices[j]) = 1;
-        }
 
-        vSampler.getCoordinatesAndWeights(positions[i], &indices, &weights);
-        for (int j = 0; j < 4; ++j) {
-            v(indices[j]) += velocities[i].y * weights[j];
-            vWeight(indices[j]) += weights[j];
-            _vMarkers(indices[j]) = 1;
-        }
-    }
+    auto position = [&](size_t i) { return positions[i]; };
 
-    uWeight.parallelForEachIndex([&](size_t i, size_t j) {
-        if (uWeight(i, j) > 0.0) {
-            u(i, j) /= uWeight(i, j);
-        }
-    });
-    vWeight.parallelForEachIndex([&](size_t i, size_t j) {
-        if (vWeight(i, j) > 0.0) {
-            v(i, j) /= vWeight(i, j);
-        }
-    });
+    scatterWeightedAverage(
+        numberOfParticles, uSampler, position,
+        [&](size_t i, const Point2UI&) { return velocities[i].x; },
+        u, _uMarkers.accessor());
+    scatterWeightedAverage(
+        numberOfParticles, vSampler, position,
+        [&](size_t i, const Point2UI&) { return velocities[i].y; },
+        v, _vMarkers.accessor());
 }
 
 void PicSolver2::transferFromGridsToParticles() {
@@ -9,14 +9,27 @@
 //
 
 #include <pch.h>
+#include <jet/array_scatter.h>
 #include <jet/array_utils.h>
+#include <jet/fmm_level_set_solver3.h>
 #include <jet/level_set_utils.h>
 #include <jet/pic_solver3.h>
+#include <jet/semi_lagrangian3.h>
 #include <jet/timer.h>
 #include <algorithm>
+#include <random>
+#include <vector>
 
 using namespace jet;
 
+static const ssize_t kSdfSlabDepth = 4;
+
+static const size_t kNarrowBandParticlesPerCell = 8;
+
+static const size_t kTransferBlockSize = 256;
+
+static const size_t kSortBlockSize = 4096;
+
 PicSolver3::PicSolver3() : PicSolver3({1, 1, 1}, {1, 1, 1}, {0, 0, 0}) {
 }
 
@@ -51,6 +64,43 @@ void PicSolver3::setParticleEmitter(const ParticleEmitter3Ptr& newEmitter) {
     newEmitter->setTarget(_particles);
 }
 
+unsigned int PicSolver3::particleSortingInterval() const {
+    return _particleSortingInterval;
+}
+
+void PicSolver3::setParticleSortingInterval(unsigned int newInterval) {
+    _particleSortingInterval = newInterval;
+    _numberOfStepsSinceSort = 0;
+}
+
+bool PicSolver3::removesParticlesOutsideDomain() const {
+    return _removesParticlesOutsideDomain;
+}
+
+void PicSolver3::setRemovesParticlesOutsideDomain(bool onoff) {
+    _removesParticlesOutsideDomain = onoff;
+}
+
+bool PicSolver3::isUsingNarrowBand() const {
+    return _isUsingNarrowBand;
+}
+
+void PicSolver3::setIsUsingNarrowBand(bool onoff) {
+    _isUsingNarrowBand = onoff;
+    if (!onoff) {
+        _liquidSdf.clear();
+        _liquidVelocity.clear();
+    }
+}
+
+double PicSolver3::narrowBandWidth() const {
+    return _narrowBandWidth;
+}
+
+void PicSolver3::setNarrowBandWidth(double newWidth) {
+    _narrowBandWidth = std::max(newWidth, 1.0);
+}
+
 void PicSolver3::onInitialize() {
     GridFluidSolver3::onInitialize();
 
@@ -74,6 +124,23 @@ void PicSolver3::onBeginAdvanceTimeStep(double timeIntervalInSeconds) {
     JET_INFO << "Number of PIC-type particles: "
              << _particles->numberOfParticles();
 
+    if (_removesParticlesOutsideDomain) {
+        timer.reset();
+        removeParticlesOutsideDomain();
+        JET_INFO << "removeParticlesOutsideDomain took "
+                 << timer.durationInSeconds() << " seconds";
+
+        JET_INFO << "Number of PIC-type particles: "
+                 << _particles->numberOfParticles();
+    }
+
+    // Reorder particles periodically for better memory locality
+    if (_particleSortingInterval > 0
+        && ++_numberOfStepsSinceSort >= _particleSortingInterval) {
+        sortParticles();
+        _numberOfStepsSinceSort = 0;
+    }
+
     timer.reset();
     transferFromParticlesToGrids();
     JET_INFO << "transferFromParticlesToGrids took "
@@ -109,6 +176,17 @@ void PicSolver3::computeAdvection(double timeIntervalInSeconds) {
     moveParticles(timeIntervalInSeconds);
     JET_INFO << "moveParticles took "
              << timer.durationInSeconds() << " seconds";
+
+    if (_isUsingNarrowBand) {
+        timer.reset();
+        advectLiquidInterior(timeIntervalInSeconds);
+        updateNarrowBandParticles();
+        JET_INFO << "updateNarrowBandParticles took "
+                 << timer.durationInSeconds() << " seconds";
+
+        JET_INFO << "Number of PIC-type particles: "
+                 << _particles->numberOfParticles();
+    }
 }
 
 ScalarField3Ptr PicSolver3::fluidSdf() const {
@@ -121,22 +199,13 @@ void PicSolver3::transferFromParticlesToGrids() {
     auto velocities = _particles->velocities();
     size_t numberOfParticles = _particles->numberOfParticles();
 
-    // Clear velocity to zero
-    flow->fill(Vector3D());
-
     // Weighted-average velocity
     auto u = flow->uAccessor();
     auto v = flow->vAccessor();
     auto w = flow->wAccessor();
-    Array3<double> uWeight(u.size());
-    Array3<double> vWeight(v.size());
-    Array3<double> wWeight(w.size());
     _uMarkers.resize(u.size());
     _vMarkers.resize(v.size());
     _wMarkers.resize(w.size());
-    _uMarkers.set(0);
-    _vMarkers.set(0);
-    _wMarkers.set(0);
     LinearArraySampler3<double, double> uSampler(
         flow->uConstAccessor(),
         flow->gridSpacing(),
@@ -149,47 +218,23 @@ void PicSolver3::transferFromParticlesToGrids() {
         flow->wConstAccessor(),
         flow->gridSpacing(),
         flow->wOrigin());
-    for (size_t i = 0; i < numberOfParticles; ++i) {
-        std::array<Point3UI, 8> indices;
-        std::array<double, 8> weights;
-
-        uSampler.getCoordinatesAndWeights(positions[i], &indices, &weights);
-        for (int j = 0; j < 8; ++j) {
-            u(indices[j]) += velocities[i].x * weights[j];
-            uWeight(indices[j]) += weights[j];
-            _uMarkers(indices[j]) = 1;
-        }
-
-        vSampler.getCoordinatesAndWeights(positions[i], &indices, &weights);
-        for (int j = 0; j < 8; ++j) {
-            v(indices[j]) += velocities[i].y * weights[j];
-            vWeight(indices[j]) += weights[j];
-            _vMarkers(indices[j]) = 1;
-        }
 
-        wSampler.getCoordinatesAndWeights(positions[i], &indices, &weights);
-        for (int j = 0; j < 8; ++j) {
-            w(indices[j]) += velocities[i].z * weights[j];
-            wWeight(indices[j]) += weights[j];
-            _wMarkers(indices[j]) = 1;
-        }
-    }
-
-    uWeight.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        if (uWeight(i, j, k) > 0.0) {
-            u(i, j, k) /= uWeight(i, j, k);
-        }
-    });
-    vWeight.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        if (vWeight(i, j, k) > 0.0) {
-            v(i, j, k) /= vWeight(i, j, k);
-        }
-    });
-    wWeight.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        if (wWeight(i, j, k) > 0.0) {
-            w(i, j, k) /= wWeight(i, j, k);
-        }
-    });
+    auto position = [&](size_t i) { return positions[i]; };
+
+    scatterWeightedAverage(
+        numberOfParticles, uSampler, position,
+        [&](size_t i, const Point3UI&) { return velocities[i].x; },
+        u, _uMarkers.accessor());
+    scatterWeightedAverage(
+        numberOfParticles, vSampler, position,
+        [&](size_t i, const Point3UI&) { return velocities[i].y; },
+        v, _vMarkers.accessor());
+    scatterWeightedAverage(
+        numberOfParticles, wSampler, position,
+        [&](size_t i, const Point3UI&) { return velocities[i].z; },
+        w, _wMarkers.accessor());
+
+    transferFromLiquidInteriorToGrids();
 }
 
 void PicSolver3::transferFromGridsToParticles() {
@@ -197,10 +242,40 @@ void PicSolver3::transferFromGridsToParticles() {
     auto positions = _particles->positions();
     auto velocities = _particles->velocities();
     size_t numberOfParticles = _particles->numberOfParticles();
+    const auto& uSampler = flow->uLinearSampler();
+    const auto& vSampler = flow->vLinearSampler();
+    const auto& wSampler = flow->wLinearSampler();
+
+    // Sample each component in fixed-size batches into stack buffers
+    parallelRangeFor(
+        kZeroSize, numberOfParticles, [&](size_t begin, size_t end) {
+            double u[kTransferBlockSize];
+            double v[kTransferBlockSize];
+            double w[kTransferBlockSize];
+
+            for (size_t b = begin; b < end; b += kTransferBlockSize) {
+                const size_t n = std::min(kTransferBlockSize, end - b);
+                ConstArrayAccessor1<Vector3D> x(n, positions.data() + b);
+                uSampler.sample(x, ArrayAccessor1<double>(n, u));
+                vSampler.sample(x, ArrayAccessor1<double>(n, v));
+                wSampler.sample(x, ArrayAccessor1<double>(n, w));
+
+                for (size_t i = 0; i < n; ++i) {
+                    velocities[b + i] = Vector3D(u[i], v[i], w[i]);
+                }
+            }
+        });
+}
 
-    parallelFor(kZeroSize, numberOfParticles, [&](size_t i) {
-        velocities[i] = flow->sample(positions[i]);
-    });
+void PicSolver3::sortParticles() {
+    Timer timer;
+    _particles->sortParticles();
+    JET_INFO << "sortParticles took "
+             << timer.durationInSeconds() << " seconds";
+}
+
+void PicSolver3::removeParticles(const ConstArrayAccessor1<char>& mask) {
+    _particles->removeParticles(mask);
 }
 
 void PicSolver3::moveParticles(double timeIntervalInSeconds) {
@@ -211,6 +286,14 @@ void PicSolver3::moveParticles(double timeIntervalInSeconds) {
     int domainBoundaryFlag = closedDomainBoundaryFlag();
     BoundingBox3D boundingBox = flow->boundingBox();
 
+    // Statically typed samplers so that the RK2 loop can be inlined
+    const auto& uSampler = flow->uLinearSampler();
+    const auto& vSampler = flow->vLinearSampler();
+    const auto& wSampler = flow->wLinearSampler();
+    auto sampleFlow = [&](const Vector3D& x) {
+        return Vector3D(uSampler(x), vSampler(x), wSampler(x));
+    };
+
     parallelFor(kZeroSize, numberOfParticles, [&](size_t i) {
         Vector3D pt0 = positions[i];
         Vector3D pt1 = pt0;
@@ -221,11 +304,11 @@ void PicSolver3::moveParticles(double timeIntervalInSeconds) {
             = static_cast<unsigned int>(std::max(maxCfl(), 1.0));
         double dt = timeIntervalInSeconds / numSubSteps;
         for (unsigned int t = 0; t < numSubSteps; ++t) {
-            Vector3D vel0 = flow->sample(pt0);
+            Vector3D vel0 = sampleFlow(pt0);
 
             // Mid-point rule
             Vector3D midPt = pt0 + 0.5 * dt * vel0;
-            Vector3D midVel = flow->sample(midPt);
+            Vector3D midVel = sampleFlow(midPt);
             pt1 = pt0 + dt * midVel;
 
             pt0 = pt1;
@@ -295,25 +378,191 @@ void PicSolver3::extrapolateVelocityToAir() {
 
 void PicSolver3::buildSignedDistanceField() {
     auto sdf = signedDistanceField();
-    auto sdfPos = sdf->dataPosition();
-    double maxH = max3(
-        sdf->gridSpacing().x, sdf->gridSpacing().y, sdf->gridSpacing().z);
+    auto sdfData = sdf->dataAccessor();
+    const Vector3D h = sdf->gridSpacing();
+    const Vector3D o = sdf->dataOrigin();
+    const Size3 res = sdf->dataSize();
+    double maxH = max3(h.x, h.y, h.z);
     double radius = 1.2 * maxH / std::sqrt(2.0);
     double sdfBandRadius = 2.0 * radius;
 
-    _particles->buildNeighborSearcher(2 * radius);
-    auto searcher = _particles->neighborSearcher();
-    sdf->parallelForEachDataPointIndex([&] (size_t i, size_t j, size_t k) {
-        Vector3D pt = sdfPos(i, j, k);
-        double minDist = sdfBandRadius;
-        searcher->forEachNearbyPoint(
-            pt, sdfBandRadius, [&] (size_t, const Vector3D& x) {
-                minDist = std::min(minDist, pt.distanceTo(x));
-            });
-        (*sdf)(i, j, k) = minDist - radius;
+    if (res.x == 0 || res.y == 0 || res.z == 0) {
+        return;
+    }
+
+    // Instead of querying the particles around each cell, each particle
+    // splats its distance to the cells within the band. The grid is split
+    // into z-slabs which are at least as deep as the band so that a slab only
+    // receives the particles binned to itself and its two neighbors. Each
+    // slab is owned by a single task, so the min-reduction needs no atomics
+    // and the result does not depend on the number of threads.
+    const ssize_t bandDepth
+        = static_cast<ssize_t>(std::ceil(sdfBandRadius / h.z)) + 1;
+    const ssize_t slabDepth = std::max(bandDepth, kSdfSlabDepth);
+    const ssize_t numberOfSlabs
+        = (static_cast<ssize_t>(res.z) + slabDepth - 1) / slabDepth;
+
+    auto positions = _particles->positions();
+    size_t numberOfParticles = _particles->numberOfParticles();
+
+    auto slabIndex = [&](const Vector3D& x) {
+        double k = std::floor((x.z - o.z) / h.z);
+        k = clamp(k, 0.0, static_cast<double>(res.z - 1));
+        return static_cast<ssize_t>(k) / slabDepth;
+    };
+
+    // Counting sort of the particles by the slab index. Each block of
+    // particles counts its slab histogram, the histograms are scanned in the
+    // slab-major order, and each block scatters its indices independently.
+    // The block size is fixed, so the order does not depend on the number of
+    // threads.
+    const size_t numberOfBlocks
+        = (numberOfParticles + kSortBlockSize - 1) / kSortBlockSize;
+    const size_t slabCount = static_cast<size_t>(numberOfSlabs);
+    std::vector<size_t> blockOffsets(numberOfBlocks * slabCount, 0);
+    parallelFor(kZeroSize, numberOfBlocks, [&](size_t b) {
+        const size_t pEnd
+            = std::min((b + 1) * kSortBlockSize, numberOfParticles);
+        size_t* counts = blockOffsets.data() + b * slabCount;
+        for (size_t p = b * kSortBlockSize; p < pEnd; ++p) {
+            ++counts[slabIndex(positions[p])];
+        }
+    });
+
+    std::vector<size_t> slabOffsets(slabCount + 1, 0);
+    for (size_t s = 0; s < slabCount; ++s) {
+        size_t offset = slabOffsets[s];
+        for (size_t b = 0; b < numberOfBlocks; ++b) {
+            const size_t count = blockOffsets[b * slabCount + s];
+            blockOffsets[b * slabCount + s] = offset;
+            offset += count;
+        }
+        slabOffsets[s + 1] = offset;
+    }
+
+    std::vector<size_t> slabParticles(numberOfParticles);
+    parallelFor(kZeroSize, numberOfBlocks, [&](size_t b) {
+        const size_t pEnd
+            = std::min((b + 1) * kSortBlockSize, numberOfParticles);
+        size_t* cursors = blockOffsets.data() + b * slabCount;
+        for (size_t p = b * kSortBlockSize; p < pEnd; ++p) {
+            slabParticles[cursors[slabIndex(positions[p])]++] = p;
+        }
     });
 
+    // The squared distances are min-reduced and converted at the end, which
+    // gives the same result as reducing the distances.
+    const double sdfBandRadiusSquared = square(sdfBandRadius);
+
+    parallelFor(kZeroSize, static_cast<size_t>(numberOfSlabs), [&](size_t s) {
+        const ssize_t iEnd = static_cast<ssize_t>(res.x);
+        const ssize_t jEnd = static_cast<ssize_t>(res.y);
+        const ssize_t kBegin = static_cast<ssize_t>(s) * slabDepth;
+        const ssize_t kEnd
+            = std::min(kBegin + slabDepth, static_cast<ssize_t>(res.z));
+
+        for (ssize_t k = kBegin; k < kEnd; ++k) {
+            for (ssize_t j = 0; j < jEnd; ++j) {
+                for (ssize_t i = 0; i < iEnd; ++i) {
+                    sdfData(i, j, k) = sdfBandRadiusSquared;
+                }
+            }
+        }
+
+        const ssize_t sBegin
+            = std::max(static_cast<ssize_t>(s) - 1, kZeroSSize);
+        const ssize_t sEnd = std::min(static_cast<ssize_t>(s) + 2,
+                                      numberOfSlabs);
+        for (size_t n = slabOffsets[sBegin]; n < slabOffsets[sEnd]; ++n) {
+            const Vector3D& x = positions[slabParticles[n]];
+            const Vector3D lower = (x - o - sdfBandRadius) / h;
+            const Vector3D upper = (x - o + sdfBandRadius) / h;
+
+            const ssize_t i0 = std::max(
+                static_cast<ssize_t>(std::ceil(lower.x)), kZeroSSize);
+            const ssize_t i1 = std::min(
+                static_cast<ssize_t>(std::floor(upper.x)), iEnd - 1);
+            const ssize_t j0 = std::max(
+                static_cast<ssize_t>(std::ceil(lower.y)), kZeroSSize);
+            const ssize_t j1 = std::min(
+                static_cast<ssize_t>(std::floor(upper.y)), jEnd - 1);
+            const ssize_t k0 = std::max(
+                static_cast<ssize_t>(std::ceil(lower.z)), kBegin);
+            const ssize_t k1 = std::min(
+                static_cast<ssize_t>(std::floor(upper.z)), kEnd - 1);
+
+            for (ssize_t k = k0; k <= k1; ++k) {
+                const double dz = o.z + h.z * k - x.z;
+                for (ssize_t j = j0; j <= j1; ++j) {
+                    const double dy = o.y + h.y * j - x.y;
+                    for (ssize_t i = i0; i <= i1; ++i) {
+                        const double dx = o.x + h.x * i - x.x;
+                        double& minDistSquared = sdfData(i, j, k);
+                        minDistSquared = std::min(
+                            minDistSquared, dx * dx + dy * dy + dz * dz);
+                    }
+                }
+            }
+        }
+
+        for (ssize_t k = kBegin; k < kEnd; ++k) {
+            for (ssize_t j = 0; j < jEnd; ++j) {
+                for (ssize_t i = 0; i < iEnd; ++i) {
+                    sdfData(i, j, k) = std::sqrt(sdfData(i, j, k)) - radius;
+                }
+            }
+        }
+    });
+
+    // Below the narrow band, the liquid is given by the interior level set
+    if (_isUsingNarrowBand && hasLiquidInterior()) {
+        const double bandWidth = narrowBandWidthInMeters();
+        auto liquidSdf = _liquidSdf.constDataAccessor();
+        sdf->parallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+            if (liquidSdf(i, j, k) < -bandWidth) {
+                sdfData(i, j, k)
+                    = std::min(sdfData(i, j, k), liquidSdf(i, j, k));
+            }
+        });
+    }
+
     extrapolateIntoCollider(sdf.get());
+
+    if (_isUsingNarrowBand) {
+        reinitializeLiquidSdf();
+    }
+}
+
+void PicSolver3::transferFromLiquidInteriorToGrids() {
+    if (!_isUsingNarrowBand || !hasLiquidInterior()
+        || !_liquidVelocity.hasSameShape(*gridSystemData()->velocity())) {
+        return;
+    }
+
+    auto flow = gridSystemData()->velocity();
+    const double h = max3(flow->gridSpacing().x, flow->gridSpacing().y,
+                          flow->gridSpacing().z);
+    const auto& liquidSdf = _liquidSdf;
+
+    // Faces within a cell below the surface are taken as the interior
+    auto fill = [&](ArrayAccessor3<double> dst,
+                    ConstArrayAccessor3<double> src,
+                    ArrayAccessor3<char> markers,
+                    const FaceCenteredGrid3::DataPositionFunc& pos) {
+        dst.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+            if (!markers(i, j, k) && liquidSdf.sample(pos(i, j, k)) < -h) {
+                dst(i, j, k) = src(i, j, k);
+                markers(i, j, k) = 1;
+            }
+        });
+    };
+
+    fill(flow->uAccessor(), _liquidVelocity.uConstAccessor(),
+         _uMarkers.accessor(), flow->uPosition());
+    fill(flow->vAccessor(), _liquidVelocity.vConstAccessor(),
+         _vMarkers.accessor(), flow->vPosition());
+    fill(flow->wAccessor(), _liquidVelocity.wConstAccessor(),
+         _wMarkers.accessor(), flow->wPosition());
 }
 
 void PicSolver3::updateParticleEmitter(double timeIntervalInSeconds) {
@@ -322,6 +571,178 @@ void PicSolver3::updateParticleEmitter(double timeIntervalInSeconds) {
     }
 }
 
+void PicSolver3::removeParticlesOutsideDomain() {
+    BoundingBox3D domain = gridSystemData()->boundingBox();
+    auto positions = _particles->positions();
+    size_t numberOfParticles = _particles->numberOfParticles();
+
+    Array1<char> mask(numberOfParticles);
+    parallelFor(kZeroSize, numberOfParticles, [&](size_t i) {
+        mask[i] = domain.contains(positions[i]) ? 0 : 1;
+    });
+
+    removeParticles(mask.constAccessor());
+}
+
+bool PicSolver3::hasLiquidInterior() const {
+    return _liquidSdf.hasSameShape(*signedDistanceField());
+}
+
+double PicSolver3::narrowBandWidthInMeters() const {
+    const Vector3D h = signedDistanceField()->gridSpacing();
+    return _narrowBandWidth * max3(h.x, h.y, h.z);
+}
+
+void PicSolver3::reinitializeLiquidSdf() {
+    auto sdf = signedDistanceField();
+    const Size3 res = sdf->dataSize();
+    const Vector3D h = sdf->gridSpacing();
+
+    // Only the distances up to slightly beyond the band are needed. Clamping
+    // the cells away from the surface lets the fast marching stop there.
+    const double maxDistance
+        = narrowBandWidthInMeters() + 2.0 * max3(h.x, h.y, h.z);
+
+    CellCenteredScalarGrid3 clamped(
+        sdf->resolution(), sdf->gridSpacing(), sdf->origin());
+    auto input = sdf->constDataAccessor();
+    auto output = clamped.dataAccessor();
+    clamped.parallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        const bool inside = isInsideSdf(input(i, j, k));
+        output(i, j, k) = input(i, j, k);
+        if ((i > 0 && isInsideSdf(input(i - 1, j, k)) != inside) ||
+            (i + 1 < res.x && isInsideSdf(input(i + 1, j, k)) != inside) ||
+            (j > 0 && isInsideSdf(input(i, j - 1, k)) != inside) ||
+            (j + 1 < res.y && isInsideSdf(input(i, j + 1, k)) != inside) ||
+            (k > 0 && isInsideSdf(input(i, j, k - 1)) != inside) ||
+            (k + 1 < res.z && isInsideSdf(input(i, j, k + 1)) != inside)) {
+            return;
+        }
+        output(i, j, k) = inside ? -maxDistance : maxDistance;
+    });
+
+    _liquidSdf.resize(sdf->resolution(), sdf->gridSpacing(), sdf->origin());
+    FmmLevelSetSolver3 levelSetSolver;
+    levelSetSolver.reinitialize(clamped, maxDistance, &_liquidSdf);
+}
+
+void PicSolver3::advectLiquidInterior(double timeIntervalInSeconds) {
+    if (!hasLiquidInterior()) {
+        return;
+    }
+
+    auto flow = gridSystemData()->velocity();
+    AdvectionSolver3Ptr solver = advectionSolver();
+    if (solver == nullptr) {
+        solver = std::make_shared<SemiLagrangian3>();
+    }
+
+    CellCenteredScalarGrid3 liquidSdf0(_liquidSdf);
+    solver->advect(liquidSdf0, *flow, timeIntervalInSeconds, &_liquidSdf,
+                   *colliderSdf());
+    extrapolateIntoCollider(&_liquidSdf);
+
+    _liquidVelocity.resize(flow->resolution(), flow->gridSpacing(),
+                           flow->origin());
+    solver->advect(*flow, *flow, timeIntervalInSeconds, &_liquidVelocity,
+                   *colliderSdf());
+}
+
+void PicSolver3::updateNarrowBandParticles() {
+    if (!hasLiquidInterior()) {
+        return;
+    }
+
+    const double bandWidth = narrowBandWidthInMeters();
+    auto positions = _particles->positions();
+    size_t numberOfParticles = _particles->numberOfParticles();
+    const auto& liquidSdf = _liquidSdf;
+
+    // Remove the particles below the band
+    Array1<char> mask(numberOfParticles);
+    parallelFor(kZeroSize, numberOfParticles, [&](size_t i) {
+        mask[i] = (liquidSdf.sample(positions[i]) < -bandWidth) ? 1 : 0;
+    });
+    removeParticles(mask.constAccessor());
+
+    // Resample the band cells left without particles, which happens when the
+    // band moves into the former interior
+    const Size3 res = _liquidSdf.dataSize();
+    const Vector3D h = _liquidSdf.gridSpacing();
+    const Vector3D o = _liquidSdf.origin();
+    const double maxH = max3(h.x, h.y, h.z);
+    auto liquidSdfData = _liquidSdf.constDataAccessor();
+
+    positions = _particles->positions();
+    numberOfParticles = _particles->numberOfParticles();
+
+    // Threads sharing a cell only ever store the same flag value
+    Array3<char> isOccupied(res);
+    parallelFor(kZeroSize, numberOfParticles, [&](size_t n) {
+        Vector3D idx = (positions[n] - o) / h;
+        if (idx.x >= 0.0 && idx.y >= 0.0 && idx.z >= 0.0 &&
+            idx.x < res.x && idx.y < res.y && idx.z < res.z) {
+            isOccupied(static_cast<size_t>(idx.x), static_cast<size_t>(idx.y),
+                       static_cast<size_t>(idx.z)) = 1;
+        }
+    });
+
+    // Seed the empty band cells slice by slice in parallel. Each cell draws
+    // from its own generator seeded by the cell and the step, and the slices
+    // are concatenated in order, so the result does not depend on the number
+    // of threads.
+    auto flow = gridSystemData()->velocity();
+    auto colliderSdfField = colliderSdf();
+    std::vector<Array1<Vector3D>> slicePositions(res.z);
+    std::vector<Array1<Vector3D>> sliceVelocities(res.z);
+    parallelFor(kZeroSize, res.z, [&](size_t k) {
+        for (size_t j = 0; j < res.y; ++j) {
+            for (size_t i = 0; i < res.x; ++i) {
+                const double phi = liquidSdfData(i, j, k);
+                if (isOccupied(i, j, k) || phi >= -maxH
+                    || phi < -bandWidth) {
+                    continue;
+                }
+
+                std::minstd_rand rng(static_cast<uint32_t>(
+                    ((k * res.y + j) * res.x + i) * 2654435761u
+                    + _numberOfNarrowBandSteps));
+                std::uniform_real_distribution<> d(0.0, 1.0);
+                for (size_t n = 0; n < kNarrowBandParticlesPerCell; ++n) {
+                    // Draw in a fixed order since the evaluation order of
+                    // function arguments is unspecified
+                    const double rx = d(rng);
+                    const double ry = d(rng);
+                    const double rz = d(rng);
+                    Vector3D x = o + h * Vector3D(i + rx, j + ry, k + rz);
+                    if (isInsideSdf(colliderSdfField->sample(x))) {
+                        continue;
+                    }
+                    slicePositions[k].append(x);
+                    sliceVelocities[k].append(flow->sample(x));
+                }
+            }
+        }
+    });
+
+    Array1<size_t> sliceOffsets(res.z + 1, 0);
+    for (size_t k = 0; k < res.z; ++k) {
+        sliceOffsets[k + 1] = sliceOffsets[k] + slicePositions[k].size();
+    }
+
+    Array1<Vector3D> newPositions(sliceOffsets[res.z]);
+    Array1<Vector3D> newVelocities(sliceOffsets[res.z]);
+    parallelFor(kZeroSize, res.z, [&](size_t k) {
+        std::copy(slicePositions[k].begin(), slicePositions[k].end(),
+                  newPositions.begin() + sliceOffsets[k]);
+        std::copy(sliceVelocities[k].begin(), sliceVelocities[k].end(),
+                  newVelocities.begin() + sliceOffsets[k]);
+    });
+    ++_numberOfNarrowBandSteps;
+
+    _particles->addParticles(newPositions, newVelocities);
+}
+
 PicSolver3::Builder PicSolver3::builder() {
     return Builder();
 }
@@ -149,11 +149,41 @@ void PointParallelHashGridSearcher3::forEachNearbyPoint(
     const Vector3D& origin,
     double radius,
     const ForEachNearbyPointFunc& callback) const {
+    const double queryRadiusSquared = radius * radius;
+
+    // The search sphere may span more than 2 buckets per axis
+    if (2.0 * radius > _gridSpacing) {
+        Point3I lower, upper;
+        getNearbyBucketRange(origin, radius, &lower, &upper);
+
+        Point3I cell;
+        for (cell.z = lower.z; cell.z <= upper.z; ++cell.z) {
+            for (cell.y = lower.y; cell.y <= upper.y; ++cell.y) {
+                for (cell.x = lower.x; cell.x <= upper.x; ++cell.x) {
+                    size_t key = getHashKeyFromBucketIndex(cell);
+                    size_t start = _startIndexTable[key];
+                    size_t end = _endIndexTable[key];
+
+                    // Empty bucket -- continue to next bucket
+                    if (start == kMaxSize) {
+                        continue;
+                    }
+
+                    for (size_t j = start; j < end; ++j) {
+                        if (_points[j].distanceSquaredTo(origin)
+                            <= queryRadiusSquared) {
+                            callback(_sortedIndices[j], _points[j]);
+                        }
+                    }
+                }
+            }
+        }
+        return;
+    }
+
     size_t nearbyKeys[8];
     getNearbyKeys(origin, nearbyKeys);
 
-    const double queryRadiusSquared = radius * radius;
-
     for (int i = 0; i < 8; i++) {
         size_t nearbyKey = nearbyKeys[i];
         size_t start = _startIndexTable[nearbyKey];
@@ -183,11 +213,41 @@ void PointParallelHashGridSearcher3::forEachNearbyPoint(
 bool PointParallelHashGridSearcher3::hasNearbyPoint(
     const Vector3D& origin,
     double radius) const {
+    const double queryRadiusSquared = radius * radius;
+
+    // The search sphere may span more than 2 buckets per axis
+    if (2.0 * radius > _gridSpacing) {
+        Point3I lower, upper;
+        getNearbyBucketRange(origin, radius, &lower, &upper);
+
+        Point3I cell;
+        for (cell.z = lower.z; cell.z <= upper.z; ++cell.z) {
+            for (cell.y = lower.y; cell.y <= upper.y; ++cell.y) {
+                for (cell.x = lower.x; cell.x <= upper.x; ++cell.x) {
+                    size_t key = getHashKeyFromBucketIndex(cell);
+                    size_t start = _startIndexTable[key];
+                    size_t end = _endIndexTable[key];
+
+                    // Empty bucket -- continue to next bucket
+                    if (start == kMaxSize) {
+                        continue;
+                    }
+
+                    for (size_t j = start; j < end; ++j) {
+                        if (_points[j].distanceSquaredTo(origin)
+                            <= queryRadiusSquared) {
+                            return true;
+                        }
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
     size_t nearbyKeys[8];
     getNearbyKeys(origin, nearbyKeys);
 
-    const double queryRadiusSquared = radius * radius;
-
     for (int i = 0; i < 8; i++) {
         size_t nearbyKey = nearbyKeys[i];
         size_t start = _startIndexTable[nearbyKey];
@@ -210,6 +270,20 @@ bool PointParallelHashGridSearcher3::hasNearbyPoint(
     return false;
 }
 
+double PointParallelHashGridSearcher3::gridSpacing() const {
+    return _gridSpacing;
+}
+
+Size3 PointParallelHashGridSearcher3::resolution() const {
+    return Size3(static_cast<size_t>(_resolution.x),
+                 static_cast<size_t>(_resolution.y),
+                 static_cast<size_t>(_resolution.z));
+}
+
+const std::vector<Vector3D>& PointParallelHashGridSearcher3::points() const {
+    return _points;
+}
+
 const std::vector<size_t>& PointParallelHashGridSearcher3::keys() const {
     return _keys;
 }
@@ -318,6 +392,20 @@ void PointParallelHashGridSearcher3::getNearbyKeys(
     }
 }
 
+void PointParallelHashGridSearcher3::getNearbyBucketRange(
+    const Vector3D& position,
+    double radius,
+    Point3I* lower,
+    Point3I* upper) const {
+    *lower = getBucketIndex(position - Vector3D(radius, radius, radius));
+    *upper = getBucketIndex(position + Vector3D(radius, radius, radius));
+
+    // Visit each wrapped bucket only once
+    upper->x = std::min(upper->x, lower->x + _resolution.x - 1);
+    upper->y = std::min(upper->y, lower->y + _resolution.y - 1);
+    upper->z = std::min(upper->z, lower->z + _resolution.z - 1);
+}
+
 PointNeighborSearcher3Ptr PointParallelHashGridSearcher3::clone() const {
     return CLONE_W_CUSTOM_DELETER(PointParallelHashGridSearcher3);
 }
@@ -0,0 +1,698 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifdef _MSC_VER
+#pragma warning(disable: 4244)
+#endif
+
+#include <pch.h>
+#include <fbs_helpers.h>
+#include <generated/point_sparse_hash_grid_searcher3_generated.h>
+
+#include <jet/bounding_box3.h>
+#include <jet/constants.h>
+#include <jet/parallel.h>
+#include <jet/point_sparse_hash_grid_searcher3.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+using namespace jet;
+
+// Maximum load factor of the hash table is 1 / kHashTableSizeFactor
+static const size_t kHashTableSizeFactor = 2;
+
+// Cell index range per axis that can be packed into a 64-bit sort key
+static const ssize_t kMaxPackedCellIndex = (1 << 21);
+
+// A dense cell table is used if the bounding box of the occupied cells has at
+// most kDenseTableSizeFactor times as many cells as the occupied ones. With two
+// indices per cell, the dense table is then smaller than the hash table, and
+// the lookup needs no hashing or probing.
+static const size_t kDenseTableSizeFactor = 4;
+
+// Number of points per block when the occupied cells are compacted
+static const size_t kCompactionBlockSize = 4096;
+
+inline size_t hashCell(const Point3I& cell) {
+    uint64_t h = static_cast<uint64_t>(cell.x) * 73856093ULL
+               ^ static_cast<uint64_t>(cell.y) * 19349663ULL
+               ^ static_cast<uint64_t>(cell.z) * 83492791ULL;
+
+    // Mix the bits so that the lower bits can be used as the table index
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return static_cast<size_t>(h);
+}
+
+inline bool isCellLess(const Point3I& a, const Point3I& b) {
+    if (a.z != b.z) {
+        return a.z < b.z;
+    }
+    if (a.y != b.y) {
+        return a.y < b.y;
+    }
+    return a.x < b.x;
+}
+
+PointSparseHashGridSearcher3::PointSparseHashGridSearcher3(
+    double gridSpacing) :
+    _gridSpacing(gridSpacing) {
+}
+
+PointSparseHashGridSearcher3::PointSparseHashGridSearcher3(
+    const PointSparseHashGridSearcher3& other) {
+    set(other);
+}
+
+void PointSparseHashGridSearcher3::build(
+    const ConstArrayAccessor1<Vector3D>& points) {
+    size_t numberOfPoints = points.size();
+    _sortedIndices.resize(numberOfPoints);
+    _points.resize(numberOfPoints);
+
+    if (numberOfPoints > 0) {
+        BoundingBox3D bound = parallelReduce(
+            kZeroSize, numberOfPoints, BoundingBox3D(),
+            [&](size_t iBegin, size_t iEnd, BoundingBox3D init) {
+                for (size_t i = iBegin; i < iEnd; ++i) {
+                    init.merge(points[i]);
+                }
+                return init;
+            },
+            [](BoundingBox3D a, const BoundingBox3D& b) {
+                a.merge(b);
+                return a;
+            });
+
+        Point3I lower = getBucketIndex(bound.lowerCorner);
+        Point3I upper = getBucketIndex(bound.upperCorner);
+
+        // Sort indices based on the grid cell in (z, y, x) order. Ties are
+        // broken by the index so that the order is deterministic.
+        if (upper.x - lower.x < kMaxPackedCellIndex &&
+            upper.y - lower.y < kMaxPackedCellIndex &&
+            upper.z - lower.z < kMaxPackedCellIndex) {
+            // Common case: pack the cell index into a single 64-bit key
+            std::vector<std::pair<uint64_t, size_t>> keys(numberOfPoints);
+            parallelFor(
+                kZeroSize,
+                numberOfPoints,
+                [&](size_t i) {
+                    Point3I cell = getBucketIndex(points[i]);
+                    uint64_t x = static_cast<uint64_t>(cell.x - lower.x);
+                    uint64_t y = static_cast<uint64_t>(cell.y - lower.y);
+                    uint64_t z = static_cast<uint64_t>(cell.z - lower.z);
+                    keys[i] = std::make_pair((z << 42) | (y << 21) | x, i);
+                });
+
+            parallelSort(keys.begin(), keys.end());
+
+            parallelFor(
+                kZeroSize,
+                numberOfPoints,
+                [&](size_t i) {
+                    _sortedIndices[i] = keys[i].second;
+                });
+        } else {
+            std::vector<Point3I> cells(numberOfPoints);
+            parallelFor(
+                kZeroSize,
+                numberOfPoints,
+                [&](size_t i) {
+                    _sortedIndices[i] = i;
+                    cells[i] = getBucketIndex(points[i]);
+                });
+
+            parallelSort(
+                _sortedIndices.begin(),
+                _sortedIndices.end(),
+                [&cells](size_t indexA, size_t indexB) {
+                    if (cells[indexA] == cells[indexB]) {
+                        return indexA < indexB;
+                    }
+                    return isCellLess(cells[indexA], cells[indexB]);
+                });
+        }
+
+        // Re-order point array
+        parallelFor(
+            kZeroSize,
+            numberOfPoints,
+            [&](size_t i) {
+                _points[i] = points[_sortedIndices[i]];
+            });
+    }
+
+    buildBuckets();
+}
+
+void PointSparseHashGridSearcher3::buildBuckets() {
+    // Now _points are sorted by the grid cells. Let's find the range of each
+    // occupied cell and insert it into the cell table.
+    size_t numberOfPoints = _points.size();
+    std::vector<Point3I> cells(numberOfPoints);
+    parallelFor(
+        kZeroSize,
+        numberOfPoints,
+        [&](size_t i) {
+            cells[i] = getBucketIndex(_points[i]);
+        });
+
+    auto isFirstOfCell = [&](size_t i) {
+        return i == 0 || !(cells[i - 1] == cells[i]);
+    };
+
+    // Compact the first point of each cell with fixed-size blocks
+    const size_t numberOfBlocks
+        = (numberOfPoints + kCompactionBlockSize - 1) / kCompactionBlockSize;
+    std::vector<size_t> offsets(numberOfBlocks + 1, 0);
+    parallelFor(kZeroSize, numberOfBlocks, [&](size_t b) {
+        const size_t iEnd
+            = std::min((b + 1) * kCompactionBlockSize, numberOfPoints);
+        size_t count = 0;
+        for (size_t i = b * kCompactionBlockSize; i < iEnd; ++i) {
+            count += isFirstOfCell(i) ? 1 : 0;
+        }
+        offsets[b + 1] = count;
+    });
+
+    for (size_t b = 0; b < numberOfBlocks; ++b) {
+        offsets[b + 1] += offsets[b];
+    }
+
+    _numberOfOccupiedCells = offsets[numberOfBlocks];
+
+    std::vector<Bucket> occupiedCells(_numberOfOccupiedCells);
+    parallelFor(kZeroSize, numberOfBlocks, [&](size_t b) {
+        const size_t iEnd
+            = std::min((b + 1) * kCompactionBlockSize, numberOfPoints);
+        size_t offset = offsets[b];
+        for (size_t i = b * kCompactionBlockSize; i < iEnd; ++i) {
+            if (isFirstOfCell(i)) {
+                occupiedCells[offset++] = Bucket{cells[i], i, numberOfPoints};
+            }
+        }
+    });
+
+    parallelFor(
+        kZeroSize,
+        _numberOfOccupiedCells,
+        [&](size_t c) {
+            if (c + 1 < _numberOfOccupiedCells) {
+                occupiedCells[c].end = occupiedCells[c + 1].start;
+            }
+        });
+
+    // Bounding box of the occupied cells
+    typedef std::pair<Point3I, Point3I> CellRange;
+    const CellRange range = parallelReduce(
+        kZeroSize,
+        _numberOfOccupiedCells,
+        CellRange(Point3I(kMaxSSize, kMaxSSize, kMaxSSize),
+                  Point3I(-kMaxSSize, -kMaxSSize, -kMaxSSize)),
+        [&](size_t cBegin, size_t cEnd, CellRange init) {
+            for (size_t c = cBegin; c < cEnd; ++c) {
+                const Point3I& cell = occupiedCells[c].cell;
+                init.first = Point3I(std::min(init.first.x, cell.x),
+                                     std::min(init.first.y, cell.y),
+                                     std::min(init.first.z, cell.z));
+                init.second = Point3I(std::max(init.second.x, cell.x),
+                                      std::max(init.second.y, cell.y),
+                                      std::max(init.second.z, cell.z));
+            }
+            return init;
+        },
+        [](const CellRange& a, const CellRange& b) {
+            return CellRange(
+                Point3I(std::min(a.first.x, b.first.x),
+                        std::min(a.first.y, b.first.y),
+                        std::min(a.first.z, b.first.z)),
+                Point3I(std::max(a.second.x, b.second.x),
+                        std::max(a.second.y, b.second.y),
+                        std::max(a.second.z, b.second.z)));
+        });
+
+    // Computed in double precision since the box may be arbitrarily large
+    const double boxVolume
+        = (_numberOfOccupiedCells == 0)
+              ? 0.0
+              : (static_cast<double>(range.second.x - range.first.x) + 1.0)
+                    * (static_cast<double>(range.second.y - range.first.y)
+                       + 1.0)
+                    * (static_cast<double>(range.second.z - range.first.z)
+                       + 1.0);
+
+    _usesDenseTable
+        = boxVolume <= static_cast<double>(
+                           kDenseTableSizeFactor * _numberOfOccupiedCells);
+
+    if (_usesDenseTable) {
+        _buckets.clear();
+        _denseTableOrigin = range.first;
+        _denseTableResolution = (_numberOfOccupiedCells == 0)
+            ? Size3()
+            : Size3(static_cast<size_t>(range.second.x - range.first.x + 1),
+                    static_cast<size_t>(range.second.y - range.first.y + 1),
+                    static_cast<size_t>(range.second.z - range.first.z + 1));
+
+        const size_t tableSize = _denseTableResolution.x
+                                 * _denseTableResolution.y
+                                 * _denseTableResolution.z;
+        _startIndexTable.resize(tableSize);
+        _endIndexTable.resize(tableSize);
+        parallelFill(_startIndexTable.begin(), _startIndexTable.end(), 0);
+        parallelFill(_endIndexTable.begin(), _endIndexTable.end(), 0);
+
+        // Each occupied cell owns a distinct slot
+        parallelFor(
+            kZeroSize,
+            _numberOfOccupiedCells,
+            [&](size_t c) {
+                const Bucket& bucket = occupiedCells[c];
+                const size_t key = denseTableKey(bucket.cell);
+                _startIndexTable[key] = bucket.start;
+                _endIndexTable[key] = bucket.end;
+            });
+        return;
+    }
+
+    _denseTableOrigin = Point3I();
+    _denseTableResolution = Size3();
+    _startIndexTable.clear();
+    _endIndexTable.clear();
+
+    size_t tableSize = 1;
+    while (tableSize < kHashTableSizeFactor * _numberOfOccupiedCells) {
+        tableSize <<= 1;
+    }
+
+    _buckets.resize(tableSize);
+    parallelFill(
+        _buckets.begin(),
+        _buckets.end(),
+        Bucket{Point3I(), kMaxSize, kMaxSize});
+
+    // Linear probing depends on the insertion order, so the occupied cells
+    // are inserted serially.
+    size_t mask = tableSize - 1;
+    for (const auto& occupiedCell : occupiedCells) {
+        size_t key = hashCell(occupiedCell.cell) & mask;
+        while (_buckets[key].start != kMaxSize) {
+            key = (key + 1) & mask;
+        }
+        _buckets[key] = occupiedCell;
+    }
+}
+
+size_t PointSparseHashGridSearcher3::denseTableKey(const Point3I& cell) const {
+    return static_cast<size_t>(cell.x - _denseTableOrigin.x)
+           + _denseTableResolution.x
+                 * (static_cast<size_t>(cell.y - _denseTableOrigin.y)
+                    + _denseTableResolution.y
+                          * static_cast<size_t>(cell.z - _denseTableOrigin.z));
+}
+
+void PointSparseHashGridSearcher3::getBucketRange(
+    const Point3I& cell, size_t* start, size_t* end) const {
+    *start = 0;
+    *end = 0;
+
+    if (_usesDenseTable) {
+        // Cells outside of the table wrap around to large unsigned values
+        const size_t x = static_cast<size_t>(cell.x - _denseTableOrigin.x);
+        const size_t y = static_cast<size_t>(cell.y - _denseTableOrigin.y);
+        const size_t z = static_cast<size_t>(cell.z - _denseTableOrigin.z);
+        if (x < _denseTableResolution.x
+            && y < _denseTableResolution.y
+            && z < _denseTableResolution.z) {
+            const size_t key = x + _denseTableResolution.x
+                                       * (y + _denseTableResolution.y * z);
+            *start = _startIndexTable[key];
+            *end = _endIndexTable[key];
+        }
+        return;
+    }
+
+    if (_numberOfOccupiedCells == 0) {
+        return;
+    }
+
+    size_t mask = _buckets.size() - 1;
+    size_t key = hashCell(cell) & mask;
+    while (_buckets[key].start != kMaxSize) {
+        if (_buckets[key].cell == cell) {
+            *start = _buckets[key].start;
+            *end = _buckets[key].end;
+            return;
+        }
+        key = (key + 1) & mask;
+    }
+}
+
+void PointSparseHashGridSearcher3::forEachNearbyPoint(
+    const Vector3D& origin,
+    double radius,
+    const ForEachNearbyPointFunc& callback) const {
+    const double queryRadiusSquared = radius * radius;
+
+    // The search sphere may span more than 2 cells per axis
+    if (2.0 * radius > _gridSpacing) {
+        Point3I lower, upper;
+        if (!getNearbyBucketRange(origin, radius, &lower, &upper)) {
+            for (size_t j = 0; j < _points.size(); ++j) {
+                if (_points[j].distanceSquaredTo(origin)
+                    <= queryRadiusSquared) {
+                    callback(_sortedIndices[j], _points[j]);
+                }
+            }
+            return;
+        }
+
+        Point3I cell;
+        for (cell.z = lower.z; cell.z <= upper.z; ++cell.z) {
+            for (cell.y = lower.y; cell.y <= upper.y; ++cell.y) {
+                for (cell.x = lower.x; cell.x <= upper.x; ++cell.x) {
+                    size_t start, end;
+                    getBucketRange(cell, &start, &end);
+
+                    for (size_t j = start; j < end; ++j) {
+                        if (_points[j].distanceSquaredTo(origin)
+                            <= queryRadiusSquared) {
+                            callback(_sortedIndices[j], _points[j]);
+                        }
+                    }
+                }
+            }
+        }
+        return;
+    }
+
+    Point3I nearbyBucketIndices[8];
+    getNearbyBucketIndices(origin, nearbyBucketIndices);
+
+    for (int i = 0; i < 8; i++) {
+        size_t start, end;
+        getBucketRange(nearbyBucketIndices[i], &start, &end);
+
+        for (size_t j = start; j < end; ++j) {
+            double distanceSquared = (_points[j] - origin).lengthSquared();
+            if (distanceSquared <= queryRadiusSquared) {
+                callback(_sortedIndices[j], _points[j]);
+            }
+        }
+    }
+}
+
+bool PointSparseHashGridSearcher3::hasNearbyPoint(
+    const Vector3D& origin,
+    double radius) const {
+    const double queryRadiusSquared = radius * radius;
+
+    // The search sphere may span more than 2 cells per axis
+    if (2.0 * radius > _gridSpacing) {
+        Point3I lower, upper;
+        if (!getNearbyBucketRange(origin, radius, &lower, &upper)) {
+            for (size_t j = 0; j < _points.size(); ++j) {
+                if (_points[j].distanceSquaredTo(origin)
+                    <= queryRadiusSquared) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        Point3I cell;
+        for (cell.z = lower.z; cell.z <= upper.z; ++cell.z) {
+            for (cell.y = lower.y; cell.y <= upper.y; ++cell.y) {
+                for (cell.x = lower.x; cell.x <= upper.x; ++cell.x) {
+                    size_t start, end;
+                    getBucketRange(cell, &start, &end);
+
+                    for (size_t j = start; j < end; ++j) {
+                        if (_points[j].distanceSquaredTo(origin)
+                            <= queryRadiusSquared) {
+                            return true;
+                        }
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    Point3I nearbyBucketIndices[8];
+    getNearbyBucketIndices(origin, nearbyBucketIndices);
+
+    for (int i = 0; i < 8; i++) {
+        size_t start, end;
+        getBucketRange(nearbyBucketIndices[i], &start, &end);
+
+        for (size_t j = start; j < end; ++j) {
+            double distanceSquared = (_points[j] - origin).lengthSquared();
+            if (distanceSquared <= queryRadiusSquared) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+double PointSparseHashGridSearcher3::gridSpacing() const {
+    return _gridSpacing;
+}
+
+size_t PointSparseHashGridSearcher3::numberOfOccupiedCells() const {
+    return _numberOfOccupiedCells;
+}
+
+size_t PointSparseHashGridSearcher3::numberOfBuckets() const {
+    return _usesDenseTable ? _startIndexTable.size() : _buckets.size();
+}
+
+bool PointSparseHashGridSearcher3::usesDenseTable() const {
+    return _usesDenseTable;
+}
+
+const std::vector<size_t>&
+PointSparseHashGridSearcher3::sortedIndices() const {
+    return _sortedIndices;
+}
+
+const std::vector<Vector3D>& PointSparseHashGridSearcher3::points() const {
+    return _points;
+}
+
+Point3I PointSparseHashGridSearcher3::getBucketIndex(
+    const Vector3D& position) const {
+    Point3I bucketIndex;
+    bucketIndex.x = static_cast<ssize_t>(
+        std::floor(position.x / _gridSpacing));
+    bucketIndex.y = static_cast<ssize_t>(
+        std::floor(position.y / _gridSpacing));
+    bucketIndex.z = static_cast<ssize_t>(
+        std::floor(position.z / _gridSpacing));
+    return bucketIndex;
+}
+
+void PointSparseHashGridSearcher3::getNearbyBucketIndices(
+    const Vector3D& position,
+    Point3I* nearbyBucketIndices) const {
+    Point3I originIndex = getBucketIndex(position);
+
+    for (int i = 0; i < 8; i++) {
+        nearbyBucketIndices[i] = originIndex;
+    }
+
+    if ((originIndex.x + 0.5f) * _gridSpacing <= position.x) {
+        nearbyBucketIndices[4].x += 1;
+        nearbyBucketIndices[5].x += 1;
+        nearbyBucketIndices[6].x += 1;
+        nearbyBucketIndices[7].x += 1;
+    } else {
+        nearbyBucketIndices[4].x -= 1;
+        nearbyBucketIndices[5].x -= 1;
+        nearbyBucketIndices[6].x -= 1;
+        nearbyBucketIndices[7].x -= 1;
+    }
+
+    if ((originIndex.y + 0.5f) * _gridSpacing <= position.y) {
+        nearbyBucketIndices[2].y += 1;
+        nearbyBucketIndices[3].y += 1;
+        nearbyBucketIndices[6].y += 1;
+        nearbyBucketIndices[7].y += 1;
+    } else {
+        nearbyBucketIndices[2].y -= 1;
+        nearbyBucketIndices[3].y -= 1;
+        nearbyBucketIndices[6].y -= 1;
+        nearbyBucketIndices[7].y -= 1;
+    }
+
+    if ((originIndex.z + 0.5f) * _gridSpacing <= position.z) {
+        nearbyBucketIndices[1].z += 1;
+        nearbyBucketIndices[3].z += 1;
+        nearbyBucketIndices[5].z += 1;
+        nearbyBucketIndices[7].z += 1;
+    } else {
+        nearbyBucketIndices[1].z -= 1;
+        nearbyBucketIndices[3].z -= 1;
+        nearbyBucketIndices[5].z -= 1;
+        nearbyBucketIndices[7].z -= 1;
+    }
+}
+
+// Returns false if the range has more cells than the points, in which case
+// testing every point is cheaper than visiting the cells.
+bool PointSparseHashGridSearcher3::getNearbyBucketRange(
+    const Vector3D& position,
+    double radius,
+    Point3I* lower,
+    Point3I* upper) const {
+    *lower = getBucketIndex(position - Vector3D(radius, radius, radius));
+    *upper = getBucketIndex(position + Vector3D(radius, radius, radius));
+
+    // Cells outside of the dense table are known to be empty
+    if (_usesDenseTable) {
+        const Size3& res = _denseTableResolution;
+        const Point3I& origin = _denseTableOrigin;
+        lower->x = std::max(lower->x, origin.x);
+        lower->y = std::max(lower->y, origin.y);
+        lower->z = std::max(lower->z, origin.z);
+        upper->x = std::min(
+            upper->x, origin.x + static_cast<ssize_t>(res.x) - 1);
+        upper->y = std::min(
+            upper->y, origin.y + static_cast<ssize_t>(res.y) - 1);
+        upper->z = std::min(
+            upper->z, origin.z + static_cast<ssize_t>(res.z) - 1);
+    }
+
+    // Computed in double precision since the range may be arbitrarily large
+    const double numberOfCells
+        = std::max(static_cast<double>(upper->x - lower->x) + 1.0, 0.0)
+          * std::max(static_cast<double>(upper->y - lower->y) + 1.0, 0.0)
+          * std::max(static_cast<double>(upper->z - lower->z) + 1.0, 0.0);
+    return numberOfCells <= static_cast<double>(_points.size());
+}
+
+PointNeighborSearcher3Ptr PointSparseHashGridSearcher3::clone() const {
+    return CLONE_W_CUSTOM_DELETER(PointSparseHashGridSearcher3);
+}
+
+PointSparseHashGridSearcher3&
+PointSparseHashGridSearcher3::operator=(
+    const PointSparseHashGridSearcher3& other) {
+    set(other);
+    return *this;
+}
+
+void PointSparseHashGridSearcher3::set(
+    const PointSparseHashGridSearcher3& other) {
+    _gridSpacing = other._gridSpacing;
+    _numberOfOccupiedCells = other._numberOfOccupiedCells;
+    _points = other._points;
+    _sortedIndices = other._sortedIndices;
+    _buckets = other._buckets;
+    _usesDenseTable = other._usesDenseTable;
+    _denseTableOrigin = other._denseTableOrigin;
+    _denseTableResolution = other._denseTableResolution;
+    _startIndexTable = other._startIndexTable;
+    _endIndexTable = other._endIndexTable;
+}
+
+void PointSparseHashGridSearcher3::serialize(
+    std::vector<uint8_t>* buffer) const {
+    flatbuffers::FlatBufferBuilder builder(1024);
+
+    // Copy points
+    std::vector<fbs::Vector3D> points;
+    for (const auto& pt : _points) {
+        points.push_back(jetToFbs(pt));
+    }
+
+    auto fbsPoints
+        = builder.CreateVectorOfStructs(points.data(), points.size());
+
+    // Copy sorted indices. The hash table is rebuilt from the sorted points
+    // when deserialized.
+    std::vector<uint64_t> sortedIndices(
+        _sortedIndices.begin(), _sortedIndices.end());
+
+    auto fbsSortedIndices
+        = builder.CreateVector(sortedIndices.data(), sortedIndices.size());
+
+    // Copy the searcher
+    auto fbsSearcher = fbs::CreatePointSparseHashGridSearcher3(
+        builder,
+        _gridSpacing,
+        fbsPoints,
+        fbsSortedIndices);
+
+    builder.Finish(fbsSearcher);
+
+    uint8_t *buf = builder.GetBufferPointer();
+    size_t size = builder.GetSize();
+
+    buffer->resize(size);
+    memcpy(buffer->data(), buf, size);
+}
+
+void PointSparseHashGridSearcher3::deserialize(
+    const std::vector<uint8_t>& buffer) {
+    auto fbsSearcher = fbs::GetPointSparseHashGridSearcher3(buffer.data());
+
+    // Copy simple data
+    _gridSpacing = fbsSearcher->gridSpacing();
+
+    // Copy points
+    auto fbsPoints = fbsSearcher->points();
+    _points.resize(fbsPoints->size());
+    for (uint32_t i = 0; i < fbsPoints->size(); ++i) {
+        _points[i] = fbsToJet(*fbsPoints->Get(i));
+    }
+
+    // Copy sorted indices
+    auto fbsSortedIndices = fbsSearcher->sortedIndices();
+    _sortedIndices.resize(fbsSortedIndices->size());
+    for (uint32_t i = 0; i < fbsSortedIndices->size(); ++i) {
+        _sortedIndices[i] = static_cast<size_t>(fbsSortedIndices->Get(i));
+    }
+
+    buildBuckets();
+}
+
+PointSparseHashGridSearcher3::Builder
+PointSparseHashGridSearcher3::builder() {
+    return Builder();
+}
+
+
+PointSparseHashGridSearcher3::Builder&
+PointSparseHashGridSearcher3::Builder::withGridSpacing(double gridSpacing) {
+    _gridSpacing = gridSpacing;
+    return *this;
+}
+
+PointSparseHashGridSearcher3
+PointSparseHashGridSearcher3::Builder::build() const {
+    return PointSparseHashGridSearcher3(_gridSpacing);
+}
+
+PointSparseHashGridSearcher3Ptr
+PointSparseHashGridSearcher3::Builder::makeShared() const {
+    return std::shared_ptr<PointSparseHashGridSearcher3>(
+        new PointSparseHashGridSearcher3(_gridSpacing),
+        [] (PointSparseHashGridSearcher3* obj) {
+            delete obj;
+        });
+}
+
+PointNeighborSearcher3Ptr
+PointSparseHashGridSearcher3::Builder::buildPointNeighborSearcher() const {
+    return makeShared();
+}
@@ -80,12 +80,18 @@ double ScalarGrid3::laplacianAtDataPoint(size_t i, size_t j, size_t k) const {
     return laplacian3(_data.constAccessor(), gridSpacing(), i, j, k);
 }
 
-double ScalarGrid3::sample(const Vector3D& x) const { return _sampler(x); }
+double ScalarGrid3::sample(const Vector3D& x) const {
+    return _linearSampler(x);
+}
 
 std::function<double(const Vector3D&)> ScalarGrid3::sampler() const {
     return _sampler;
 }
 
+const LinearArraySampler3<double, double>& ScalarGrid3::linearSampler() const {
+    return _linearSampler;
+}
+
 Vector3D ScalarGrid3::gradient(const Vector3D& x) const {
     std::array<Point3UI, 8> indices;
     std::array<double, 8> weights;
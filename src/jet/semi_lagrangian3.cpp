@@ -9,9 +9,26 @@
 #include <jet/parallel.h>
 #include <jet/semi_lagrangian3.h>
 #include <algorithm>
+#include <typeinfo>
+#include <vector>
 
 using namespace jet;
 
+internal::SemiLagrangianFlowSampler3::SemiLagrangianFlowSampler3(
+    const VectorField3& flow)
+: _flow(flow),
+  _uSampler(ConstArrayAccessor3<double>(), Vector3D(1, 1, 1), Vector3D()),
+  _vSampler(ConstArrayAccessor3<double>(), Vector3D(1, 1, 1), Vector3D()),
+  _wSampler(ConstArrayAccessor3<double>(), Vector3D(1, 1, 1), Vector3D()) {
+    auto faceCenteredFlow = dynamic_cast<const FaceCenteredGrid3*>(&flow);
+    if (faceCenteredFlow != nullptr) {
+        _isFaceCentered = true;
+        _uSampler = faceCenteredFlow->uLinearSampler();
+        _vSampler = faceCenteredFlow->vLinearSampler();
+        _wSampler = faceCenteredFlow->wLinearSampler();
+    }
+}
+
 SemiLagrangian3::SemiLagrangian3() {
 }
 
@@ -24,23 +41,14 @@ void SemiLagrangian3::advect(
     double dt,
     ScalarGrid3* output,
     const ScalarField3& boundarySdf) {
-    auto outputDataPos = output->dataPosition();
-    auto outputDataAcc = output->dataAccessor();
-    auto inputSamplerFunc = getScalarSamplerFunc(input);
-    auto inputDataPos = input.dataPosition();
-
-    double h = min3(
-        output->gridSpacing().x,
-        output->gridSpacing().y,
-        output->gridSpacing().z);
-
-    output->parallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
-        if (boundarySdf.sample(inputDataPos(i, j, k)) > 0.0) {
-            Vector3D pt = backTrace(
-                flow, dt, h, outputDataPos(i, j, k), boundarySdf);
-            outputDataAcc(i, j, k) = inputSamplerFunc(pt);
-        }
-    });
+    // The sampler hook is bypassed only if it cannot have been overridden
+    if (typeid(*this) == typeid(SemiLagrangian3)) {
+        advectScalar(
+            input, input.linearSampler(), flow, dt, output, boundarySdf);
+    } else {
+        advectScalar(
+            input, getScalarSamplerFunc(input), flow, dt, output, boundarySdf);
+    }
 }
 
 void SemiLagrangian3::advect(
@@ -49,24 +57,13 @@ void SemiLagrangian3::advect(
     double dt,
     CollocatedVectorGrid3* output,
     const ScalarField3& boundarySdf) {
-    auto inputSamplerFunc = getVectorSamplerFunc(input);
-
-    double h = min3(
-        output->gridSpacing().x,
-        output->gridSpacing().y,
-        output->gridSpacing().z);
-
-    auto outputDataPos = output->dataPosition();
-    auto outputDataAcc = output->dataAccessor();
-    auto inputDataPos = input.dataPosition();
-
-    output->parallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
-        if (boundarySdf.sample(inputDataPos(i, j, k)) > 0.0) {
-            Vector3D pt = backTrace(
-                flow, dt, h, outputDataPos(i, j, k), boundarySdf);
-            outputDataAcc(i, j, k) = inputSamplerFunc(pt);
-        }
-    });
+    if (typeid(*this) == typeid(SemiLagrangian3)) {
+        advectCollocated(
+            input, input.linearSampler(), flow, dt, output, boundarySdf);
+    } else {
+        advectCollocated(
+            input, getVectorSamplerFunc(input), flow, dt, output, boundarySdf);
+    }
 }
 
 void SemiLagrangian3::advect(
@@ -75,52 +72,69 @@ void SemiLagrangian3::advect(
     double dt,
     FaceCenteredGrid3* output,
     const ScalarField3& boundarySdf) {
-    auto inputSamplerFunc = getVectorSamplerFunc(input);
-
-    double h = min3(
-        output->gridSpacing().x,
-        output->gridSpacing().y,
-        output->gridSpacing().z);
-
-    auto uTargetDataPos = output->uPosition();
-    auto uTargetDataAcc = output->uAccessor();
-    auto uSourceDataPos = input.uPosition();
-
-    output->parallelForEachUIndex([&](size_t i, size_t j, size_t k) {
-        if (boundarySdf.sample(uSourceDataPos(i, j, k)) > 0.0) {
-            Vector3D pt = backTrace(
-                flow, dt, h, uTargetDataPos(i, j, k), boundarySdf);
-            uTargetDataAcc(i, j, k) = inputSamplerFunc(pt).x;
-        }
-    });
+    if (typeid(*this) == typeid(SemiLagrangian3)) {
+        advectFaceCentered(
+            input,
+            input.uLinearSampler(),
+            input.vLinearSampler(),
+            input.wLinearSampler(),
+            flow,
+            dt,
+            output,
+            boundarySdf);
+        return;
+    }
 
-    auto vTargetDataPos = output->vPosition();
-    auto vTargetDataAcc = output->vAccessor();
-    auto vSourceDataPos = input.vPosition();
+    auto inputSamplerFunc = getVectorSamplerFunc(input);
+    std::function<double(const Vector3D&)> uSamplerFunc
+        = [&inputSamplerFunc](const Vector3D& x) {
+              return inputSamplerFunc(x).x;
+          };
+    std::function<double(const Vector3D&)> vSamplerFunc
+        = [&inputSamplerFunc](const Vector3D& x) {
+              return inputSamplerFunc(x).y;
+          };
+    std::function<double(const Vector3D&)> wSamplerFunc
+        = [&inputSamplerFunc](const Vector3D& x) {
+              return inputSamplerFunc(x).z;
+          };
+    advectFaceCentered(
+        input,
+        uSamplerFunc,
+        vSamplerFunc,
+        wSamplerFunc,
+        flow,
+        dt,
+        output,
+        boundarySdf);
+}
 
-    output->parallelForEachVIndex([&](size_t i, size_t j, size_t k) {
-        if (boundarySdf.sample(vSourceDataPos(i, j, k)) > 0.0) {
-            Vector3D pt = backTrace(
-                flow, dt, h, vTargetDataPos(i, j, k), boundarySdf);
-            vTargetDataAcc(i, j, k) = inputSamplerFunc(pt).y;
-        }
-    });
+void SemiLagrangian3::advectScalars(
+    const std::vector<const ScalarGrid3*>& inputs,
+    const VectorField3& flow,
+    double dt,
+    const std::vector<ScalarGrid3*>& outputs,
+    const ScalarField3& boundarySdf) {
+    // Subclasses may customize advect or the sampler hooks, so the grids are
+    // advected one by one unless this is exactly SemiLagrangian3.
+    if (typeid(*this) != typeid(SemiLagrangian3)) {
+        AdvectionSolver3::advectScalars(
+            inputs, flow, dt, outputs, boundarySdf);
+        return;
+    }
 
-    auto wTargetDataPos = output->wPosition();
-    auto wTargetDataAcc = output->wAccessor();
-    auto wSourceDataPos = input.wPosition();
+    std::vector<LinearArraySampler3<double, double>> inputSamplers;
+    inputSamplers.reserve(inputs.size());
+    for (const auto& input : inputs) {
+        inputSamplers.push_back(input->linearSampler());
+    }
 
-    output->parallelForEachWIndex([&](size_t i, size_t j, size_t k) {
-        if (boundarySdf.sample(wSourceDataPos(i, j, k)) > 0.0) {
-            Vector3D pt = backTrace(
-                flow, dt, h, wTargetDataPos(i, j, k), boundarySdf);
-            wTargetDataAcc(i, j, k) = inputSamplerFunc(pt).z;
-        }
-    });
+    advectCoLocatedScalars(
+        inputs, inputSamplers, flow, dt, outputs, boundarySdf);
 }
 
 Vector3D SemiLagrangian3::backTrace(
-    const VectorField3& flow,
+    const internal::SemiLagrangianFlowSampler3& flow,
     double dt,
     double h,
     const Vector3D& startPt,
@@ -132,14 +146,14 @@ Vector3D SemiLagrangian3::backTrace(
 
     while (remainingT > kEpsilonD) {
         // Adaptive time-stepping
-        Vector3D vel0 = flow.sample(pt0);
+        Vector3D vel0 = flow(pt0);
         double numSubSteps
             = std::max(std::ceil(vel0.length() * remainingT / h), 1.0);
         dt = remainingT / numSubSteps;
 
         // Mid-point rule
         Vector3D midPt = pt0 - 0.5 * dt * vel0;
-        Vector3D midVel = flow.sample(midPt);
+        Vector3D midVel = flow(midPt);
         pt1 = pt0 - dt * midVel;
 
         // Boundary handling
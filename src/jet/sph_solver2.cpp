@@ -102,11 +102,17 @@ unsigned int SphSolver2::numberOfSubTimeSteps(
     const double kernelRadius = particles->kernelRadius();
     const double mass = particles->mass();
 
-    double maxForceMagnitude = 0.0;
-
-    for (size_t i = 0; i < numberOfParticles; ++i) {
-        maxForceMagnitude = std::max(maxForceMagnitude, f[i].length());
-    }
+    double maxForceMagnitude = parallelReduce(
+        kZeroSize, numberOfParticles, 0.0,
+        [&](size_t iBegin, size_t iEnd, double init) {
+            double result = init;
+            for (size_t i = iBegin; i < iEnd; ++i) {
+                result = std::max(result, f[i].length());
+            }
+            return result;
+        },
+        [](double a, double b) { return std::max(a, b); },
+        ExecutionPolicy::kParallel, ReductionMode::kDeterministic);
 
     double timeStepLimitBySpeed
         = kTimeStepLimitBySpeedFactor * kernelRadius / _speedOfSound;
@@ -149,10 +155,17 @@ void SphSolver2::onEndAdvanceTimeStep(double timeStepInSeconds) {
     size_t numberOfParticles = particles->numberOfParticles();
     auto densities = particles->densities();
 
-    double maxDensity = 0.0;
-    for (size_t i = 0; i < numberOfParticles; ++i) {
-        maxDensity = std::max(maxDensity, densities[i]);
-    }
+    double maxDensity = parallelReduce(
+        kZeroSize, numberOfParticles, 0.0,
+        [&](size_t iBegin, size_t iEnd, double init) {
+            double result = init;
+            for (size_t i = iBegin; i < iEnd; ++i) {
+                result = std::max(result, densities[i]);
+            }
+            return result;
+        },
+        [](double a, double b) { return std::max(a, b); },
+        ExecutionPolicy::kParallel, ReductionMode::kDeterministic);
 
     JET_INFO << "Max density: " << maxDensity << " "
              << "Max density / target density ratio: "
@@ -216,7 +229,7 @@ void SphSolver2::accumulatePressureForce(
         kZeroSize,
         numberOfParticles,
         [&](size_t i) {
-            const auto& neighbors = particles->neighborLists()[i];
+            const auto neighbors = particles->neighborLists()[i];
             for (size_t j : neighbors) {
                 double dist = positions[i].distanceTo(positions[j]);
 
@@ -247,7 +260,7 @@ void SphSolver2::accumulateViscosityForce() {
         kZeroSize,
         numberOfParticles,
         [&](size_t i) {
-            const auto& neighbors = particles->neighborLists()[i];
+            const auto neighbors = particles->neighborLists()[i];
             for (size_t j : neighbors) {
                 double dist = x[i].distanceTo(x[j]);
 
@@ -277,7 +290,7 @@ void SphSolver2::computePseudoViscosity(double timeStepInSeconds) {
             double weightSum = 0.0;
             Vector2D smoothedVelocity;
 
-            const auto& neighbors = particles->neighborLists()[i];
+            const auto neighbors = particles->neighborLists()[i];
             for (size_t j : neighbors) {
                 double dist = x[i].distanceTo(x[j]);
                 double wj = mass / d[j] * kernel(dist);
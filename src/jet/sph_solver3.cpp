@@ -12,12 +12,22 @@
 #include <jet/timer.h>
 
 #include <algorithm>
+#include <functional>
+#include <typeinfo>
 
 using namespace jet;
 
 static double kTimeStepLimitBySpeedFactor = 0.4;
 static double kTimeStepLimitByForceFactor = 0.25;
 
+static const size_t kNeighborBatchSize
+    = ParticleSystemData3::kNeighborBatchSize;
+
+// Sleep states. The density is updated for the nonzero states.
+static const char kSleepStateAsleep = 0;
+static const char kSleepStateAwake = 1;
+static const char kSleepStateAsleepNearAwake = 2;
+
 SphSolver3::SphSolver3() {
     setParticleSystemData(std::make_shared<SphSystemData3>());
     setIsUsingFixedSubTimeSteps(false);
@@ -89,6 +99,49 @@ void SphSolver3::setTimeStepLimitScale(double newScale) {
     _timeStepLimitScale = std::max(newScale, 0.0);
 }
 
+bool SphSolver3::isUsingSleeping() const {
+    return _isUsingSleeping;
+}
+
+void SphSolver3::setIsUsingSleeping(bool onoff) {
+    _isUsingSleeping = onoff;
+    if (onoff && _sleepCounterIdx == kMaxSize) {
+        _sleepCounterIdx = sphSystemData()->addScalarData(0.0);
+    }
+    if (!onoff) {
+        _sleepStates.clear();
+        _numberOfSleepingParticles = 0;
+    }
+}
+
+double SphSolver3::sleepingVelocityThreshold() const {
+    return _sleepingVelocityThreshold;
+}
+
+void SphSolver3::setSleepingVelocityThreshold(double newThreshold) {
+    _sleepingVelocityThreshold = std::max(newThreshold, 0.0);
+}
+
+double SphSolver3::sleepingDensityErrorThreshold() const {
+    return _sleepingDensityErrorThreshold;
+}
+
+void SphSolver3::setSleepingDensityErrorThreshold(double newThreshold) {
+    _sleepingDensityErrorThreshold = std::max(newThreshold, 0.0);
+}
+
+unsigned int SphSolver3::sleepingStepCount() const {
+    return _sleepingStepCount;
+}
+
+void SphSolver3::setSleepingStepCount(unsigned int n) {
+    _sleepingStepCount = std::max(n, 1u);
+}
+
+size_t SphSolver3::numberOfSleepingParticles() const {
+    return _numberOfSleepingParticles;
+}
+
 SphSystemData3Ptr SphSolver3::sphSystemData() const {
     return std::dynamic_pointer_cast<SphSystemData3>(particleSystemData());
 }
@@ -102,11 +155,17 @@ unsigned int SphSolver3::numberOfSubTimeSteps(
     const double kernelRadius = particles->kernelRadius();
     const double mass = particles->mass();
 
-    double maxForceMagnitude = 0.0;
-
-    for (size_t i = 0; i < numberOfParticles; ++i) {
-        maxForceMagnitude = std::max(maxForceMagnitude, f[i].length());
-    }
+    double maxForceMagnitude = parallelReduce(
+        kZeroSize, numberOfParticles, 0.0,
+        [&](size_t iBegin, size_t iEnd, double init) {
+            double result = init;
+            for (size_t i = iBegin; i < iEnd; ++i) {
+                result = std::max(result, f[i].length());
+            }
+            return result;
+        },
+        [](double a, double b) { return std::max(a, b); },
+        ExecutionPolicy::kParallel, ReductionMode::kDeterministic);
 
     double timeStepLimitBySpeed
         = kTimeStepLimitBySpeedFactor * kernelRadius / _speedOfSound;
@@ -123,8 +182,19 @@ unsigned int SphSolver3::numberOfSubTimeSteps(
 }
 
 void SphSolver3::accumulateForces(double timeStepInSeconds) {
+    // The force stages are fused only if they cannot have been overridden
+    if (typeid(*this) == typeid(SphSolver3)) {
+        ParticleSystemSolver3::accumulateForces(timeStepInSeconds);
+        computePressure();
+        accumulateViscosityAndPressureForces();
+        cancelSleepingForces(timeStepInSeconds);
+        return;
+    }
+
     accumulateNonPressureForces(timeStepInSeconds);
+    cancelSleepingForces(timeStepInSeconds);
     accumulatePressureForce(timeStepInSeconds);
+    cancelSleepingForces(timeStepInSeconds);
 }
 
 void SphSolver3::onBeginAdvanceTimeStep(double timeStepInSeconds) {
@@ -133,9 +203,16 @@ void SphSolver3::onBeginAdvanceTimeStep(double timeStepInSeconds) {
     auto particles = sphSystemData();
 
     Timer timer;
-    particles->buildNeighborSearcher();
-    particles->buildNeighborLists();
-    particles->updateDensities();
+    if (particles->needsNeighborListsRebuild()) {
+        particles->buildNeighborSearcher();
+        particles->buildNeighborLists();
+    }
+    if (_isUsingSleeping) {
+        updateSleepStates();
+        particles->updateDensities(_sleepStates.constAccessor());
+    } else {
+        particles->updateDensities();
+    }
 
     JET_INFO << "Building neighbor lists and updating densities took "
              << timer.durationInSeconds()
@@ -145,14 +222,27 @@ void SphSolver3::onBeginAdvanceTimeStep(double timeStepInSeconds) {
 void SphSolver3::onEndAdvanceTimeStep(double timeStepInSeconds) {
     computePseudoViscosity(timeStepInSeconds);
 
+    if (_isUsingSleeping) {
+        updateSleepCounters();
+        JET_INFO << "Number of sleeping particles: "
+                 << _numberOfSleepingParticles;
+    }
+
     auto particles = sphSystemData();
     size_t numberOfParticles = particles->numberOfParticles();
     auto densities = particles->densities();
 
-    double maxDensity = 0.0;
-    for (size_t i = 0; i < numberOfParticles; ++i) {
-        maxDensity = std::max(maxDensity, densities[i]);
-    }
+    double maxDensity = parallelReduce(
+        kZeroSize, numberOfParticles, 0.0,
+        [&](size_t iBegin, size_t iEnd, double init) {
+            double result = init;
+            for (size_t i = iBegin; i < iEnd; ++i) {
+                result = std::max(result, densities[i]);
+            }
+            return result;
+        },
+        [](double a, double b) { return std::max(a, b); },
+        ExecutionPolicy::kParallel, ReductionMode::kDeterministic);
 
     JET_INFO << "Max density: " << maxDensity << " "
              << "Max density / target density ratio: "
@@ -192,6 +282,10 @@ void SphSolver3::computePressure() {
         kZeroSize,
         numberOfParticles,
         [&](size_t i) {
+            if (!needsDensityUpdate(i)) {
+                return;
+            }
+
             p[i] = computePressureFromEos(
                 d[i],
                 targetDensity,
@@ -209,28 +303,55 @@ void SphSolver3::accumulatePressureForce(
     auto particles = sphSystemData();
     size_t numberOfParticles = particles->numberOfParticles();
 
-    const double massSquared = square(particles->mass());
-    const SphSpikyKernel3 kernel(particles->kernelRadius());
-
     parallelFor(
         kZeroSize,
         numberOfParticles,
         [&](size_t i) {
-            const auto& neighbors = particles->neighborLists()[i];
-            for (size_t j : neighbors) {
-                double dist = positions[i].distanceTo(positions[j]);
+            if (isSleeping(i)) {
+                return;
+            }
+
+            pressureForces[i] += computePressureForce(
+                *particles, i, positions, densities, pressures);
+        });
+}
 
-                if (dist > 0.0) {
-                    Vector3D dir = (positions[j] - positions[i]) / dist;
-                    pressureForces[i] -= massSquared
+Vector3D SphSolver3::computePressureForce(
+    const SphSystemData3& particles,
+    size_t i,
+    const ConstArrayAccessor1<Vector3D>& positions,
+    const ConstArrayAccessor1<double>& densities,
+    const ConstArrayAccessor1<double>& pressures) {
+    const double massSquared = square(particles.mass());
+    const SphSpikyKernel3 kernel(particles.kernelRadius());
+
+    double dists[kNeighborBatchSize];
+    Vector3D dirs[kNeighborBatchSize];
+    Vector3D gradients[kNeighborBatchSize];
+    Vector3D pressureForce;
+
+    particles.forEachNeighborBatch(
+        i, [&](const NeighborLists::IndexType* neighbors, size_t n) {
+            for (size_t k = 0; k < n; ++k) {
+                Vector3D r = positions[neighbors[k]] - positions[i];
+                dists[k] = r.length();
+                dirs[k] = (dists[k] > 0.0) ? r / dists[k] : r;
+            }
+            kernel.gradients(dists, dirs, n, gradients);
+
+            for (size_t k = 0; k < n; ++k) {
+                if (dists[k] > 0.0) {
+                    size_t j = neighbors[k];
+                    pressureForce -= massSquared
                         * (pressures[i] / (densities[i] * densities[i])
-                            + pressures[j] / (densities[j] * densities[j]))
-                        * kernel.gradient(dist, dir);
+                        + pressures[j] / (densities[j] * densities[j]))
+                        * gradients[k];
                 }
             }
         });
-}
 
+    return pressureForce;
+}
 
 void SphSolver3::accumulateViscosityForce() {
     auto particles = sphSystemData();
@@ -247,14 +368,83 @@ void SphSolver3::accumulateViscosityForce() {
         kZeroSize,
         numberOfParticles,
         [&](size_t i) {
-            const auto& neighbors = particles->neighborLists()[i];
-            for (size_t j : neighbors) {
-                double dist = x[i].distanceTo(x[j]);
+            if (isSleeping(i)) {
+                return;
+            }
+
+            double laplacians[kNeighborBatchSize];
+
+            particles->forEachNeighborBatch(
+                i, [&](const NeighborLists::IndexType* neighbors, size_t n) {
+                    for (size_t k = 0; k < n; ++k) {
+                        laplacians[k] = x[i].distanceTo(x[neighbors[k]]);
+                    }
+                    kernel.secondDerivatives(laplacians, n, laplacians);
+
+                    for (size_t k = 0; k < n; ++k) {
+                        size_t j = neighbors[k];
+                        f[i] += viscosityCoefficient() * massSquared
+                            * (v[j] - v[i]) / d[j]
+                            * laplacians[k];
+                    }
+                });
+        });
+}
+
+void SphSolver3::accumulateViscosityAndPressureForces() {
+    auto particles = sphSystemData();
+    size_t numberOfParticles = particles->numberOfParticles();
+    auto x = particles->positions();
+    auto v = particles->velocities();
+    auto d = particles->densities();
+    auto p = particles->pressures();
+    auto f = particles->forces();
+
+    const double massSquared = square(particles->mass());
+    const SphSpikyKernel3 kernel(particles->kernelRadius());
 
-                f[i] += viscosityCoefficient() * massSquared
-                    * (v[j] - v[i]) / d[j]
-                    * kernel.secondDerivative(dist);
+    parallelFor(
+        kZeroSize,
+        numberOfParticles,
+        [&](size_t i) {
+            if (isSleeping(i)) {
+                return;
             }
+
+            double dists[kNeighborBatchSize];
+            Vector3D dirs[kNeighborBatchSize];
+            Vector3D gradients[kNeighborBatchSize];
+            double laplacians[kNeighborBatchSize];
+            const double pressureOverDensitySquared
+                = p[i] / (d[i] * d[i]);
+            Vector3D force;
+
+            particles->forEachNeighborBatch(
+                i, [&](const NeighborLists::IndexType* neighbors, size_t n) {
+                    for (size_t k = 0; k < n; ++k) {
+                        Vector3D r = x[neighbors[k]] - x[i];
+                        dists[k] = r.length();
+                        dirs[k] = (dists[k] > 0.0) ? r / dists[k] : r;
+                    }
+                    kernel.gradients(dists, dirs, n, gradients);
+                    kernel.secondDerivatives(dists, n, laplacians);
+
+                    for (size_t k = 0; k < n; ++k) {
+                        size_t j = neighbors[k];
+                        force += viscosityCoefficient() * massSquared
+                            * (v[j] - v[i]) / d[j]
+                            * laplacians[k];
+
+                        if (dists[k] > 0.0) {
+                            force -= massSquared
+                                * (pressureOverDensitySquared
+                                + p[j] / (d[j] * d[j]))
+                                * gradients[k];
+                        }
+                    }
+                });
+
+            f[i] += force;
         });
 }
 
@@ -274,16 +464,29 @@ void SphSolver3::computePseudoViscosity(double timeStepInSeconds) {
         kZeroSize,
         numberOfParticles,
         [&](size_t i) {
+            if (isSleeping(i)) {
+                smoothedVelocities[i] = v[i];
+                return;
+            }
+
             double weightSum = 0.0;
             Vector3D smoothedVelocity;
-
-            const auto& neighbors = particles->neighborLists()[i];
-            for (size_t j : neighbors) {
-                double dist = x[i].distanceTo(x[j]);
-                double wj = mass / d[j] * kernel(dist);
-                weightSum += wj;
-                smoothedVelocity += wj * v[j];
-            }
+            double weights[kNeighborBatchSize];
+
+            particles->forEachNeighborBatch(
+                i, [&](const NeighborLists::IndexType* neighbors, size_t n) {
+                    for (size_t k = 0; k < n; ++k) {
+                        weights[k] = x[i].distanceTo(x[neighbors[k]]);
+                    }
+                    kernel.values(weights, n, weights);
+
+                    for (size_t k = 0; k < n; ++k) {
+                        size_t j = neighbors[k];
+                        double wj = mass / d[j] * weights[k];
+                        weightSum += wj;
+                        smoothedVelocity += wj * v[j];
+                    }
+                });
 
             double wi = mass / d[i];
             weightSum += wi;
@@ -308,6 +511,129 @@ void SphSolver3::computePseudoViscosity(double timeStepInSeconds) {
         });
 }
 
+bool SphSolver3::isSleeping(size_t i) const {
+    return i < _sleepStates.size() && _sleepStates[i] != kSleepStateAwake;
+}
+
+bool SphSolver3::needsDensityUpdate(size_t i) const {
+    return i >= _sleepStates.size() || _sleepStates[i] != kSleepStateAsleep;
+}
+
+void SphSolver3::updateSleepStates() {
+    auto particles = sphSystemData();
+    size_t numberOfParticles = particles->numberOfParticles();
+    auto counters = particles->scalarDataAt(_sleepCounterIdx);
+    auto v = particles->velocities();
+    const double sleepingStepCount = static_cast<double>(_sleepingStepCount);
+    const double maxSpeedSquared = square(_sleepingVelocityThreshold);
+
+    // Sleeping particles wake up if they are pushed from outside of the solver
+    // (e.g. by the user or a collider) or if a neighbor moved in the last step
+    Array1<char> isAwake(numberOfParticles);
+    parallelFor(kZeroSize, numberOfParticles, [&](size_t i) {
+        bool awake = counters[i] < sleepingStepCount
+            || v[i].lengthSquared() >= maxSpeedSquared;
+        particles->forEachNeighborBatch(
+            i, [&](const NeighborLists::IndexType* neighbors, size_t n) {
+                for (size_t k = 0; k < n && !awake; ++k) {
+                    awake = counters[neighbors[k]] == 0.0;
+                }
+            });
+        isAwake[i] = awake;
+    });
+
+    // Sleeping particles next to awake ones keep updating their densities
+    _sleepStates.resize(numberOfParticles);
+    parallelFor(kZeroSize, numberOfParticles, [&](size_t i) {
+        if (isAwake[i]) {
+            _sleepStates[i] = kSleepStateAwake;
+            return;
+        }
+
+        char state = kSleepStateAsleep;
+        particles->forEachNeighborBatch(
+            i, [&](const NeighborLists::IndexType* neighbors, size_t n) {
+                for (size_t k = 0; k < n; ++k) {
+                    if (isAwake[neighbors[k]]) {
+                        state = kSleepStateAsleepNearAwake;
+                        break;
+                    }
+                }
+            });
+        _sleepStates[i] = state;
+    });
+
+    parallelFor(kZeroSize, numberOfParticles, [&](size_t i) {
+        if (isAwake[i] && counters[i] >= sleepingStepCount) {
+            counters[i] = 0.0;
+        }
+    });
+
+    _numberOfSleepingParticles = parallelReduce(
+        kZeroSize, numberOfParticles, kZeroSize,
+        [&](size_t iBegin, size_t iEnd, size_t init) {
+            size_t result = init;
+            for (size_t i = iBegin; i < iEnd; ++i) {
+                result += isAwake[i] ? 0 : 1;
+            }
+            return result;
+        },
+        std::plus<size_t>());
+}
+
+void SphSolver3::updateSleepCounters() {
+    auto particles = sphSystemData();
+    size_t numberOfParticles = particles->numberOfParticles();
+    auto counters = particles->scalarDataAt(_sleepCounterIdx);
+    auto v = particles->velocities();
+    auto d = particles->densities();
+
+    const double targetDensity = particles->targetDensity();
+    const double sleepingStepCount = static_cast<double>(_sleepingStepCount);
+    const double maxSpeedSquared = square(_sleepingVelocityThreshold);
+
+    parallelFor(kZeroSize, numberOfParticles, [&](size_t i) {
+        if (isSleeping(i)) {
+            return;
+        }
+
+        double densityError = d[i] / targetDensity - 1.0;
+        if (densityError < 0.0) {
+            densityError *= -negativePressureScale();
+        }
+
+        const bool isQuiescent = v[i].lengthSquared() < maxSpeedSquared
+            && densityError < _sleepingDensityErrorThreshold;
+        if (!isQuiescent) {
+            counters[i] = 0.0;
+        } else if (++counters[i] >= sleepingStepCount) {
+            // Falls asleep from the next step
+            counters[i] = sleepingStepCount;
+            v[i] = Vector3D();
+        }
+    });
+}
+
+void SphSolver3::cancelSleepingForces(double timeStepInSeconds) {
+    if (!_isUsingSleeping) {
+        return;
+    }
+
+    auto particles = sphSystemData();
+    size_t numberOfParticles = particles->numberOfParticles();
+    auto v = particles->velocities();
+    auto f = particles->forces();
+    const double mass = particles->mass();
+
+    // Cancels the forces and any velocity set by the subclasses so that the
+    // sleeping particles stay at rest
+    parallelFor(kZeroSize, numberOfParticles, [&](size_t i) {
+        if (isSleeping(i)) {
+            f[i] = -mass * v[i] / timeStepInSeconds;
+        }
+    });
+}
+
 SphSolver3::Builder SphSolver3::builder() {
     return Builder();
 }
@@ -66,14 +66,50 @@ ArrayAccessor1<double> SphSystemData3::pressures() {
 }
 
 void SphSystemData3::updateDensities() {
+    updateDensities(ConstArrayAccessor1<char>());
+}
+
+void SphSystemData3::updateDensities(const ConstArrayAccessor1<char>& mask) {
+    JET_THROW_INVALID_ARG_IF(mask.size() != 0
+                             && mask.size() != numberOfParticles());
+
     auto p = positions();
     auto d = densities();
     const double m = mass();
-
-    parallelFor(kZeroSize, numberOfParticles(), [&](size_t i) {
-        double sum = sumOfKernelNearby(p[i]);
-        d[i] = m * sum;
-    });
+    const bool hasMask = mask.size() > 0;
+
+    if (skinRadius() > 0.0 || !useNeighborLists()) {
+        const SphStdKernel3 kernel(_kernelRadius);
+
+        parallelFor(kZeroSize, numberOfParticles(), [&](size_t i) {
+            if (hasMask && !mask[i]) {
+                return;
+            }
+
+            double sum = kernel(0.0);
+            double weights[kNeighborBatchSize];
+            forEachNeighborBatch(
+                i, [&](const NeighborLists::IndexType* neighbors, size_t n) {
+                    for (size_t k = 0; k < n; ++k) {
+                        weights[k] = p[i].distanceSquaredTo(p[neighbors[k]]);
+                    }
+                    kernel.valuesFromSquaredDistances(weights, n, weights);
+                    for (size_t k = 0; k < n; ++k) {
+                        sum += weights[k];
+                    }
+                });
+            d[i] = m * sum;
+        });
+    } else {
+        parallelFor(kZeroSize, numberOfParticles(), [&](size_t i) {
+            if (hasMask && !mask[i]) {
+                return;
+            }
+
+            double sum = sumOfKernelNearby(p[i]);
+            d[i] = m * sum;
+        });
+    }
 }
 
 void SphSystemData3::setTargetDensity(double targetDensity) {
@@ -117,10 +153,14 @@ double SphSystemData3::kernelRadius() const { return _kernelRadius; }
 
 double SphSystemData3::sumOfKernelNearby(const Vector3D& origin) const {
     double sum = 0.0;
+    auto x = positions();
     SphStdKernel3 kernel(_kernelRadius);
+
+    // With skin, the searcher may hold older positions. Query with the skin
+    // and measure the distances from the current positions instead.
     neighborSearcher()->forEachNearbyPoint(
-        origin, _kernelRadius, [&](size_t, const Vector3D& neighborPosition) {
-            double dist = origin.distanceTo(neighborPosition);
+        origin, _kernelRadius + skinRadius(), [&](size_t i, const Vector3D&) {
+            double dist = origin.distanceTo(x[i]);
             sum += kernel(dist);
         });
     return sum;
@@ -129,13 +169,14 @@ double SphSystemData3::sumOfKernelNearby(const Vector3D& origin) const {
 double SphSystemData3::interpolate(
     const Vector3D& origin, const ConstArrayAccessor1<double>& values) const {
     double sum = 0.0;
+    auto x = positions();
     auto d = densities();
     SphStdKernel3 kernel(_kernelRadius);
     const double m = mass();
 
     neighborSearcher()->forEachNearbyPoint(
-        origin, _kernelRadius, [&](size_t i, const Vector3D& neighborPosition) {
-            double dist = origin.distanceTo(neighborPosition);
+        origin, _kernelRadius + skinRadius(), [&](size_t i, const Vector3D&) {
+            double dist = origin.distanceTo(x[i]);
             double weight = m / d[i] * kernel(dist);
             sum += weight * values[i];
         });
@@ -146,13 +187,14 @@ double SphSystemData3::interpolate(
 Vector3D SphSystemData3::interpolate(
     const Vector3D& origin, const ConstArrayAccessor1<Vector3D>& values) const {
     Vector3D sum;
+    auto x = positions();
     auto d = densities();
     SphStdKernel3 kernel(_kernelRadius);
     const double m = mass();
 
     neighborSearcher()->forEachNearbyPoint(
-        origin, _kernelRadius, [&](size_t i, const Vector3D& neighborPosition) {
-            double dist = origin.distanceTo(neighborPosition);
+        origin, _kernelRadius + skinRadius(), [&](size_t i, const Vector3D&) {
+            double dist = origin.distanceTo(x[i]);
             double weight = m / d[i] * kernel(dist);
             sum += weight * values[i];
         });
@@ -165,12 +207,11 @@ Vector3D SphSystemData3::gradientAt(
     Vector3D sum;
     auto p = positions();
     auto d = densities();
-    const auto& neighbors = neighborLists()[i];
     Vector3D origin = p[i];
     SphSpikyKernel3 kernel(_kernelRadius);
     const double m = mass();
 
-    for (size_t j : neighbors) {
+    forEachNeighbor(i, [&](size_t j) {
         Vector3D neighborPosition = p[j];
         double dist = origin.distanceTo(neighborPosition);
         if (dist > 0.0) {
@@ -179,7 +220,7 @@ Vector3D SphSystemData3::gradientAt(
                    (values[i] / square(d[i]) + values[j] / square(d[j])) *
                    kernel.gradient(dist, dir);
         }
-    }
+    });
 
     return sum;
 }
@@ -189,17 +230,16 @@ double SphSystemData3::laplacianAt(
     double sum = 0.0;
     auto p = positions();
     auto d = densities();
-    const auto& neighbors = neighborLists()[i];
     Vector3D origin = p[i];
     SphSpikyKernel3 kernel(_kernelRadius);
     const double m = mass();
 
-    for (size_t j : neighbors) {
+    forEachNeighbor(i, [&](size_t j) {
         Vector3D neighborPosition = p[j];
         double dist = origin.distanceTo(neighborPosition);
         sum +=
             m * (values[j] - values[i]) / d[j] * kernel.secondDerivative(dist);
-    }
+    });
 
     return sum;
 }
@@ -209,17 +249,16 @@ Vector3D SphSystemData3::laplacianAt(
     Vector3D sum;
     auto p = positions();
     auto d = densities();
-    const auto& neighbors = neighborLists()[i];
     Vector3D origin = p[i];
     SphSpikyKernel3 kernel(_kernelRadius);
     const double m = mass();
 
-    for (size_t j : neighbors) {
+    forEachNeighbor(i, [&](size_t j) {
         Vector3D neighborPosition = p[j];
         double dist = origin.distanceTo(neighborPosition);
         sum +=
             m * (values[j] - values[i]) / d[j] * kernel.secondDerivative(dist);
-    }
+    });
 
     return sum;
 }
@@ -232,6 +271,10 @@ void SphSystemData3::buildNeighborLists() {
     ParticleSystemData3::buildNeighborLists(_kernelRadius);
 }
 
+bool SphSystemData3::needsNeighborListsRebuild() const {
+    return ParticleSystemData3::needsNeighborListsRebuild(_kernelRadius);
+}
+
 void SphSystemData3::computeMass() {
     Array1<Vector3D> points;
     BccLatticePointGenerator pointsGenerator;
@@ -7,7 +7,9 @@
 #include <pch.h>
 
 #include <jet/bcc_lattice_point_generator.h>
+#include <jet/parallel.h>
 #include <jet/point_hash_grid_searcher3.h>
+#include <jet/point_parallel_hash_grid_searcher3.h>
 #include <jet/samplers.h>
 #include <jet/surface_to_implicit3.h>
 #include <jet/volume_particle_emitter3.h>
@@ -16,12 +18,29 @@ using namespace jet;
 
 static const size_t kDefaultHashGridResolution = 64;
 
+static const size_t kEmissionChunkSize = 1 << 16;
+
+static const uint64_t kGoldenRatio64 = 0x9e3779b97f4a7c15ULL;
+
+// SplitMix64 finalizer.
+inline uint64_t mixBits(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// Returns a uniform random number in [0, 1) from the stream key and counter.
+inline double uniformRandom(uint64_t key, uint64_t counter) {
+    const uint64_t bits = mixBits(key ^ mixBits(counter * kGoldenRatio64));
+    return static_cast<double>(bits >> 11) * (1.0 / 9007199254740992.0);
+}
+
 VolumeParticleEmitter3::VolumeParticleEmitter3(
     const ImplicitSurface3Ptr& implicitSurface, const BoundingBox3D& maxRegion,
     double spacing, const Vector3D& initialVel, const Vector3D& linearVel,
     const Vector3D& angularVel, size_t maxNumberOfParticles, double jitter,
     bool isOneShot, bool allowOverlapping, uint32_t seed)
-    : _rng(seed),
+    : _seed(seed),
       _implicitSurface(implicitSurface),
       _bounds(maxRegion),
       _spacing(spacing),
@@ -69,6 +88,10 @@ void VolumeParticleEmitter3::emit(const ParticleSystemData3Ptr& particles,
         return;
     }
 
+    if (_numberOfEmittedParticles >= _maxNumberOfParticles) {
+        return;
+    }
+
     _implicitSurface->updateQueryEngine();
 
     BoundingBox3D region = _bounds;
@@ -81,54 +104,98 @@ void VolumeParticleEmitter3::emit(const ParticleSystemData3Ptr& particles,
     // Reserving more space for jittering
     const double j = jitter();
     const double maxJitterDist = 0.5 * j * _spacing;
+    const bool checksOverlaps = !(_allowOverlapping || _isOneShot);
+    const uint64_t streamKey = mixBits(
+        static_cast<uint64_t>(_seed) * kGoldenRatio64 + _numberOfEmissions);
     size_t numNewParticles = 0;
+    ++_numberOfEmissions;
+
+    // Existing particles are queried in parallel while the particles emitted
+    // within this call are resolved serially in the lattice order. The
+    // searchers are only allocated when the overlaps are checked.
+    std::unique_ptr<PointParallelHashGridSearcher3> particleSearcher;
+    std::unique_ptr<PointHashGridSearcher3> newParticleSearcher;
+    if (checksOverlaps) {
+        const Size3 resolution(kDefaultHashGridResolution,
+                               kDefaultHashGridResolution,
+                               kDefaultHashGridResolution);
+        particleSearcher.reset(
+            new PointParallelHashGridSearcher3(resolution, 2.0 * _spacing));
+        particleSearcher->build(particles->positions());
+        newParticleSearcher.reset(
+            new PointHashGridSearcher3(resolution, 2.0 * _spacing));
+    }
 
-    if (_allowOverlapping || _isOneShot) {
-        _pointsGen->forEachPoint(region, _spacing, [&](const Vector3D& point) {
-            Vector3D randomDir = uniformSampleSphere(random(), random());
-            Vector3D offset = maxJitterDist * randomDir;
-            Vector3D candidate = point + offset;
-            if (_implicitSurface->signedDistance(candidate) <= 0.0) {
-                if (_numberOfEmittedParticles < _maxNumberOfParticles) {
-                    newPositions->append(candidate);
-                    ++_numberOfEmittedParticles;
-                    ++numNewParticles;
-                } else {
-                    return false;
-                }
+    Array1<Vector3D> candidates;
+    Array1<char> isValid;
+    candidates.reserve(kEmissionChunkSize);
+    uint64_t numberOfVisitedPoints = 0;
+
+    // Evaluates the buffered lattice points in parallel and appends the valid
+    // ones in order. Returns false once the particle budget runs out.
+    auto processCandidates = [&]() {
+        const size_t n = candidates.size();
+        const uint64_t firstPointIndex = numberOfVisitedPoints;
+        isValid.resize(n);
+
+        parallelFor(kZeroSize, n, [&](size_t i) {
+            // Counter-based jitter so that the result does not depend on the
+            // number of threads.
+            const uint64_t counter = 2 * (firstPointIndex + i);
+            Vector3D randomDir = uniformSampleSphere(
+                uniformRandom(streamKey, counter),
+                uniformRandom(streamKey, counter + 1));
+            Vector3D candidate = candidates[i] + maxJitterDist * randomDir;
+            candidates[i] = candidate;
+
+            if (checksOverlaps) {
+                isValid[i] = _implicitSurface->isInside(candidate) &&
+                             !particleSearcher->hasNearbyPoint(candidate,
+                                                               _spacing);
+            } else {
+                isValid[i] = _implicitSurface->signedDistance(candidate) <= 0.0;
             }
-
-            return true;
         });
-    } else {
-        // Use serial hash grid searcher for continuous update.
-        PointHashGridSearcher3 neighborSearcher(
-            Size3(kDefaultHashGridResolution, kDefaultHashGridResolution,
-                  kDefaultHashGridResolution),
-            2.0 * _spacing);
-        if (!_allowOverlapping) {
-            neighborSearcher.build(particles->positions());
-        }
 
-        _pointsGen->forEachPoint(region, _spacing, [&](const Vector3D& point) {
-            Vector3D randomDir = uniformSampleSphere(random(), random());
-            Vector3D offset = maxJitterDist * randomDir;
-            Vector3D candidate = point + offset;
-            if (_implicitSurface->isInside(candidate) &&
-                (!_allowOverlapping &&
-                 !neighborSearcher.hasNearbyPoint(candidate, _spacing))) {
-                if (_numberOfEmittedParticles < _maxNumberOfParticles) {
-                    newPositions->append(candidate);
-                    neighborSearcher.add(candidate);
-                    ++_numberOfEmittedParticles;
-                    ++numNewParticles;
-                } else {
-                    return false;
-                }
+        numberOfVisitedPoints += n;
+
+        for (size_t i = 0; i < n; ++i) {
+            if (!isValid[i]) {
+                continue;
             }
 
-            return true;
-        });
+            if (checksOverlaps &&
+                newParticleSearcher->hasNearbyPoint(candidates[i], _spacing)) {
+                continue;
+            }
+
+            if (_numberOfEmittedParticles >= _maxNumberOfParticles) {
+                return false;
+            }
+
+            newPositions->append(candidates[i]);
+            if (checksOverlaps) {
+                newParticleSearcher->add(candidates[i]);
+            }
+            ++_numberOfEmittedParticles;
+            ++numNewParticles;
+        }
+
+        candidates.clear();
+        return true;
+    };
+
+    bool hasBudget = true;
+    _pointsGen->forEachPoint(region, _spacing, [&](const Vector3D& point) {
+        candidates.append(point);
+        if (candidates.size() == kEmissionChunkSize) {
+            hasBudget = processCandidates();
+        }
+        return hasBudget;
+    });
+
+    if (hasBudget && candidates.size() > 0) {
+        processCandidates();
     }
 
     JET_INFO << "Number of newly generated particles: " << numNewParticles;
@@ -215,11 +282,6 @@ void VolumeParticleEmitter3::setAngularVelocity(const Vector3D& newAngularVel) {
     _angularVel = newAngularVel;
 }
 
-double VolumeParticleEmitter3::random() {
-    std::uniform_real_distribution<> d(0.0, 1.0);
-    return d(_rng);
-}
-
 Vector3D VolumeParticleEmitter3::velocityAt(const Vector3D& point) const {
     Vector3D r = point - _implicitSurface->transform.translation();
     return _linearVel + _angularVel.cross(r) + _initialVel;
@@ -324,6 +386,6 @@ VolumeParticleEmitter3Ptr VolumeParticleEmitter3::Builder::makeShared() const {
         new VolumeParticleEmitter3(_implicitSurface, _bounds, _spacing,
                                    _initialVel, _linearVel, _angularVel,
                                    _maxNumberOfParticles, _jitter, _isOneShot,
-                                   _allowOverlapping),
+                                   _allowOverlapping, _seed),
         [](VolumeParticleEmitter3* obj) { delete obj; });
 }
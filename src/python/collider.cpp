@@ -59,6 +59,13 @@ void addCollider3(py::module& m) {
             This property specifies the friction coefficient to the collider. Any
             negative inputs will be clamped to zero.
             )pbdoc")
+        .def_property("isUsingBroadPhase", &Collider3::isUsingBroadPhase,
+                      &Collider3::setIsUsingBroadPhase, R"pbdoc(
+            True if the broad phase is used for resolving the points.
+
+            The broad phase assumes that the surface returns the Euclidean
+            distance. Disable it for the surfaces that overestimate the distance.
+            )pbdoc")
         .def_property_readonly("surface", &Collider3::surface, R"pbdoc(
             The surface instance.
             )pbdoc")
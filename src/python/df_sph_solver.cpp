@@ -0,0 +1,73 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "df_sph_solver.h"
+#include "pybind11_utils.h"
+
+#include <jet/df_sph_solver3.h>
+
+namespace py = pybind11;
+using namespace jet;
+
+void addDfSphSolver3(py::module& m) {
+    py::class_<DfSphSolver3, DfSphSolver3Ptr, SphSolver3>(m, "DfSphSolver3",
+                                                          R"pbdoc(
+        3-D divergence-free SPH (DFSPH) solver.
+
+        This class implements 3-D divergence-free SPH solver based on Bender and
+        Koschier's 2015 SCA paper. The velocities are corrected so that both the
+        density error and the divergence of the velocity field vanish, and the
+        time step is limited by the CFL condition only.
+        - See Bender and Koschier, Divergence-free smoothed particle hydrodynamics,
+              Proceedings of the 14th ACM SIGGRAPH/Eurographics Symposium on
+              Computer Animation. ACM, 2015.
+        )pbdoc")
+        .def(py::init<double, double, double>(),
+             R"pbdoc(
+             Constructs a solver with target density, spacing, and relative kernel
+             radius.
+             )pbdoc",
+             py::arg("targetDensity") = kWaterDensity,
+             py::arg("targetSpacing") = 0.1,
+             py::arg("relativeKernelRadius") = 1.8)
+        .def_property("maxDensityErrorRatio",
+                      &DfSphSolver3::maxDensityErrorRatio,
+                      &DfSphSolver3::setMaxDensityErrorRatio,
+                      R"pbdoc(
+             The max allowed density error ratio.
+
+             This property sets the max allowed ratio of the largest per-particle
+             density error to the target density. Default is 0.01 (1%). The input
+             value should be positive.
+             )pbdoc")
+        .def_property("maxDivergenceErrorRatio",
+                      &DfSphSolver3::maxDivergenceErrorRatio,
+                      &DfSphSolver3::setMaxDivergenceErrorRatio,
+                      R"pbdoc(
+             The max allowed average divergence error ratio.
+
+             This property sets the max allowed ratio of the average density change
+             over a time step to the target density. Default is 0.001 (0.1%). The
+             input value should be positive.
+             )pbdoc")
+        .def_property("maxNumberOfIterations",
+                      &DfSphSolver3::maxNumberOfIterations,
+                      &DfSphSolver3::setMaxNumberOfIterations,
+                      R"pbdoc(
+             The max number of iterations.
+
+             This property sets the max number of iterations of both density and
+             divergence solvers. Default is 100.
+             )pbdoc")
+        .def_property("maxCfl", &DfSphSolver3::maxCfl,
+                      &DfSphSolver3::setMaxCfl,
+                      R"pbdoc(
+             The CFL number.
+
+             The sub-time step is chosen so that no particle moves more than the
+             CFL number times the target spacing. Default is 0.4.
+             )pbdoc");
+}
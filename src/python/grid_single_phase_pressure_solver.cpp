@@ -68,5 +68,12 @@ void addGridSinglePhasePressureSolver3(py::module& m) {
             &GridSinglePhasePressureSolver3::setLinearSystemSolver,
             R"pbdoc(
             "The linear system solver."
+            )pbdoc")
+        .def_property(
+            "isUsingMatrixFreeSystem",
+            &GridSinglePhasePressureSolver3::isUsingMatrixFreeSystem,
+            &GridSinglePhasePressureSolver3::setIsUsingMatrixFreeSystem,
+            R"pbdoc(
+            True if the solver uses the matrix-free linear system.
             )pbdoc");
 }
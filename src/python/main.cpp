@@ -23,6 +23,7 @@
 #include "custom_scalar_field.h"
 #include "custom_vector_field.h"
 #include "cylinder.h"
+#include "df_sph_solver.h"
 #include "eno_level_set_solver.h"
 #include "face_centered_grid.h"
 #include "fdm_cg_solver.h"
@@ -308,6 +309,7 @@ PYBIND11_MODULE(pyjet, m) {
     addSphSolver3(m);
     addPciSphSolver2(m);
     addPciSphSolver3(m);
+    addDfSphSolver3(m);
 
     // Global functions
     addMarchingCubes(m);
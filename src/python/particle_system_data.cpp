@@ -192,7 +192,10 @@ void addParticleSystemData2(py::module& m) {
              default, PointParallelHashGridSearcher2 is used.
              )pbdoc")
         .def_property_readonly("neighborLists",
-                               &ParticleSystemData2::neighborLists,
+                               [](const ParticleSystemData2& instance) {
+                                   return instance.neighborLists()
+                                       .toNestedLists();
+                               },
                                R"pbdoc(
              The neighbor lists.
 
@@ -272,6 +275,15 @@ void addParticleSystemData3(py::module& m) {
                       R"pbdoc(
              The radius of the particles.
              )pbdoc")
+        .def_property("skinRadius", &ParticleSystemData3::skinRadius,
+                      &ParticleSystemData3::setSkinRadius,
+                      R"pbdoc(
+             The skin radius of the neighbor lists.
+
+             With a positive skin radius, neighbor lists are built with the
+             search radius plus the skin radius and are reused until a particle
+             moves more than half of the skin radius.
+             )pbdoc")
         .def_property("mass", &ParticleSystemData3::mass,
                       &ParticleSystemData3::setMass,
                       R"pbdoc(
@@ -386,8 +398,29 @@ void addParticleSystemData3(py::module& m) {
              This property returns currently set neighbor searcher object. By
              default, PointParallelHashGridSearcher2 is used.
              )pbdoc")
+        .def_property("useSparseNeighborSearcher",
+                      &ParticleSystemData3::useSparseNeighborSearcher,
+                      &ParticleSystemData3::setUseSparseNeighborSearcher,
+                      R"pbdoc(
+             True if the sparse hash grid searcher is used.
+
+             If true, buildNeighborSearcher builds PointSparseHashGridSearcher3
+             which does not wrap the grid cells around a fixed resolution.
+             )pbdoc")
+        .def_property("useNeighborLists",
+                      &ParticleSystemData3::useNeighborLists,
+                      &ParticleSystemData3::setUseNeighborLists,
+                      R"pbdoc(
+             True if the neighbor lists are stored.
+
+             If false, buildNeighborLists does not store the per-particle
+             lists and the neighbors are gathered from the hash grid buckets.
+             )pbdoc")
         .def_property_readonly("neighborLists",
-                               &ParticleSystemData3::neighborLists,
+                               [](const ParticleSystemData3& instance) {
+                                   return instance.neighborLists()
+                                       .toNestedLists();
+                               },
                                R"pbdoc(
              The neighbor lists.
 
@@ -395,6 +428,47 @@ void addParticleSystemData3(py::module& m) {
              PointParallelHashGridSearcher2::buildNeighborLists. Each list stores
              indices of the neighbors.
              )pbdoc")
+        .def("sortParticles",
+             [](ParticleSystemData3& instance) {
+                 Array1<size_t> permutation;
+                 instance.sortParticles(&permutation);
+                 return std::vector<size_t>(permutation.begin(),
+                                            permutation.end());
+             },
+             R"pbdoc(
+             Reorders the particles along the Z-order (Morton) curve.
+
+             All the data layers are reordered and the neighbor searcher and
+             neighbor lists are invalidated. Returns the permutation where the
+             i-th particle after sorting was the permutation[i]-th particle
+             before sorting.
+             )pbdoc")
+        .def("removeParticles",
+             [](ParticleSystemData3& instance, py::list mask) {
+                 if (mask.size() != instance.numberOfParticles()) {
+                     throw std::invalid_argument(
+                         "Wrong input size for removal mask.");
+                 }
+
+                 Array1<char> maskArray(mask.size());
+                 for (size_t i = 0; i < mask.size(); ++i) {
+                     maskArray[i] = mask[i].cast<bool>() ? 1 : 0;
+                 }
+
+                 Array1<size_t> remaining;
+                 instance.removeParticles(maskArray, &remaining);
+                 return std::vector<size_t>(remaining.begin(),
+                                            remaining.end());
+             },
+             R"pbdoc(
+             Removes the particles with true mask values.
+
+             All the data layers are compacted while keeping the order of the
+             remaining particles and the neighbor searcher and neighbor lists are
+             invalidated. Returns the indices where the i-th particle after the
+             removal was the remaining[i]-th particle before the removal.
+             )pbdoc",
+             py::arg("mask"))
         .def("set",
              [](ParticleSystemData3& instance,
                 const ParticleSystemData3Ptr& other) { instance.set(*other); },
@@ -160,5 +160,32 @@ void addParticleSystemSolver3(py::module& m) {
 
              Wind can be applied to the particle system by setting a vector field to
              the solver.
+             )pbdoc")
+        .def_property("particleSortingInterval",
+                      &ParticleSystemSolver3::particleSortingInterval,
+                      &ParticleSystemSolver3::setParticleSortingInterval,
+                      R"pbdoc(
+             The number of sub-steps between particle sorting.
+
+             When positive, the particles are reordered along the Z-order curve
+             every given number of sub-steps. Zero disables the sorting.
+             )pbdoc")
+        .def_property("removesParticlesOutsideDomain",
+                      &ParticleSystemSolver3::removesParticlesOutsideDomain,
+                      &ParticleSystemSolver3::setRemovesParticlesOutsideDomain,
+                      R"pbdoc(
+             True if the particles outside the particle domain are removed.
+
+             When true, the particles outside of particleDomain are removed at the
+             beginning of each sub-step. Default is false.
+             )pbdoc")
+        .def_property("particleDomain",
+                      &ParticleSystemSolver3::particleDomain,
+                      &ParticleSystemSolver3::setParticleDomain,
+                      R"pbdoc(
+             The particle domain.
+
+             The particles outside of this box are removed if
+             removesParticlesOutsideDomain is true.
              )pbdoc");
 }
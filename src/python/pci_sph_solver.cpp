@@ -84,5 +84,15 @@ void addPciSphSolver3(py::module& m) {
              The max number of PCISPH iterations.
 
              This property sets the max number of PCISPH iterations. Default is 5.
+             )pbdoc")
+        .def_property_readonly("lastNumberOfIterations",
+                               &PciSphSolver3::lastNumberOfIterations,
+                               R"pbdoc(
+             The number of PCISPH iterations in the last time-step.
+             )pbdoc")
+        .def_property_readonly("lastIterationTimeInSeconds",
+                               &PciSphSolver3::lastIterationTimeInSeconds,
+                               R"pbdoc(
+             The average wall time of a PCISPH iteration in the last time-step.
              )pbdoc");
 }
@@ -84,5 +84,37 @@ void addPicSolver3(py::module& m) {
                                R"pbdoc(Returns particleSystemData.)pbdoc")
         .def_property("particleEmitter", &PicSolver3::particleEmitter,
                       &PicSolver3::setParticleEmitter,
-                      R"pbdoc(Particle emitter property.)pbdoc");
+                      R"pbdoc(Particle emitter property.)pbdoc")
+        .def_property("particleSortingInterval",
+                      &PicSolver3::particleSortingInterval,
+                      &PicSolver3::setParticleSortingInterval,
+                      R"pbdoc(
+             The number of sub-steps between particle sorting.
+
+             When positive, the particles are reordered along the Z-order curve
+             every given number of sub-steps. Zero disables the sorting.
+             )pbdoc")
+        .def_property("removesParticlesOutsideDomain",
+                      &PicSolver3::removesParticlesOutsideDomain,
+                      &PicSolver3::setRemovesParticlesOutsideDomain,
+                      R"pbdoc(
+             True if the particles outside the grid domain are removed.
+
+             When true, the particles that have left the bounding box of the grid
+             are removed at the beginning of each sub-step. Default is false.
+             )pbdoc")
+        .def_property("isUsingNarrowBand", &PicSolver3::isUsingNarrowBand,
+                      &PicSolver3::setIsUsingNarrowBand,
+                      R"pbdoc(
+             True if the particles are kept only near the liquid surface.
+
+             When true, the particles deeper than the band width are removed
+             and the liquid interior is represented by a grid level set and a
+             grid velocity. Default is false.
+             )pbdoc")
+        .def_property("narrowBandWidth", &PicSolver3::narrowBandWidth,
+                      &PicSolver3::setNarrowBandWidth,
+                      R"pbdoc(
+             The narrow-band width in number of grid cells. Default is 3.
+             )pbdoc");
 }
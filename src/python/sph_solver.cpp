@@ -169,6 +169,36 @@ void addSphSolver3(py::module& m) {
              time-step. When the scale is 1.0, the time-step is bounded by the speed
              of sound and max acceleration.
              )pbdoc")
+        .def_property("isUsingSleeping", &SphSolver3::isUsingSleeping,
+                      &SphSolver3::setIsUsingSleeping,
+                      R"pbdoc(
+             True if quiescent particles are put to sleep.
+
+             Sleeping particles are frozen and skipped in the force passes until
+             a neighbor starts moving again.
+             )pbdoc")
+        .def_property("sleepingVelocityThreshold",
+                      &SphSolver3::sleepingVelocityThreshold,
+                      &SphSolver3::setSleepingVelocityThreshold,
+                      R"pbdoc(
+             The max speed of a particle to fall asleep.
+             )pbdoc")
+        .def_property("sleepingDensityErrorThreshold",
+                      &SphSolver3::sleepingDensityErrorThreshold,
+                      &SphSolver3::setSleepingDensityErrorThreshold,
+                      R"pbdoc(
+             The max density error ratio of a particle to fall asleep.
+             )pbdoc")
+        .def_property("sleepingStepCount", &SphSolver3::sleepingStepCount,
+                      &SphSolver3::setSleepingStepCount,
+                      R"pbdoc(
+             The number of quiescent steps before a particle falls asleep.
+             )pbdoc")
+        .def_property_readonly("numberOfSleepingParticles",
+                               &SphSolver3::numberOfSleepingParticles,
+                               R"pbdoc(
+             The number of sleeping particles in the last time-step.
+             )pbdoc")
         .def_property_readonly("sphSystemData", &SphSolver3::sphSystemData,
                                R"pbdoc(
              The SPH system data.
@@ -117,7 +117,8 @@ void addSphSystemData3(py::module& m) {
             R"pbdoc(
              The pressure array accessor.
              )pbdoc")
-        .def("updateDensities", &SphSystemData3::updateDensities,
+        .def("updateDensities",
+             [](SphSystemData3& instance) { instance.updateDensities(); },
              R"pbdoc(
              Updates the density array with the latest particle positions.
              )pbdoc")
@@ -21,6 +21,8 @@
 #include <jet/surface_to_implicit3.h>
 #include <jet/volume_particle_emitter3.h>
 
+#include <random>
+
 using namespace jet;
 
 JET_TESTS(ApicSolver3);
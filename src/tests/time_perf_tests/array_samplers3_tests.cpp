@@ -0,0 +1,96 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/array1.h>
+#include <jet/array3.h>
+#include <jet/array_samplers3.h>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+using jet::Array1;
+using jet::Array3;
+using jet::Vector3D;
+
+class ArraySamplers3 : public ::benchmark::Fixture {
+ protected:
+    Array3<double> grid;
+    Array1<Vector3D> points;
+    Array1<double> values;
+
+    void SetUp(const ::benchmark::State&) {
+        std::mt19937 rng{0};
+        std::uniform_real_distribution<> dist{0.0, 1.0};
+
+        grid.resize(64, 64, 64);
+        grid.forEachIndex([&](size_t i, size_t j, size_t k) {
+            grid(i, j, k) = dist(rng);
+        });
+
+        points.resize(1 << 16);
+        values.resize(points.size());
+        for (auto& pt : points) {
+            pt = Vector3D(dist(rng), dist(rng), dist(rng));
+        }
+    }
+};
+
+BENCHMARK_DEFINE_F(ArraySamplers3, LinearPointwise)
+(benchmark::State& state) {
+    jet::LinearArraySampler3<double, double> sampler(
+        grid.constAccessor(), Vector3D(1, 1, 1) / 64.0, Vector3D());
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < points.size(); ++i) {
+            values[i] = sampler(points[i]);
+        }
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+BENCHMARK_REGISTER_F(ArraySamplers3, LinearPointwise);
+
+BENCHMARK_DEFINE_F(ArraySamplers3, LinearBatch)
+(benchmark::State& state) {
+    jet::LinearArraySampler3<double, double> sampler(
+        grid.constAccessor(), Vector3D(1, 1, 1) / 64.0, Vector3D());
+    while (state.KeepRunning()) {
+        sampler.sample(points.constAccessor(), values.accessor());
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+BENCHMARK_REGISTER_F(ArraySamplers3, LinearBatch);
+
+BENCHMARK_DEFINE_F(ArraySamplers3, CubicPointwise)
+(benchmark::State& state) {
+    jet::CubicArraySampler3<double, double> sampler(
+        grid.constAccessor(), Vector3D(1, 1, 1) / 64.0, Vector3D());
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < points.size(); ++i) {
+            values[i] = sampler(points[i]);
+        }
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+BENCHMARK_REGISTER_F(ArraySamplers3, CubicPointwise);
+
+BENCHMARK_DEFINE_F(ArraySamplers3, CubicBatch)
+(benchmark::State& state) {
+    jet::CubicArraySampler3<double, double> sampler(
+        grid.constAccessor(), Vector3D(1, 1, 1) / 64.0, Vector3D());
+    while (state.KeepRunning()) {
+        sampler.sample(points.constAccessor(), values.accessor());
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+BENCHMARK_REGISTER_F(ArraySamplers3, CubicBatch);
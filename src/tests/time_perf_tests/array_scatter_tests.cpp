@@ -0,0 +1,58 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/array1.h>
+#include <jet/array3.h>
+#include <jet/array_scatter.h>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+using jet::Array1;
+using jet::Array3;
+using jet::Point3UI;
+using jet::Vector3D;
+
+class ArrayScatter : public ::benchmark::Fixture {
+ protected:
+    Array1<Vector3D> positions;
+    Array1<double> values;
+
+    void SetUp(const ::benchmark::State& state) {
+        std::mt19937 rng{0};
+        std::uniform_real_distribution<> dist{0.0, 1.0};
+
+        int N = state.range(0);
+        positions.resize(N);
+        values.resize(N);
+        for (int i = 0; i < N; ++i) {
+            positions[i] = Vector3D(dist(rng), dist(rng), dist(rng));
+            values[i] = dist(rng);
+        }
+    }
+};
+
+BENCHMARK_DEFINE_F(ArrayScatter, WeightedAverage3)
+(benchmark::State& state) {
+    Array3<double> output(128, 128, 128);
+    Array3<char> markers(128, 128, 128);
+    jet::LinearArraySampler3<double, double> sampler(
+        output.constAccessor(), Vector3D(1, 1, 1) / 128.0, Vector3D());
+
+    while (state.KeepRunning()) {
+        jet::scatterWeightedAverage(
+            positions.size(), sampler,
+            [&](size_t i) { return positions[i]; },
+            [&](size_t i, const Point3UI&) { return values[i]; },
+            output.accessor(), markers.accessor());
+    }
+}
+
+BENCHMARK_REGISTER_F(ArrayScatter, WeightedAverage3)
+    ->Arg(1 << 16)
+    ->Arg(1 << 20)
+    ->Arg(1 << 22);
@@ -0,0 +1,121 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/box3.h>
+#include <jet/df_sph_solver3.h>
+#include <jet/pci_sph_solver3.h>
+#include <jet/rigid_body_collider3.h>
+#include <jet/volume_particle_emitter3.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+
+using jet::Box3;
+using jet::BoundingBox3D;
+using jet::Frame;
+using jet::RigidBodyCollider3;
+using jet::VolumeParticleEmitter3;
+
+namespace {
+
+// Counts the sub-steps and tracks the max density ratio of a solver.
+template <typename Solver>
+class DamBreakSolver : public Solver {
+ public:
+    unsigned int numberOfSteps = 0;
+    double maxDensityRatio = 0.0;
+
+ protected:
+    void onEndAdvanceTimeStep(double timeStepInSeconds) override {
+        Solver::onEndAdvanceTimeStep(timeStepInSeconds);
+
+        auto particles = this->sphSystemData();
+        auto d = particles->densities();
+        for (size_t i = 0; i < d.size(); ++i) {
+            maxDensityRatio = std::max(
+                maxDensityRatio, d[i] / particles->targetDensity());
+        }
+        ++numberOfSteps;
+    }
+};
+
+template <typename Solver>
+void runDamBreak(benchmark::State& state) {
+    const int numberOfFrames = static_cast<int>(state.range(0));
+    const double targetSpacing = 0.03;
+
+    unsigned int numberOfSteps = 0;
+    double maxDensityRatio = 0.0;
+    size_t numberOfParticles = 0;
+
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        DamBreakSolver<Solver> solver;
+        solver.setPseudoViscosityCoefficient(0.0);
+
+        auto particles = solver.sphSystemData();
+        particles->setTargetDensity(1000.0);
+        particles->setTargetSpacing(targetSpacing);
+
+        BoundingBox3D domain({0.0, 0.0, 0.0}, {1.0, 1.0, 0.5});
+        BoundingBox3D sourceBound(domain);
+        sourceBound.expand(-targetSpacing);
+
+        auto column = Box3::builder()
+            .withLowerCorner({0.0, 0.0, 0.0})
+            .withUpperCorner({0.4, 0.6, 0.4})
+            .makeShared();
+        auto emitter = VolumeParticleEmitter3::builder()
+            .withSurface(column)
+            .withSpacing(targetSpacing)
+            .withMaxRegion(sourceBound)
+            .withIsOneShot(true)
+            .makeShared();
+        solver.setEmitter(emitter);
+
+        auto box = Box3::builder()
+            .withBoundingBox(domain)
+            .withIsNormalFlipped(true)
+            .makeShared();
+        solver.setCollider(
+            RigidBodyCollider3::builder().withSurface(box).makeShared());
+        state.ResumeTiming();
+
+        for (Frame frame(0, 1.0 / 60.0); frame.index < numberOfFrames;
+             ++frame) {
+            solver.update(frame);
+        }
+
+        numberOfSteps = solver.numberOfSteps;
+        maxDensityRatio = solver.maxDensityRatio;
+        numberOfParticles = particles->numberOfParticles();
+    }
+
+    state.counters["particles"] = static_cast<double>(numberOfParticles);
+    state.counters["steps"] = numberOfSteps;
+    state.counters["maxDensityRatio"] = maxDensityRatio;
+}
+
+}  // namespace
+
+static void BM_PciSphSolver3DamBreak(benchmark::State& state) {
+    runDamBreak<jet::PciSphSolver3>(state);
+}
+
+BENCHMARK(BM_PciSphSolver3DamBreak)
+    ->Arg(30)
+    ->Iterations(1)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_DfSphSolver3DamBreak(benchmark::State& state) {
+    runDamBreak<jet::DfSphSolver3>(state);
+}
+
+BENCHMARK(BM_DfSphSolver3DamBreak)
+    ->Arg(30)
+    ->Iterations(1)
+    ->Unit(benchmark::kMillisecond);
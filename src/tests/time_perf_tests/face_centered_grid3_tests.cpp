@@ -0,0 +1,80 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/face_centered_grid3.h>
+#include <jet/semi_lagrangian3.h>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+using jet::Vector3D;
+
+class FaceCenteredGrid3 : public ::benchmark::Fixture {
+ protected:
+    jet::FaceCenteredGrid3 grid;
+    std::vector<Vector3D> points;
+
+    void SetUp(const ::benchmark::State& state) {
+        std::mt19937 rng{0};
+        std::uniform_real_distribution<> dist{0.0, 1.0};
+
+        size_t n = static_cast<size_t>(state.range(0));
+        grid.resize(n, n, n, 1.0 / n, 1.0 / n, 1.0 / n);
+        grid.fill([&](const Vector3D& x) {
+            return Vector3D(x.y, -x.x, 0.5 * x.z);
+        });
+
+        points.resize(1 << 16);
+        for (auto& pt : points) {
+            pt = Vector3D(dist(rng), dist(rng), dist(rng));
+        }
+    }
+};
+
+BENCHMARK_DEFINE_F(FaceCenteredGrid3, SampleStdFunction)
+(benchmark::State& state) {
+    const auto sampler = grid.sampler();
+    Vector3D sum;
+    while (state.KeepRunning()) {
+        for (const auto& pt : points) {
+            sum += sampler(pt);
+        }
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+BENCHMARK_REGISTER_F(FaceCenteredGrid3, SampleStdFunction)->Arg(64);
+
+BENCHMARK_DEFINE_F(FaceCenteredGrid3, SampleLinearSampler)
+(benchmark::State& state) {
+    const auto& uSampler = grid.uLinearSampler();
+    const auto& vSampler = grid.vLinearSampler();
+    const auto& wSampler = grid.wLinearSampler();
+    Vector3D sum;
+    while (state.KeepRunning()) {
+        for (const auto& pt : points) {
+            sum += Vector3D(uSampler(pt), vSampler(pt), wSampler(pt));
+        }
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+BENCHMARK_REGISTER_F(FaceCenteredGrid3, SampleLinearSampler)->Arg(64);
+
+BENCHMARK_DEFINE_F(FaceCenteredGrid3, SemiLagrangianAdvect)
+(benchmark::State& state) {
+    jet::SemiLagrangian3 solver;
+    jet::FaceCenteredGrid3 output(grid);
+    while (state.KeepRunning()) {
+        solver.advect(grid, grid, 0.01, &output);
+    }
+}
+
+BENCHMARK_REGISTER_F(FaceCenteredGrid3, SemiLagrangianAdvect)->Arg(64);
@@ -4,6 +4,7 @@
 // personal capacity and am not conveying any rights to any intellectual
 // property of any third parties.
 
+#include <jet/cg.h>
 #include <jet/fdm_linear_system2.h>
 #include <jet/fdm_linear_system3.h>
 
@@ -17,6 +18,9 @@ using jet::FdmVector2;
 using jet::FdmMatrix3;
 using jet::FdmVector3;
 using jet::FdmCompressedLinearSystem3;
+using jet::FdmLinearSystem3;
+using jet::FdmMatrixFree3;
+using jet::FdmMatrixFreeLinearSystem3;
 using jet::Size3;
 
 class FdmBlas2 : public ::benchmark::Fixture {
@@ -153,6 +157,81 @@ class FdmCompressedBlas3 : public ::benchmark::Fixture {
     }
 };
 
+class FdmMatrixFreeBlas3 : public ::benchmark::Fixture {
+ public:
+    FdmMatrixFree3 m;
+    FdmVector3 a;
+    FdmVector3 b;
+
+    void SetUp(const ::benchmark::State& state) {
+        const auto dim = static_cast<size_t>(state.range(0));
+
+        m.resize({dim, dim, dim});
+        m.invHSqr = {1.0, 1.0, 1.0};
+        a.resize(dim, dim, dim);
+        b.resize(dim, dim, dim);
+
+        std::mt19937 rng;
+        std::uniform_real_distribution<> d(0.0, 1.0);
+
+        // Mostly fluid cells with the faces open except on the boundary
+        m.flags.forEachIndex([&](size_t i, size_t j, size_t k) {
+            uint8_t flags = (d(rng) < 0.9) ? FdmMatrixFree3::kActive : 0;
+            flags |= (i > 0) ? FdmMatrixFree3::kOpenLeft : 0;
+            flags |= (i + 1 < dim) ? FdmMatrixFree3::kOpenRight : 0;
+            flags |= (j > 0) ? FdmMatrixFree3::kOpenDown : 0;
+            flags |= (j + 1 < dim) ? FdmMatrixFree3::kOpenUp : 0;
+            flags |= (k > 0) ? FdmMatrixFree3::kOpenBack : 0;
+            flags |= (k + 1 < dim) ? FdmMatrixFree3::kOpenFront : 0;
+            m.flags(i, j, k) = flags;
+            a(i, j, k) = d(rng);
+        });
+    }
+};
+
+class FdmCg3 : public ::benchmark::Fixture {
+ public:
+    FdmLinearSystem3 system;
+    FdmMatrixFreeLinearSystem3 mfSystem;
+    FdmCompressedLinearSystem3 compSystem;
+    FdmVector3 r, d, q, s;
+    jet::VectorND rComp, dComp, qComp, sComp;
+
+    void SetUp(const ::benchmark::State& state) {
+        const auto dim = static_cast<size_t>(state.range(0));
+
+        // Poisson problem with the outermost cells as the Dirichlet boundary
+        mfSystem.resize({dim, dim, dim});
+        mfSystem.A.invHSqr = {1.0, 1.0, 1.0};
+        mfSystem.A.flags.forEachIndex([&](size_t i, size_t j, size_t k) {
+            const bool isInterior = i > 0 && j > 0 && k > 0 && i + 1 < dim &&
+                                    j + 1 < dim && k + 1 < dim;
+            mfSystem.A.flags(i, j, k) = isInterior
+                ? FdmMatrixFree3::kActive | FdmMatrixFree3::kOpenLeft |
+                      FdmMatrixFree3::kOpenRight | FdmMatrixFree3::kOpenDown |
+                      FdmMatrixFree3::kOpenUp | FdmMatrixFree3::kOpenBack |
+                      FdmMatrixFree3::kOpenFront
+                : 0;
+            mfSystem.b(i, j, k) = isInterior ? 1.0 : 0.0;
+        });
+
+        system.resize({dim, dim, dim});
+        mfSystem.A.toMatrix(&system.A);
+        system.b = mfSystem.b;
+
+        FdmCompressedBlas3::buildSystem(&compSystem, {dim, dim, dim});
+
+        r.resize(dim, dim, dim);
+        d.resize(dim, dim, dim);
+        q.resize(dim, dim, dim);
+        s.resize(dim, dim, dim);
+        rComp.resize(compSystem.b.size());
+        dComp.resize(compSystem.b.size());
+        qComp.resize(compSystem.b.size());
+        sComp.resize(compSystem.b.size());
+    }
+};
+
 BENCHMARK_DEFINE_F(FdmBlas2, Mvm)(benchmark::State& state) {
     while (state.KeepRunning()) {
         jet::FdmBlas2::mvm(m, a, &b);
@@ -179,3 +258,97 @@ BENCHMARK_REGISTER_F(FdmCompressedBlas3, Mvm)
     ->Arg(1 << 4)
     ->Arg(1 << 6)
     ->Arg(1 << 8);
+
+BENCHMARK_DEFINE_F(FdmMatrixFreeBlas3, Mvm)(benchmark::State& state) {
+    while (state.KeepRunning()) {
+        jet::FdmMatrixFreeBlas3::mvm(m, a, &b);
+    }
+}
+
+BENCHMARK_REGISTER_F(FdmMatrixFreeBlas3, Mvm)
+    ->Arg(1 << 4)
+    ->Arg(1 << 6)
+    ->Arg(1 << 8);
+
+// Runs a fixed number of CG iterations with the separate (0) or the fused (1)
+// kernels.
+BENCHMARK_DEFINE_F(FdmCg3, Solve)(benchmark::State& state) {
+    const bool isFused = state.range(1) != 0;
+    const unsigned int kNumIterations = 50;
+    unsigned int numIter = 0;
+    double residual = 0.0;
+
+    while (state.KeepRunning()) {
+        system.x.set(0.0);
+        if (isFused) {
+            jet::cgFused<jet::FdmBlas3>(system.A, system.b, kNumIterations,
+                                        0.0, &system.x, &r, &d, &q, &s,
+                                        &numIter, &residual);
+        } else {
+            jet::cg<jet::FdmBlas3>(system.A, system.b, kNumIterations, 0.0,
+                                   &system.x, &r, &d, &q, &s, &numIter,
+                                   &residual);
+        }
+    }
+}
+
+BENCHMARK_REGISTER_F(FdmCg3, Solve)
+    ->Args({1 << 6, 0})
+    ->Args({1 << 6, 1})
+    ->Args({1 << 7, 0})
+    ->Args({1 << 7, 1})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(FdmCg3, SolveMatrixFree)(benchmark::State& state) {
+    const bool isFused = state.range(1) != 0;
+    const unsigned int kNumIterations = 50;
+    unsigned int numIter = 0;
+    double residual = 0.0;
+
+    while (state.KeepRunning()) {
+        mfSystem.x.set(0.0);
+        if (isFused) {
+            jet::cgFused<jet::FdmMatrixFreeBlas3>(
+                mfSystem.A, mfSystem.b, kNumIterations, 0.0, &mfSystem.x, &r,
+                &d, &q, &s, &numIter, &residual);
+        } else {
+            jet::cg<jet::FdmMatrixFreeBlas3>(
+                mfSystem.A, mfSystem.b, kNumIterations, 0.0, &mfSystem.x, &r,
+                &d, &q, &s, &numIter, &residual);
+        }
+    }
+}
+
+BENCHMARK_REGISTER_F(FdmCg3, SolveMatrixFree)
+    ->Args({1 << 6, 0})
+    ->Args({1 << 6, 1})
+    ->Args({1 << 7, 0})
+    ->Args({1 << 7, 1})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(FdmCg3, SolveCompressed)(benchmark::State& state) {
+    const bool isFused = state.range(1) != 0;
+    const unsigned int kNumIterations = 50;
+    unsigned int numIter = 0;
+    double residual = 0.0;
+
+    while (state.KeepRunning()) {
+        compSystem.x.set(0.0);
+        if (isFused) {
+            jet::cgFused<jet::FdmCompressedBlas3>(
+                compSystem.A, compSystem.b, kNumIterations, 0.0, &compSystem.x,
+                &rComp, &dComp, &qComp, &sComp, &numIter, &residual);
+        } else {
+            jet::cg<jet::FdmCompressedBlas3>(
+                compSystem.A, compSystem.b, kNumIterations, 0.0, &compSystem.x,
+                &rComp, &dComp, &qComp, &sComp, &numIter, &residual);
+        }
+    }
+}
+
+BENCHMARK_REGISTER_F(FdmCg3, SolveCompressed)
+    ->Args({1 << 6, 0})
+    ->Args({1 << 6, 1})
+    ->Args({1 << 7, 0})
+    ->Args({1 << 7, 1})
+    ->Unit(benchmark::kMillisecond);
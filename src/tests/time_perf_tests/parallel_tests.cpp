@@ -87,3 +87,53 @@ BENCHMARK_REGISTER_F(Parallel, ParallelRangeFor)
     ->Args({1 << 24, 2})
     ->Args({1 << 24, 4})
     ->Args({1 << 24, 8});
+
+// Measures the fixed per-call cost of the tasking backend. Build with different
+// JET_TASKING_SYSTEM values (CPP11Threads, TBB, OpenMP) to compare backends.
+BENCHMARK_DEFINE_F(Parallel, ParallelForOverhead)(benchmark::State& state) {
+    unsigned int oldNumThreads = jet::maxNumberOfThreads();
+    jet::setMaxNumberOfThreads(numThreads);
+
+    while (state.KeepRunning()) {
+        jet::parallelFor(jet::kZeroSize, n, [this](size_t i) { c[i] = a[i]; });
+    }
+
+    jet::setMaxNumberOfThreads(oldNumThreads);
+}
+
+BENCHMARK_REGISTER_F(Parallel, ParallelForOverhead)
+    ->UseRealTime()
+    ->Args({1, 1})
+    ->Args({1, 8})
+    ->Args({1 << 4, 1})
+    ->Args({1 << 4, 2})
+    ->Args({1 << 4, 4})
+    ->Args({1 << 4, 8});
+
+BENCHMARK_DEFINE_F(Parallel, ParallelSort)(benchmark::State& state) {
+    unsigned int oldNumThreads = jet::maxNumberOfThreads();
+    jet::setMaxNumberOfThreads(numThreads);
+
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = d(rng);
+    }
+
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        c = a;
+        state.ResumeTiming();
+
+        jet::parallelSort(c.begin(), c.end());
+    }
+
+    jet::setMaxNumberOfThreads(oldNumThreads);
+}
+
+BENCHMARK_REGISTER_F(Parallel, ParallelSort)
+    ->UseRealTime()
+    ->Args({1 << 8, 1})
+    ->Args({1 << 8, 8})
+    ->Args({1 << 16, 1})
+    ->Args({1 << 16, 2})
+    ->Args({1 << 16, 4})
+    ->Args({1 << 16, 8});
@@ -0,0 +1,104 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/particle_system_data3.h>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+using jet::Vector3D;
+
+class ParticleSystemData3 : public ::benchmark::Fixture {
+ protected:
+    const double searchRadius = 0.02;
+    jet::ParticleSystemData3 particles;
+
+    void SetUp(const ::benchmark::State& state) {
+        std::mt19937 rng{0};
+        std::uniform_real_distribution<> dist{0.0, 1.0};
+
+        int N = state.range(0);
+        jet::Array1<Vector3D> points(N);
+        for (int i = 0; i < N; ++i) {
+            points[i] = Vector3D(dist(rng), dist(rng), dist(rng));
+        }
+
+        particles.resize(0);
+        particles.addParticles(points);
+    }
+};
+
+BENCHMARK_DEFINE_F(ParticleSystemData3, SortParticles)
+(benchmark::State& state) {
+    while (state.KeepRunning()) {
+        particles.sortParticles();
+    }
+}
+
+BENCHMARK_REGISTER_F(ParticleSystemData3, SortParticles)
+    ->Arg(1 << 10)
+    ->Arg(1 << 16)
+    ->Arg(1 << 20);
+
+BENCHMARK_DEFINE_F(ParticleSystemData3, BuildNeighborListsUnsorted)
+(benchmark::State& state) {
+    particles.buildNeighborSearcher(searchRadius);
+    while (state.KeepRunning()) {
+        particles.buildNeighborLists(searchRadius);
+    }
+}
+
+BENCHMARK_REGISTER_F(ParticleSystemData3, BuildNeighborListsUnsorted)
+    ->Arg(1 << 16)
+    ->Arg(1 << 20);
+
+BENCHMARK_DEFINE_F(ParticleSystemData3, BuildNeighborListsSorted)
+(benchmark::State& state) {
+    particles.sortParticles();
+    particles.buildNeighborSearcher(searchRadius);
+    while (state.KeepRunning()) {
+        particles.buildNeighborLists(searchRadius);
+    }
+}
+
+BENCHMARK_REGISTER_F(ParticleSystemData3, BuildNeighborListsSorted)
+    ->Arg(1 << 16)
+    ->Arg(1 << 20);
+
+BENCHMARK_DEFINE_F(ParticleSystemData3, AddParticle)
+(benchmark::State& state) {
+    auto x = particles.positions();
+    while (state.KeepRunning()) {
+        jet::ParticleSystemData3 target;
+        for (size_t i = 0; i < x.size(); ++i) {
+            target.addParticle(x[i]);
+        }
+    }
+}
+
+BENCHMARK_REGISTER_F(ParticleSystemData3, AddParticle)
+    ->Arg(1 << 16);
+
+BENCHMARK_DEFINE_F(ParticleSystemData3, AddParticlesInChunks)
+(benchmark::State& state) {
+    const size_t chunkSize = 256;
+    auto x = particles.positions();
+    jet::Array1<Vector3D> chunk(chunkSize);
+    while (state.KeepRunning()) {
+        jet::ParticleSystemData3 target;
+        for (size_t i = 0; i + chunkSize <= x.size(); i += chunkSize) {
+            for (size_t j = 0; j < chunkSize; ++j) {
+                chunk[j] = x[i + j];
+            }
+            target.addParticles(chunk);
+        }
+    }
+}
+
+BENCHMARK_REGISTER_F(ParticleSystemData3, AddParticlesInChunks)
+    ->Arg(1 << 16)
+    ->Arg(1 << 20);
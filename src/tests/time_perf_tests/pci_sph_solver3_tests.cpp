@@ -0,0 +1,141 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/box3.h>
+#include <jet/pci_sph_solver3.h>
+#include <jet/rigid_body_collider3.h>
+#include <jet/volume_particle_emitter3.h>
+
+#include <benchmark/benchmark.h>
+
+using jet::Array1;
+using jet::Box3;
+using jet::BoundingBox3D;
+using jet::Frame;
+using jet::PciSphSolver3;
+using jet::RigidBodyCollider3;
+using jet::Vector3D;
+using jet::VolumeParticleEmitter3;
+
+namespace {
+
+// Counts the sub-steps, the sleeping particles and the PCISPH iterations of
+// each sub-step.
+class SettledPoolSolver : public PciSphSolver3 {
+ public:
+    unsigned int numberOfSteps = 0;
+    double sumSleepingRatio = 0.0;
+    unsigned int numberOfIterations = 0;
+    double iterationTimeInSeconds = 0.0;
+
+ protected:
+    void onEndAdvanceTimeStep(double timeStepInSeconds) override {
+        PciSphSolver3::onEndAdvanceTimeStep(timeStepInSeconds);
+
+        sumSleepingRatio
+            += static_cast<double>(numberOfSleepingParticles())
+            / sphSystemData()->numberOfParticles();
+        numberOfIterations += lastNumberOfIterations();
+        iterationTimeInSeconds
+            += lastNumberOfIterations() * lastIterationTimeInSeconds();
+        ++numberOfSteps;
+    }
+};
+
+}  // namespace
+
+static void BM_PciSphSolver3SettledPool(benchmark::State& state) {
+    const bool isUsingSleeping = state.range(0) != 0;
+    const double targetSpacing = 0.04;
+
+    unsigned int numberOfSteps = 0;
+    double sumSleepingRatio = 0.0;
+    unsigned int numberOfIterations = 0;
+    double iterationTimeInSeconds = 0.0;
+    size_t numberOfParticles = 0;
+
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        SettledPoolSolver solver;
+        solver.setIsUsingSleeping(isUsingSleeping);
+
+        auto particles = solver.sphSystemData();
+        particles->setTargetDensity(1000.0);
+        particles->setTargetSpacing(targetSpacing);
+
+        BoundingBox3D domain({0.0, 0.0, 0.0}, {1.0, 1.0, 0.5});
+        BoundingBox3D sourceBound(domain);
+        sourceBound.expand(-targetSpacing);
+
+        auto pool = Box3::builder()
+            .withLowerCorner({0.0, 0.0, 0.0})
+            .withUpperCorner({1.0, 0.25, 0.5})
+            .makeShared();
+        auto emitter = VolumeParticleEmitter3::builder()
+            .withSurface(pool)
+            .withSpacing(targetSpacing)
+            .withMaxRegion(sourceBound)
+            .withIsOneShot(true)
+            .makeShared();
+        solver.setEmitter(emitter);
+
+        auto box = Box3::builder()
+            .withBoundingBox(domain)
+            .withIsNormalFlipped(true)
+            .makeShared();
+        solver.setCollider(
+            RigidBodyCollider3::builder().withSurface(box).makeShared());
+
+        // Let the pool settle down
+        Frame frame(0, 1.0 / 60.0);
+        for (; frame.index < 40; ++frame) {
+            solver.update(frame);
+        }
+
+        // Drop a small block onto the pool
+        Array1<Vector3D> block;
+        for (int k = 0; k < 3; ++k) {
+            for (int j = 0; j < 3; ++j) {
+                for (int i = 0; i < 3; ++i) {
+                    block.append(
+                        Vector3D(0.45, 0.5, 0.2)
+                        + targetSpacing * Vector3D(i, j, k));
+                }
+            }
+        }
+        particles->addParticles(block);
+
+        solver.numberOfSteps = 0;
+        solver.sumSleepingRatio = 0.0;
+        solver.numberOfIterations = 0;
+        solver.iterationTimeInSeconds = 0.0;
+        state.ResumeTiming();
+
+        for (; frame.index < 70; ++frame) {
+            solver.update(frame);
+        }
+
+        numberOfSteps = solver.numberOfSteps;
+        sumSleepingRatio = solver.sumSleepingRatio;
+        numberOfIterations = solver.numberOfIterations;
+        iterationTimeInSeconds = solver.iterationTimeInSeconds;
+        numberOfParticles = particles->numberOfParticles();
+    }
+
+    state.counters["particles"] = static_cast<double>(numberOfParticles);
+    state.counters["steps"] = numberOfSteps;
+    state.counters["sleepingRatio"]
+        = numberOfSteps > 0 ? sumSleepingRatio / numberOfSteps : 0.0;
+    state.counters["iterations"] = numberOfIterations;
+    state.counters["iterationMs"] = numberOfIterations > 0
+        ? 1000.0 * iterationTimeInSeconds / numberOfIterations : 0.0;
+}
+
+BENCHMARK(BM_PciSphSolver3SettledPool)
+    ->Arg(0)
+    ->Arg(1)
+    ->Iterations(1)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,139 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/array1.h>
+#include <jet/logging.h>
+#include <jet/point_parallel_hash_grid_searcher3.h>
+#include <jet/point_sparse_hash_grid_searcher3.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <random>
+
+using jet::Array1;
+using jet::Vector3D;
+
+// Compares the sparse hash grid against the fixed 64^3 hash grid. The first
+// argument is the number of points and the second argument is the domain
+// shape: 0 for a unit cube, 1 for a 100 x 1 x 100 sheet. The grid spacing is
+// chosen so that a non-empty cell has about 8 points on average.
+class PointSparseHashGridSearcher3 : public ::benchmark::Fixture {
+ protected:
+    Array1<Vector3D> points;
+    Array1<Vector3D> queries;
+    double gridSpacing = 1.0;
+
+    void SetUp(const ::benchmark::State& state) {
+        jet::Logging::mute();
+
+        size_t n = static_cast<size_t>(state.range(0));
+        bool isSheet = state.range(1) == 1;
+        Vector3D extent = isSheet ? Vector3D(100, 1, 100) : Vector3D(1, 1, 1);
+        double volume = extent.x * extent.y * extent.z;
+        gridSpacing = std::cbrt(8.0 * volume / n);
+
+        std::mt19937 rng{0};
+        std::uniform_real_distribution<> dist{0.0, 1.0};
+
+        points.resize(n);
+        for (auto& pt : points) {
+            pt = Vector3D(extent.x * dist(rng), extent.y * dist(rng),
+                          extent.z * dist(rng));
+        }
+
+        queries.resize(1 << 16);
+        for (auto& pt : queries) {
+            pt = Vector3D(extent.x * dist(rng), extent.y * dist(rng),
+                          extent.z * dist(rng));
+        }
+    }
+
+    void TearDown(const ::benchmark::State&) {
+        jet::Logging::unmute();
+    }
+
+    template <typename Searcher>
+    size_t query(const Searcher& searcher) const {
+        size_t cnt = 0;
+        for (const auto& pt : queries) {
+            searcher.forEachNearbyPoint(
+                pt, 0.5 * gridSpacing,
+                [&](size_t, const Vector3D&) { ++cnt; });
+        }
+        return cnt;
+    }
+};
+
+BENCHMARK_DEFINE_F(PointSparseHashGridSearcher3, BuildFixedHashGrid)
+(benchmark::State& state) {
+    while (state.KeepRunning()) {
+        jet::PointParallelHashGridSearcher3 grid(64, 64, 64, gridSpacing);
+        grid.build(points);
+    }
+}
+
+BENCHMARK_REGISTER_F(PointSparseHashGridSearcher3, BuildFixedHashGrid)
+    ->Args({1 << 20, 0})
+    ->Args({1 << 20, 1})
+    ->Args({1 << 23, 0})
+    ->Args({1 << 23, 1})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(PointSparseHashGridSearcher3, BuildSparseHashGrid)
+(benchmark::State& state) {
+    while (state.KeepRunning()) {
+        jet::PointSparseHashGridSearcher3 grid(gridSpacing);
+        grid.build(points);
+    }
+}
+
+BENCHMARK_REGISTER_F(PointSparseHashGridSearcher3, BuildSparseHashGrid)
+    ->Args({1 << 20, 0})
+    ->Args({1 << 20, 1})
+    ->Args({1 << 23, 0})
+    ->Args({1 << 23, 1})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(PointSparseHashGridSearcher3, QueryFixedHashGrid)
+(benchmark::State& state) {
+    jet::PointParallelHashGridSearcher3 grid(64, 64, 64, gridSpacing);
+    grid.build(points);
+
+    size_t cnt = 0;
+    while (state.KeepRunning()) {
+        cnt += query(grid);
+    }
+    benchmark::DoNotOptimize(cnt);
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+
+BENCHMARK_REGISTER_F(PointSparseHashGridSearcher3, QueryFixedHashGrid)
+    ->Args({1 << 20, 0})
+    ->Args({1 << 20, 1})
+    ->Args({1 << 23, 0})
+    ->Args({1 << 23, 1})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(PointSparseHashGridSearcher3, QuerySparseHashGrid)
+(benchmark::State& state) {
+    jet::PointSparseHashGridSearcher3 grid(gridSpacing);
+    grid.build(points);
+
+    size_t cnt = 0;
+    while (state.KeepRunning()) {
+        cnt += query(grid);
+    }
+    benchmark::DoNotOptimize(cnt);
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+
+BENCHMARK_REGISTER_F(PointSparseHashGridSearcher3, QuerySparseHashGrid)
+    ->Args({1 << 20, 0})
+    ->Args({1 << 20, 1})
+    ->Args({1 << 23, 0})
+    ->Args({1 << 23, 1})
+    ->Unit(benchmark::kMillisecond);
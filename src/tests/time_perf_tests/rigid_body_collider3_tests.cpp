@@ -0,0 +1,80 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/array1.h>
+#include <jet/box3.h>
+#include <jet/rigid_body_collider3.h>
+#include <jet/sphere3.h>
+#include <jet/surface_set3.h>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+using jet::Array1;
+using jet::Box3;
+using jet::Sphere3;
+using jet::SurfaceSet3;
+using jet::Vector3D;
+
+class RigidBodyCollider3 : public ::benchmark::Fixture {
+ public:
+    std::shared_ptr<jet::RigidBodyCollider3> collider;
+    Array1<Vector3D> positions;
+    Array1<Vector3D> velocities;
+    Array1<Vector3D> newPositions;
+    Array1<Vector3D> newVelocities;
+
+    void SetUp(const ::benchmark::State&) {
+        // A tank with a sphere obstacle, filled with points
+        auto box = Box3::builder()
+            .withLowerCorner({0, 0, 0})
+            .withUpperCorner({1, 1, 1})
+            .withIsNormalFlipped(true)
+            .makeShared();
+        auto sphere = Sphere3::builder()
+            .withCenter({0.5, 0.3, 0.5})
+            .withRadius(0.2)
+            .makeShared();
+        auto surface = SurfaceSet3::builder()
+            .withSurfaces({box, sphere})
+            .makeShared();
+        collider = jet::RigidBodyCollider3::builder()
+            .withSurface(surface)
+            .makeShared();
+
+        std::mt19937 rng(0);
+        std::uniform_real_distribution<> d(0.0, 1.0);
+
+        const size_t n = 1 << 20;
+        positions.resize(n);
+        velocities.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            positions[i] = Vector3D(d(rng), d(rng), d(rng));
+            velocities[i] = Vector3D(0.0, -1.0, 0.0);
+        }
+    }
+};
+
+BENCHMARK_DEFINE_F(RigidBodyCollider3, ResolveCollision)
+(benchmark::State& state) {
+    collider->setIsUsingBroadPhase(state.range(0) != 0);
+
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        newPositions = positions;
+        newVelocities = velocities;
+        state.ResumeTiming();
+
+        collider->resolveCollision(0.01, 0.0, newPositions.accessor(),
+                                   newVelocities.accessor());
+    }
+}
+
+BENCHMARK_REGISTER_F(RigidBodyCollider3, ResolveCollision)
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMillisecond);
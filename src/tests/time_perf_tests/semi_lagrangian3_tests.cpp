@@ -0,0 +1,77 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/cell_centered_scalar_grid3.h>
+#include <jet/face_centered_grid3.h>
+#include <jet/semi_lagrangian3.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <vector>
+
+using jet::Vector3D;
+
+class SemiLagrangian3 : public ::benchmark::Fixture {
+ protected:
+    jet::FaceCenteredGrid3 flow;
+    std::vector<jet::CellCenteredScalarGrid3> inputs;
+    std::vector<jet::CellCenteredScalarGrid3> outputs;
+
+    void SetUp(const ::benchmark::State& state) {
+        size_t n = static_cast<size_t>(state.range(0));
+        size_t numberOfFields = static_cast<size_t>(state.range(1));
+        double h = 1.0 / n;
+
+        flow.resize(n, n, n, h, h, h);
+        flow.fill([&](const Vector3D& x) {
+            return Vector3D(x.y - 0.5, 0.5 - x.x, 0.1);
+        });
+
+        inputs.clear();
+        for (size_t m = 0; m < numberOfFields; ++m) {
+            jet::CellCenteredScalarGrid3 grid(n, n, n, h, h, h);
+            grid.fill([&](const Vector3D& x) {
+                return std::sin((m + 1) * x.x) * x.y + x.z;
+            });
+            inputs.push_back(grid);
+        }
+        outputs = inputs;
+    }
+};
+
+BENCHMARK_DEFINE_F(SemiLagrangian3, AdvectEach)(benchmark::State& state) {
+    jet::SemiLagrangian3 solver;
+    while (state.KeepRunning()) {
+        for (size_t m = 0; m < inputs.size(); ++m) {
+            solver.advect(inputs[m], flow, 0.01, &outputs[m]);
+        }
+    }
+}
+
+BENCHMARK_REGISTER_F(SemiLagrangian3, AdvectEach)
+    ->Args({64, 1})
+    ->Args({64, 2})
+    ->Args({64, 4});
+
+BENCHMARK_DEFINE_F(SemiLagrangian3, AdvectScalars)(benchmark::State& state) {
+    jet::SemiLagrangian3 solver;
+    std::vector<const jet::ScalarGrid3*> inputPtrs;
+    std::vector<jet::ScalarGrid3*> outputPtrs;
+    for (size_t m = 0; m < inputs.size(); ++m) {
+        inputPtrs.push_back(&inputs[m]);
+        outputPtrs.push_back(&outputs[m]);
+    }
+
+    while (state.KeepRunning()) {
+        solver.advectScalars(inputPtrs, flow, 0.01, outputPtrs);
+    }
+}
+
+BENCHMARK_REGISTER_F(SemiLagrangian3, AdvectScalars)
+    ->Args({64, 1})
+    ->Args({64, 2})
+    ->Args({64, 4});
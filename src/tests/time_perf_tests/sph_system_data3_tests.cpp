@@ -0,0 +1,63 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/sph_system_data3.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <random>
+
+using jet::Vector3D;
+
+class SphSystemData3 : public ::benchmark::Fixture {
+ protected:
+    jet::SphSystemData3 particles;
+
+    void SetUp(const ::benchmark::State& state) {
+        std::mt19937 rng{0};
+        std::uniform_real_distribution<> dist{0.0, 1.0};
+
+        int N = state.range(0);
+        jet::Array1<Vector3D> points(N);
+        for (int i = 0; i < N; ++i) {
+            points[i] = Vector3D(dist(rng), dist(rng), dist(rng));
+        }
+
+        particles.resize(0);
+        particles.addParticles(points);
+        particles.sortParticles();
+        particles.setTargetSpacing(std::cbrt(1.0 / N));
+    }
+};
+
+BENCHMARK_DEFINE_F(SphSystemData3, UpdateDensitiesWithLists)
+(benchmark::State& state) {
+    particles.setSkinRadius(0.1 * particles.kernelRadius());
+    particles.buildNeighborSearcher();
+    particles.buildNeighborLists();
+    while (state.KeepRunning()) {
+        particles.updateDensities();
+    }
+}
+
+BENCHMARK_REGISTER_F(SphSystemData3, UpdateDensitiesWithLists)
+    ->Arg(1 << 16)
+    ->Arg(1 << 20);
+
+BENCHMARK_DEFINE_F(SphSystemData3, UpdateDensitiesWithoutLists)
+(benchmark::State& state) {
+    particles.setUseNeighborLists(false);
+    particles.buildNeighborSearcher();
+    particles.buildNeighborLists();
+    while (state.KeepRunning()) {
+        particles.updateDensities();
+    }
+}
+
+BENCHMARK_REGISTER_F(SphSystemData3, UpdateDensitiesWithoutLists)
+    ->Arg(1 << 16)
+    ->Arg(1 << 20);
@@ -6,6 +6,7 @@
 
 #include <jet/box3.h>
 #include <jet/implicit_surface_set3.h>
+#include <jet/parallel.h>
 #include <jet/timer.h>
 #include <jet/volume_particle_emitter3.h>
 
@@ -63,3 +64,75 @@ BENCHMARK_DEFINE_F(VolumeParticleEmitter3, Update)(benchmark::State& state) {
 }
 
 BENCHMARK_REGISTER_F(VolumeParticleEmitter3, Update);
+
+static void runEmission(benchmark::State& state, bool allowOverlapping) {
+    const unsigned int numberOfThreads
+        = static_cast<unsigned int>(state.range(0));
+    const unsigned int defaultNumberOfThreads = jet::maxNumberOfThreads();
+    jet::setMaxNumberOfThreads(numberOfThreads);
+
+    double lx = 10.0;
+    double ly = 10.0;
+    double lz = 10.0;
+    double pd = 0.001;
+
+    auto box1 = Box3::builder()
+                    .withLowerCorner({0, 0, 0})
+                    .withUpperCorner(
+                        {0.5 * lx + pd, 0.75 * ly + pd, 0.75 * lz + pd})
+                    .makeShared();
+
+    auto box2 =
+        Box3::builder()
+            .withLowerCorner({2.5 * lx - pd, 0, 0.25 * lz - pd})
+            .withUpperCorner({3.5 * lx + pd, 0.75 * ly + pd, 1.5 * lz + pd})
+            .makeShared();
+
+    auto boxSet = ImplicitSurfaceSet3::builder()
+                      .withExplicitSurfaces({box1, box2})
+                      .makeShared();
+
+    size_t numberOfParticles = 0;
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        auto emitter =
+            jet::VolumeParticleEmitter3::builder()
+                .withSurface(boxSet)
+                .withMaxRegion(BoundingBox3D({0, 0, 0}, {lx, ly, lz}))
+                .withSpacing(0.1)
+                .withJitter(0.1)
+                .withIsOneShot(false)
+                .withAllowOverlapping(allowOverlapping)
+                .makeShared();
+
+        auto particles = std::make_shared<ParticleSystemData3>();
+        emitter->setTarget(particles);
+        state.ResumeTiming();
+
+        emitter->update(0.0, 0.01);
+        numberOfParticles = particles->numberOfParticles();
+    }
+
+    jet::setMaxNumberOfThreads(defaultNumberOfThreads);
+
+    state.counters["particles"] = static_cast<double>(numberOfParticles);
+}
+
+static void BM_VolumeParticleEmitter3Emit(benchmark::State& state) {
+    runEmission(state, true);
+}
+
+BENCHMARK(BM_VolumeParticleEmitter3Emit)
+    ->Arg(1)
+    ->Arg(4)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_VolumeParticleEmitter3EmitWithoutOverlapping(
+    benchmark::State& state) {
+    runEmission(state, false);
+}
+
+BENCHMARK(BM_VolumeParticleEmitter3EmitWithoutOverlapping)
+    ->Arg(1)
+    ->Arg(4)
+    ->Unit(benchmark::kMillisecond);
@@ -16,3 +16,85 @@ TEST(ApicSolver3, UpdateEmpty) {
         solver.update(frame);
     }
 }
+
+TEST(ApicSolver3, UpdateWithParticleSorting) {
+    ApicSolver3 solver({8, 8, 8}, {0.125, 0.125, 0.125}, {0, 0, 0});
+    EXPECT_EQ(0u, solver.particleSortingInterval());
+
+    solver.setParticleSortingInterval(1);
+    EXPECT_EQ(1u, solver.particleSortingInterval());
+
+    auto particles = solver.particleSystemData();
+    for (size_t i = 0; i < 4; ++i) {
+        for (size_t j = 0; j < 4; ++j) {
+            for (size_t k = 0; k < 4; ++k) {
+                particles->addParticle(
+                    {0.2 + 0.1 * k, 0.2 + 0.1 * j, 0.2 + 0.1 * i});
+            }
+        }
+    }
+
+    for (Frame frame; frame.index < 2; ++frame) {
+        solver.update(frame);
+    }
+
+    EXPECT_EQ(64u, particles->numberOfParticles());
+}
+
+TEST(ApicSolver3, UpdateWithParticleRemoval) {
+    ApicSolver3 solver({8, 8, 8}, {0.125, 0.125, 0.125}, {0, 0, 0});
+    EXPECT_FALSE(solver.removesParticlesOutsideDomain());
+
+    solver.setRemovesParticlesOutsideDomain(true);
+    EXPECT_TRUE(solver.removesParticlesOutsideDomain());
+
+    // Interleave the particles inside and outside of the grid domain
+    auto particles = solver.particleSystemData();
+    for (size_t i = 0; i < 4; ++i) {
+        for (size_t j = 0; j < 4; ++j) {
+            for (size_t k = 0; k < 4; ++k) {
+                particles->addParticle(
+                    {0.2 + 0.1 * k, 0.2 + 0.1 * j, 0.2 + 0.1 * i});
+                particles->addParticle(
+                    {2.2 + 0.1 * k, 0.2 + 0.1 * j, 0.2 + 0.1 * i});
+            }
+        }
+    }
+
+    for (Frame frame; frame.index < 2; ++frame) {
+        solver.update(frame);
+    }
+
+    EXPECT_EQ(64u, particles->numberOfParticles());
+    auto x = particles->positions();
+    for (size_t i = 0; i < x.size(); ++i) {
+        EXPECT_GT(1.0, x[i].x);
+    }
+}
+
+TEST(ApicSolver3, UpdateWithNarrowBand) {
+    ApicSolver3 solver({8, 16, 8}, {0.125, 0.125, 0.125}, {0, 0, 0});
+    solver.setIsUsingNarrowBand(true);
+    EXPECT_TRUE(solver.isUsingNarrowBand());
+
+    auto particles = solver.particleSystemData();
+    for (size_t k = 0; k < 16; ++k) {
+        for (size_t j = 0; j < 24; ++j) {
+            for (size_t i = 0; i < 16; ++i) {
+                particles->addParticle(
+                    {0.03125 + 0.0625 * i, 0.03125 + 0.0625 * j,
+                     0.03125 + 0.0625 * k});
+            }
+        }
+    }
+
+    for (Frame frame; frame.index < 4; ++frame) {
+        solver.update(frame);
+    }
+
+    // The particles below the band are removed
+    EXPECT_LT(0u, particles->numberOfParticles());
+    EXPECT_GT(6144u, particles->numberOfParticles());
+    auto sdf = solver.signedDistanceField();
+    EXPECT_GT(0.0, (*sdf)(4, 2, 4));
+}
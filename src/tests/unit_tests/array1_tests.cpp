@@ -89,6 +89,24 @@ TEST(Array1, ResizeMethod) {
     }
 }
 
+TEST(Array1, ReserveMethod) {
+    Array1<float> arr = { 2.f, 5.f };
+    arr.reserve(16);
+    EXPECT_EQ(2u, arr.size());
+    EXPECT_LE(16u, arr.capacity());
+    EXPECT_FLOAT_EQ(2.f, arr[0]);
+    EXPECT_FLOAT_EQ(5.f, arr[1]);
+
+    // Growing within the capacity keeps the storage
+    const float* data = arr.data();
+    arr.resize(10, 3.f);
+    arr.append(7.f);
+    EXPECT_EQ(data, arr.data());
+    EXPECT_EQ(11u, arr.size());
+    EXPECT_FLOAT_EQ(3.f, arr[9]);
+    EXPECT_FLOAT_EQ(7.f, arr[10]);
+}
+
 TEST(Array1, Iterators) {
     Array1<float> arr1 = {6.f,  4.f,  1.f,  -5.f};
 
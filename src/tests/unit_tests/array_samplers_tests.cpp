@@ -12,6 +12,8 @@
 #include <jet/array_samplers3.h>
 #include <gtest/gtest.h>
 
+#include <cmath>
+
 using namespace jet;
 
 TEST(NearestArraySampler1, Sample) {
@@ -196,3 +198,59 @@ TEST(CubicArraySampler3, Sample) {
     EXPECT_LT(3.0, s0);
     EXPECT_GT(6.0, s0);
 }
+
+TEST(LinearArraySampler3, SampleBatch) {
+    Array3<double> grid(5, 4, 3);
+    Array3<Vector3D> vectorGrid(5, 4, 3);
+    grid.forEachIndex([&](size_t i, size_t j, size_t k) {
+        grid(i, j, k) = std::sin(static_cast<double>(i + 2 * j + 3 * k));
+        vectorGrid(i, j, k) = Vector3D(1.0 * i, -2.0 * j, 0.5 * k * k);
+    });
+
+    Vector3D gridSpacing(0.5, 0.25, 1.0), gridOrigin(0.1, -0.2, 0.0);
+    LinearArraySampler3<double, double> sampler(
+        grid.constAccessor(), gridSpacing, gridOrigin);
+    LinearArraySampler3<Vector3D, double> vectorSampler(
+        vectorGrid.constAccessor(), gridSpacing, gridOrigin);
+
+    // Include points outside of the grid and a tail shorter than a block
+    Array1<Vector3D> pts;
+    for (size_t i = 0; i < 37; ++i) {
+        double t = static_cast<double>(i) / 36.0;
+        pts.append(Vector3D(-0.5 + 3.5 * t, -0.5 + 1.8 * t * t, 3.0 - 4.0 * t));
+    }
+
+    Array1<double> values(pts.size());
+    Array1<Vector3D> vectorValues(pts.size());
+    sampler.sample(pts.constAccessor(), values.accessor());
+    vectorSampler.sample(pts.constAccessor(), vectorValues.accessor());
+
+    for (size_t i = 0; i < pts.size(); ++i) {
+        EXPECT_EQ(sampler(pts[i]), values[i]);
+        EXPECT_EQ(vectorSampler(pts[i]), vectorValues[i]);
+    }
+}
+
+TEST(CubicArraySampler3, SampleBatch) {
+    Array3<double> grid(5, 4, 6);
+    grid.forEachIndex([&](size_t i, size_t j, size_t k) {
+        grid(i, j, k) = std::cos(static_cast<double>(i * j + k));
+    });
+
+    Vector3D gridSpacing(0.5, 0.25, 1.0), gridOrigin(0.1, -0.2, 0.0);
+    CubicArraySampler3<double, double> sampler(
+        grid.constAccessor(), gridSpacing, gridOrigin);
+
+    Array1<Vector3D> pts;
+    for (size_t i = 0; i < 37; ++i) {
+        double t = static_cast<double>(i) / 36.0;
+        pts.append(Vector3D(-0.5 + 3.5 * t, -0.5 + 1.8 * t * t, 7.0 - 8.0 * t));
+    }
+
+    Array1<double> values(pts.size());
+    sampler.sample(pts.constAccessor(), values.accessor());
+
+    for (size_t i = 0; i < pts.size(); ++i) {
+        EXPECT_EQ(sampler(pts[i]), values[i]);
+    }
+}
@@ -0,0 +1,160 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/array2.h>
+#include <jet/array3.h>
+#include <jet/array_scatter.h>
+#include <jet/parallel.h>
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+using namespace jet;
+
+TEST(ArrayScatter, WeightedAverage2) {
+    const Size2 size(9, 7);
+    const Vector2D gridSpacing(0.1, 0.2);
+    const Vector2D origin(-0.05, 0.1);
+
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> d(-0.2, 1.2);
+    std::vector<Vector2D> positions(500);
+    std::vector<double> values(positions.size());
+    for (size_t i = 0; i < positions.size(); ++i) {
+        positions[i] = Vector2D(d(rng), d(rng));
+        values[i] = d(rng);
+    }
+
+    Array2<double> output(size);
+    Array2<char> markers(size);
+    LinearArraySampler2<double, double> sampler(
+        output.constAccessor(), gridSpacing, origin);
+
+    scatterWeightedAverage(
+        positions.size(), sampler,
+        [&](size_t i) { return positions[i]; },
+        [&](size_t i, const Point2UI&) { return values[i]; },
+        output.accessor(), markers.accessor());
+
+    // Serial scatter for the reference
+    Array2<double> sum(size);
+    Array2<double> weightSum(size);
+    Array2<char> touched(size);
+    for (size_t i = 0; i < positions.size(); ++i) {
+        std::array<Point2UI, 4> indices;
+        std::array<double, 4> weights;
+        sampler.getCoordinatesAndWeights(positions[i], &indices, &weights);
+        for (size_t n = 0; n < 4; ++n) {
+            sum(indices[n]) += weights[n] * values[i];
+            weightSum(indices[n]) += weights[n];
+            touched(indices[n]) = 1;
+        }
+    }
+
+    output.forEachIndex([&](size_t i, size_t j) {
+        double expected
+            = (weightSum(i, j) > 0.0) ? sum(i, j) / weightSum(i, j) : 0.0;
+        EXPECT_NEAR(expected, output(i, j), 1e-12);
+        EXPECT_EQ(touched(i, j), markers(i, j));
+    });
+}
+
+TEST(ArrayScatter, WeightedAverage3) {
+    const Size3 size(9, 7, 5);
+    const Vector3D gridSpacing(0.1, 0.2, 0.25);
+    const Vector3D origin(-0.05, 0.1, 0.0);
+
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> d(-0.2, 1.2);
+    std::vector<Vector3D> positions(1000);
+    std::vector<double> values(positions.size());
+    for (size_t i = 0; i < positions.size(); ++i) {
+        positions[i] = Vector3D(d(rng), d(rng), d(rng));
+        values[i] = d(rng);
+    }
+
+    Array3<double> output(size);
+    Array3<char> markers(size);
+    LinearArraySampler3<double, double> sampler(
+        output.constAccessor(), gridSpacing, origin);
+
+    // The value may depend on the node as in the APIC transfer
+    auto valueFunc = [&](size_t i, const Point3UI& idx) {
+        return values[i] + 0.1 * idx.x - 0.2 * idx.z;
+    };
+
+    scatterWeightedAverage(
+        positions.size(), sampler,
+        [&](size_t i) { return positions[i]; },
+        valueFunc, output.accessor(), markers.accessor());
+
+    // Serial scatter for the reference
+    Array3<double> sum(size);
+    Array3<double> weightSum(size);
+    Array3<char> touched(size);
+    for (size_t i = 0; i < positions.size(); ++i) {
+        std::array<Point3UI, 8> indices;
+        std::array<double, 8> weights;
+        sampler.getCoordinatesAndWeights(positions[i], &indices, &weights);
+        for (size_t n = 0; n < 8; ++n) {
+            sum(indices[n]) += weights[n] * valueFunc(i, indices[n]);
+            weightSum(indices[n]) += weights[n];
+            touched(indices[n]) = 1;
+        }
+    }
+
+    output.forEachIndex([&](size_t i, size_t j, size_t k) {
+        double expected = (weightSum(i, j, k) > 0.0)
+                              ? sum(i, j, k) / weightSum(i, j, k)
+                              : 0.0;
+        EXPECT_NEAR(expected, output(i, j, k), 1e-12);
+        EXPECT_EQ(touched(i, j, k), markers(i, j, k));
+    });
+}
+
+TEST(ArrayScatter, Deterministic) {
+    const Size3 size(16, 16, 16);
+    const Vector3D gridSpacing(1.0 / 16.0, 1.0 / 16.0, 1.0 / 16.0);
+
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> d(0.0, 1.0);
+    std::vector<Vector3D> positions(20000);
+    std::vector<double> values(positions.size());
+    for (size_t i = 0; i < positions.size(); ++i) {
+        positions[i] = Vector3D(d(rng), d(rng), d(rng));
+        values[i] = 1e3 * d(rng);
+    }
+
+    const unsigned int oldNumThreads = maxNumberOfThreads();
+
+    Array3<double> reference;
+    for (unsigned int numThreads : {1u, 3u, 8u}) {
+        setMaxNumberOfThreads(numThreads);
+
+        Array3<double> output(size);
+        Array3<char> markers(size);
+        LinearArraySampler3<double, double> sampler(
+            output.constAccessor(), gridSpacing, Vector3D());
+
+        scatterWeightedAverage(
+            positions.size(), sampler,
+            [&](size_t i) { return positions[i]; },
+            [&](size_t i, const Point3UI&) { return values[i]; },
+            output.accessor(), markers.accessor());
+
+        if (reference.size() == Size3()) {
+            reference.set(output);
+        } else {
+            output.forEachIndex([&](size_t i, size_t j, size_t k) {
+                EXPECT_EQ(reference(i, j, k), output(i, j, k));
+            });
+        }
+    }
+
+    setMaxNumberOfThreads(oldNumThreads);
+}
@@ -54,6 +54,47 @@ TEST(Cg, Solve) {
     }
 }
 
+TEST(CgFused, Solve) {
+    // Solve:
+    // | 4 1 | |x|   |1|
+    // | 1 3 | |y| = |2|
+
+    const Matrix2x2D matrix(4.0, 1.0, 1.0, 3.0);
+    const Vector2D rhs(1.0, 2.0);
+
+    typedef Blas<double, Vector2D, Matrix2x2D> BlasType;
+
+    {
+        // Zero iteration should give proper residual from iteration data.
+        Vector2D x, r, d, q, s;
+        unsigned int lastNumIter;
+        double lastResidualNorm;
+
+        cgFused<BlasType>(matrix, rhs, 0, 0.0, &x, &r, &d, &q, &s,
+                          &lastNumIter, &lastResidualNorm);
+
+        EXPECT_DOUBLE_EQ(0.0, x.x);
+        EXPECT_DOUBLE_EQ(0.0, x.y);
+
+        EXPECT_DOUBLE_EQ(std::sqrt(5.0), lastResidualNorm);
+        EXPECT_EQ(0u, lastNumIter);
+    }
+    {
+        Vector2D x, r, d, q, s;
+        unsigned int lastNumIter;
+        double lastResidualNorm;
+
+        cgFused<BlasType>(matrix, rhs, 10, 1e-12, &x, &r, &d, &q, &s,
+                          &lastNumIter, &lastResidualNorm);
+
+        EXPECT_NEAR(1.0 / 11.0, x.x, 1e-12);
+        EXPECT_NEAR(7.0 / 11.0, x.y, 1e-12);
+
+        EXPECT_LE(lastResidualNorm, 1e-12);
+        EXPECT_LE(lastNumIter, 3u);
+    }
+}
+
 TEST(Pcg, Solve) {
     // Solve:
     // | 4 1 | |x|   |1|
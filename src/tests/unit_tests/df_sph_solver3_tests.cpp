@@ -0,0 +1,154 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/box3.h>
+#include <jet/df_sph_solver3.h>
+#include <jet/pci_sph_solver3.h>
+#include <jet/rigid_body_collider3.h>
+#include <jet/volume_particle_emitter3.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+using namespace jet;
+
+namespace {
+
+// Drops a block of fluid into a box and returns the largest compression
+// relative to the target density seen at the end of any frame.
+double maxDensityErrorRatioOfBlockDrop(SphSolver3* solver) {
+    solver->setPseudoViscosityCoefficient(0.0);
+
+    auto particles = solver->sphSystemData();
+    particles->setTargetDensity(1000.0);
+    particles->setTargetSpacing(0.1);
+
+    // Keep the block one radius off the walls so that the first collision
+    // does not snap the boundary layers into each other
+    auto box = Box3::builder()
+        .withLowerCorner({0.15, 0.15, 0.15})
+        .withUpperCorner({0.65, 0.65, 0.65})
+        .makeShared();
+    auto emitter = VolumeParticleEmitter3::builder()
+        .withSurface(box)
+        .withSpacing(0.1)
+        .withIsOneShot(true)
+        .makeShared();
+    solver->setEmitter(emitter);
+
+    auto domain = Box3::builder()
+        .withBoundingBox(BoundingBox3D({0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}))
+        .withIsNormalFlipped(true)
+        .makeShared();
+    solver->setCollider(
+        RigidBodyCollider3::builder().withSurface(domain).makeShared());
+
+    double maxError = 0.0;
+    Frame frame(0, 1.0 / 60.0);
+    for (; frame.index < 30; ++frame) {
+        solver->update(frame);
+
+        particles->buildNeighborSearcher();
+        particles->buildNeighborLists();
+        particles->updateDensities();
+        for (double d : particles->densities()) {
+            maxError = std::max(maxError, d - particles->targetDensity());
+        }
+    }
+    return maxError / particles->targetDensity();
+}
+
+}  // namespace
+
+TEST(DfSphSolver3, UpdateEmpty) {
+    // Empty solver test
+    DfSphSolver3 solver;
+    Frame frame(0, 0.01);
+    solver.update(frame++);
+    solver.update(frame);
+}
+
+TEST(DfSphSolver3, Parameters) {
+    DfSphSolver3 solver;
+
+    solver.setMaxDensityErrorRatio(5.0);
+    EXPECT_DOUBLE_EQ(5.0, solver.maxDensityErrorRatio());
+
+    solver.setMaxDensityErrorRatio(-1.0);
+    EXPECT_DOUBLE_EQ(0.0, solver.maxDensityErrorRatio());
+
+    solver.setMaxDivergenceErrorRatio(5.0);
+    EXPECT_DOUBLE_EQ(5.0, solver.maxDivergenceErrorRatio());
+
+    solver.setMaxDivergenceErrorRatio(-1.0);
+    EXPECT_DOUBLE_EQ(0.0, solver.maxDivergenceErrorRatio());
+
+    solver.setMaxNumberOfIterations(10);
+    EXPECT_EQ(10u, solver.maxNumberOfIterations());
+
+    solver.setMaxCfl(0.3);
+    EXPECT_DOUBLE_EQ(0.3, solver.maxCfl());
+
+    solver.setMaxCfl(-1.0);
+    EXPECT_LT(0.0, solver.maxCfl());
+}
+
+TEST(DfSphSolver3, UpdateBlock) {
+    DfSphSolver3 solver;
+    solver.setPseudoViscosityCoefficient(0.0);
+
+    auto particles = solver.sphSystemData();
+    particles->setTargetDensity(1000.0);
+    particles->setTargetSpacing(0.1);
+
+    auto box = Box3::builder()
+        .withLowerCorner({0.0, 0.0, 0.0})
+        .withUpperCorner({0.5, 0.5, 0.5})
+        .makeShared();
+    auto emitter = VolumeParticleEmitter3::builder()
+        .withSurface(box)
+        .withSpacing(0.1)
+        .withIsOneShot(true)
+        .makeShared();
+    solver.setEmitter(emitter);
+
+    BoundingBox3D domainBox({0.0, 0.0, 0.0}, {1.0, 1.0, 1.0});
+    auto domain = Box3::builder()
+        .withBoundingBox(domainBox)
+        .withIsNormalFlipped(true)
+        .makeShared();
+    solver.setCollider(
+        RigidBodyCollider3::builder().withSurface(domain).makeShared());
+
+    Frame frame(0, 1.0 / 60.0);
+    for (; frame.index < 10; ++frame) {
+        solver.update(frame);
+    }
+
+    // The block falls and spreads without blowing up
+    ASSERT_GT(particles->numberOfParticles(), 0u);
+    auto x = particles->positions();
+    auto d = particles->densities();
+    for (size_t i = 0; i < x.size(); ++i) {
+        EXPECT_TRUE(domainBox.contains(x[i]));
+        EXPECT_LT(d[i], 1.1 * particles->targetDensity());
+    }
+}
+
+TEST(DfSphSolver3, MaxDensityErrorComparedToPciSph) {
+    DfSphSolver3 dfSolver;
+    PciSphSolver3 pciSolver;
+    EXPECT_DOUBLE_EQ(
+        pciSolver.maxDensityErrorRatio(), dfSolver.maxDensityErrorRatio());
+
+    const double dfError = maxDensityErrorRatioOfBlockDrop(&dfSolver);
+    const double pciError = maxDensityErrorRatioOfBlockDrop(&pciSolver);
+
+    // Both solvers bound the worst particle with the same threshold, so the
+    // block should not be compressed much more with DFSPH than with PCISPH
+    EXPECT_LT(0.0, pciError);
+    EXPECT_LT(dfError, 2.0 * pciError);
+}
@@ -268,6 +268,30 @@ TEST(FaceCenteredGrid3, Sample) {
     });
 }
 
+TEST(FaceCenteredGrid3, LinearSampler) {
+    FaceCenteredGrid3 grid(5, 8, 6, 2.0, 3.0, 1.5);
+    grid.fill([&](const Vector3D& x) {
+        return Vector3D(3.0 * x.y + 1.0, 5.0 * x.z + 7.0, -1.0 * x.x - 9.0);
+    });
+
+    auto sampler = grid.sampler();
+    for (const Vector3D& x : {Vector3D(0.5, 1.0, 2.0), Vector3D(7.5, 20.0, 4.0),
+                              Vector3D(-1.0, 30.0, 12.0)}) {
+        Vector3D expected = sampler(x);
+        EXPECT_EQ(expected.x, grid.uLinearSampler()(x));
+        EXPECT_EQ(expected.y, grid.vLinearSampler()(x));
+        EXPECT_EQ(expected.z, grid.wLinearSampler()(x));
+        EXPECT_EQ(expected, grid.sample(x));
+    }
+
+    // Samplers should follow the resized data
+    grid.resize(2, 2, 2);
+    grid.fill(Vector3D(4.0, 5.0, 6.0));
+    EXPECT_EQ(4.0, grid.uLinearSampler()(Vector3D(0.7, 0.2, 1.3)));
+    EXPECT_EQ(5.0, grid.vLinearSampler()(Vector3D(0.7, 0.2, 1.3)));
+    EXPECT_EQ(6.0, grid.wLinearSampler()(Vector3D(0.7, 0.2, 1.3)));
+}
+
 TEST(FaceCenteredGrid3, Builder) {
     {
         auto builder = FaceCenteredGrid3::builder();
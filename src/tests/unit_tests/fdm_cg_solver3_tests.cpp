@@ -32,3 +32,24 @@ TEST(FdmCgSolver3, SolveCompressed) {
 
     EXPECT_GT(solver.tolerance(), solver.lastResidual());
 }
+
+TEST(FdmCgSolver3, SolveMatrixFree) {
+    FdmLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestLinearSystem(&system,
+                                                            {7, 5, 3});
+    FdmMatrixFreeLinearSystem3 mfSystem;
+    FdmLinearSystemSolverTestHelper3::buildTestMatrixFreeLinearSystem(
+        &mfSystem, {7, 5, 3});
+
+    FdmCgSolver3 solver(100, 1e-9);
+    EXPECT_TRUE(solver.solve(&system));
+    const unsigned int numberOfIterations = solver.lastNumberOfIterations();
+
+    EXPECT_TRUE(solver.solveMatrixFree(&mfSystem));
+    EXPECT_GT(solver.tolerance(), solver.lastResidual());
+    EXPECT_EQ(numberOfIterations, solver.lastNumberOfIterations());
+
+    system.x.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(system.x(i, j, k), mfSystem.x(i, j, k), 1e-12);
+    });
+}
@@ -0,0 +1,184 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/fdm_linear_system3.h>
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace jet;
+
+namespace {
+
+// Builds a matrix with random active cells and open faces. The faces on the
+// grid boundary are closed.
+void buildRandomMatrixFree(const Size3& size, FdmMatrixFree3* matrix) {
+    std::mt19937 rng(0);
+    std::uniform_int_distribution<int> d(0, 3);
+
+    matrix->resize(size);
+    matrix->invHSqr = Vector3D(4.0, 9.0, 16.0);
+    matrix->flags.forEachIndex([&](size_t i, size_t j, size_t k) {
+        uint8_t flags = 0;
+        if (d(rng) != 0) {
+            flags |= FdmMatrixFree3::kActive;
+        }
+        if (i > 0 && d(rng) != 0) {
+            flags |= FdmMatrixFree3::kOpenLeft;
+        }
+        if (i + 1 < size.x && d(rng) != 0) {
+            flags |= FdmMatrixFree3::kOpenRight;
+        }
+        if (j > 0 && d(rng) != 0) {
+            flags |= FdmMatrixFree3::kOpenDown;
+        }
+        if (j + 1 < size.y && d(rng) != 0) {
+            flags |= FdmMatrixFree3::kOpenUp;
+        }
+        if (k > 0 && d(rng) != 0) {
+            flags |= FdmMatrixFree3::kOpenBack;
+        }
+        if (k + 1 < size.z && d(rng) != 0) {
+            flags |= FdmMatrixFree3::kOpenFront;
+        }
+        matrix->flags(i, j, k) = flags;
+    });
+}
+
+}  // namespace
+
+TEST(FdmMatrixFree3, Row) {
+    FdmMatrixFree3 matrix;
+    matrix.resize({3, 1, 1});
+    matrix.invHSqr = Vector3D(4.0, 9.0, 16.0);
+    matrix.flags(0, 0, 0) = FdmMatrixFree3::kActive |
+                            FdmMatrixFree3::kOpenRight;
+    matrix.flags(1, 0, 0) = FdmMatrixFree3::kActive |
+                            FdmMatrixFree3::kOpenLeft |
+                            FdmMatrixFree3::kOpenRight;
+    matrix.flags(2, 0, 0) = FdmMatrixFree3::kOpenLeft;
+
+    // The open face toward the inactive cell only adds to the diagonal
+    FdmMatrixRow3 row = matrix.row(0, 0, 0);
+    EXPECT_DOUBLE_EQ(4.0, row.center);
+    EXPECT_DOUBLE_EQ(-4.0, row.right);
+    EXPECT_DOUBLE_EQ(0.0, row.up);
+    EXPECT_DOUBLE_EQ(0.0, row.front);
+
+    row = matrix.row(1, 0, 0);
+    EXPECT_DOUBLE_EQ(8.0, row.center);
+    EXPECT_DOUBLE_EQ(0.0, row.right);
+
+    row = matrix.row(2, 0, 0);
+    EXPECT_DOUBLE_EQ(1.0, row.center);
+    EXPECT_DOUBLE_EQ(0.0, row.right);
+}
+
+TEST(FdmMatrixFree3, MvmAndResidual) {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<> d(-1.0, 1.0);
+
+    const Size3 sizes[] = {{1, 1, 1}, {1, 4, 3}, {2, 3, 5}, {17, 6, 5}};
+    for (const Size3& size : sizes) {
+        FdmMatrixFree3 matrixFree;
+        buildRandomMatrixFree(size, &matrixFree);
+
+        FdmMatrix3 matrix;
+        matrixFree.toMatrix(&matrix);
+
+        FdmVector3 x(size);
+        FdmVector3 b(size);
+        x.forEachIndex([&](size_t i, size_t j, size_t k) {
+            x(i, j, k) = d(rng);
+            b(i, j, k) = d(rng);
+        });
+
+        FdmVector3 expected(size);
+        FdmVector3 actual(size);
+        FdmBlas3::mvm(matrix, x, &expected);
+        FdmBlas3::mvm(matrixFree, x, &actual);
+        expected.forEachIndex([&](size_t i, size_t j, size_t k) {
+            EXPECT_NEAR(expected(i, j, k), actual(i, j, k), 1e-12);
+        });
+
+        FdmBlas3::residual(matrix, x, b, &expected);
+        FdmMatrixFreeBlas3::residual(matrixFree, x, b, &actual);
+        expected.forEachIndex([&](size_t i, size_t j, size_t k) {
+            EXPECT_NEAR(expected(i, j, k), actual(i, j, k), 1e-12);
+        });
+    }
+}
+
+TEST(FdmBlas3, MvmDot) {
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<> d(-1.0, 1.0);
+
+    const Size3 size(9, 7, 5);
+    FdmMatrixFree3 matrixFree;
+    buildRandomMatrixFree(size, &matrixFree);
+
+    FdmMatrix3 matrix;
+    matrixFree.toMatrix(&matrix);
+
+    FdmVector3 v(size);
+    v.forEachIndex([&](size_t i, size_t j, size_t k) { v(i, j, k) = d(rng); });
+
+    FdmVector3 expected(size);
+    FdmBlas3::mvm(matrix, v, &expected);
+    const double expectedVDotV = FdmBlas3::dot(v, v);
+    const double expectedVDotResult = FdmBlas3::dot(v, expected);
+
+    FdmVector3 actual(size);
+    double vDotV = 0.0;
+    double vDotResult = 0.0;
+    FdmBlas3::mvmDot(matrix, v, &actual, &vDotV, &vDotResult);
+    EXPECT_NEAR(expectedVDotV, vDotV, 1e-9);
+    EXPECT_NEAR(expectedVDotResult, vDotResult, 1e-9);
+    expected.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(expected(i, j, k), actual(i, j, k), 1e-12);
+    });
+
+    FdmMatrixFreeBlas3::mvmDot(matrixFree, v, &actual, &vDotV, &vDotResult);
+    EXPECT_NEAR(expectedVDotV, vDotV, 1e-9);
+    EXPECT_NEAR(expectedVDotResult, vDotResult, 1e-9);
+    expected.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(expected(i, j, k), actual(i, j, k), 1e-12);
+    });
+}
+
+TEST(FdmBlas3, CgUpdate) {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<> d(-1.0, 1.0);
+
+    const Size3 size(5, 4, 3);
+    FdmVector3 w(size), r(size), p(size), s(size), x(size);
+    w.forEachIndex([&](size_t i, size_t j, size_t k) {
+        w(i, j, k) = d(rng);
+        r(i, j, k) = d(rng);
+        p(i, j, k) = d(rng);
+        s(i, j, k) = d(rng);
+        x(i, j, k) = d(rng);
+    });
+
+    const double alpha = 0.3;
+    const double beta = 0.7;
+
+    // Same update with the separate passes
+    FdmVector3 r2(r), p2(p), s2(s), x2(x);
+    FdmBlas3::axpy(beta, p2, r2, &p2);
+    FdmBlas3::axpy(beta, s2, w, &s2);
+    FdmBlas3::axpy(alpha, p2, x2, &x2);
+    FdmBlas3::axpy(-alpha, s2, r2, &r2);
+
+    FdmBlas3::cgUpdate(alpha, beta, w, &r, &p, &s, &x);
+    x.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(p2(i, j, k), p(i, j, k));
+        EXPECT_DOUBLE_EQ(s2(i, j, k), s(i, j, k));
+        EXPECT_DOUBLE_EQ(x2(i, j, k), x(i, j, k));
+        EXPECT_DOUBLE_EQ(r2(i, j, k), r(i, j, k));
+    });
+}
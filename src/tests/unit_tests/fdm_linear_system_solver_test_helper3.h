@@ -48,6 +48,46 @@ class FdmLinearSystemSolverTestHelper3 {
         });
     }
 
+    static void buildTestMatrixFreeLinearSystem(
+        FdmMatrixFreeLinearSystem3* system, const Size3& size) {
+        system->resize(size);
+        system->A.invHSqr = Vector3D(1.0, 1.0, 1.0);
+        system->x.set(0.0);
+        system->b.set(0.0);
+
+        system->A.flags.forEachIndex([&](size_t i, size_t j, size_t k) {
+            uint8_t flags = FdmMatrixFree3::kActive;
+
+            if (i > 0) {
+                flags |= FdmMatrixFree3::kOpenLeft;
+            }
+            if (i < size.x - 1) {
+                flags |= FdmMatrixFree3::kOpenRight;
+            }
+
+            if (j > 0) {
+                flags |= FdmMatrixFree3::kOpenDown;
+            } else {
+                system->b(i, j, k) += 1.0;
+            }
+
+            if (j < size.y - 1) {
+                flags |= FdmMatrixFree3::kOpenUp;
+            } else {
+                system->b(i, j, k) -= 1.0;
+            }
+
+            if (k > 0) {
+                flags |= FdmMatrixFree3::kOpenBack;
+            }
+            if (k < size.z - 1) {
+                flags |= FdmMatrixFree3::kOpenFront;
+            }
+
+            system->A.flags(i, j, k) = flags;
+        });
+    }
+
     static void buildTestCompressedLinearSystem(
         FdmCompressedLinearSystem3* system, const Size3& size) {
         Array3<size_t> coordToIndex(size);
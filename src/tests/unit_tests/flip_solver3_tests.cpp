@@ -29,3 +29,59 @@ TEST(FlipSolver3, PicBlendingFactor) {
     solver.setPicBlendingFactor(-0.9);
     EXPECT_EQ(0.0, solver.picBlendingFactor());
 }
+
+TEST(FlipSolver3, UpdateWithNarrowBand) {
+    size_t numberOfParticles[2];
+    size_t numberOfLiquidCells[2];
+
+    for (int useNarrowBand = 0; useNarrowBand < 2; ++useNarrowBand) {
+        FlipSolver3 solver({10, 20, 10}, {0.1, 0.1, 0.1}, {0, 0, 0});
+        EXPECT_FALSE(solver.isUsingNarrowBand());
+        solver.setIsUsingNarrowBand(useNarrowBand != 0);
+        solver.setNarrowBandWidth(2.0);
+
+        // Deep tank with two particles per cell along each axis
+        auto particles = solver.particleSystemData();
+        for (size_t k = 0; k < 20; ++k) {
+            for (size_t j = 0; j < 30; ++j) {
+                for (size_t i = 0; i < 20; ++i) {
+                    particles->addParticle(
+                        {0.025 + 0.05 * i, 0.025 + 0.05 * j, 0.025 + 0.05 * k});
+                }
+            }
+        }
+
+        for (Frame frame; frame.index < 5; ++frame) {
+            solver.update(frame);
+        }
+
+        auto sdf = solver.signedDistanceField();
+        size_t liquidCells = 0;
+        sdf->forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+            if ((*sdf)(i, j, k) < 0.0) {
+                ++liquidCells;
+            }
+        });
+
+        numberOfParticles[useNarrowBand] = particles->numberOfParticles();
+        numberOfLiquidCells[useNarrowBand] = liquidCells;
+    }
+
+    // Only the particles near the surface are kept while the liquid volume
+    // stays the same
+    EXPECT_EQ(12000u, numberOfParticles[0]);
+    EXPECT_GT(numberOfParticles[0] / 2, numberOfParticles[1]);
+    EXPECT_NEAR(static_cast<double>(numberOfLiquidCells[0]),
+                static_cast<double>(numberOfLiquidCells[1]),
+                0.02 * numberOfLiquidCells[0]);
+}
+
+TEST(FlipSolver3, NarrowBandWidth) {
+    FlipSolver3 solver;
+
+    solver.setNarrowBandWidth(5.0);
+    EXPECT_EQ(5.0, solver.narrowBandWidth());
+
+    solver.setNarrowBandWidth(0.2);
+    EXPECT_EQ(1.0, solver.narrowBandWidth());
+}
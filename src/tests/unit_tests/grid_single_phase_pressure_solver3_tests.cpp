@@ -312,3 +312,50 @@ TEST(GridSinglePhasePressureSolver3, SolveFreeSurfaceWithBoundary) {
         }
     }
 }
+
+TEST(GridSinglePhasePressureSolver3, SolveFreeSurfaceMatrixFree) {
+    FaceCenteredGrid3 vel(12, 10, 8, 0.1, 0.1, 0.1);
+    CellCenteredScalarGrid3 fluidSdf(12, 10, 8, 0.1, 0.1, 0.1);
+    CellCenteredScalarGrid3 boundarySdf(12, 10, 8, 0.1, 0.1, 0.1);
+
+    vel.fill([](const Vector3D& x) {
+        return Vector3D(std::sin(7.0 * x.y), std::cos(5.0 * x.z) - 1.0,
+                        std::sin(3.0 * x.x));
+    });
+
+    // A ball obstacle under a tilted free surface
+    boundarySdf.fill([](const Vector3D& x) {
+        return x.distanceTo(Vector3D(0.6, 0.3, 0.4)) - 0.25;
+    });
+    fluidSdf.fill([](const Vector3D& x) { return x.y + 0.3 * x.x - 0.7; });
+
+    FaceCenteredGrid3 expected(vel);
+    GridSinglePhasePressureSolver3 solver;
+    solver.solve(vel, 1.0, &expected, boundarySdf,
+                 ConstantVectorField3({0, 0, 0}), fluidSdf);
+
+    FaceCenteredGrid3 actual(vel);
+    GridSinglePhasePressureSolver3 mfSolver;
+    EXPECT_FALSE(mfSolver.isUsingMatrixFreeSystem());
+    mfSolver.setIsUsingMatrixFreeSystem(true);
+    EXPECT_TRUE(mfSolver.isUsingMatrixFreeSystem());
+    mfSolver.solve(vel, 1.0, &actual, boundarySdf,
+                   ConstantVectorField3({0, 0, 0}), fluidSdf);
+
+    const auto& p = solver.pressure();
+    const auto& mfP = mfSolver.pressure();
+    ASSERT_EQ(p.size(), mfP.size());
+    p.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(p(i, j, k), mfP(i, j, k), 1e-9);
+    });
+
+    expected.forEachUIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(expected.u(i, j, k), actual.u(i, j, k), 1e-9);
+    });
+    expected.forEachVIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(expected.v(i, j, k), actual.v(i, j, k), 1e-9);
+    });
+    expected.forEachWIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(expected.w(i, j, k), actual.w(i, j, k), 1e-9);
+    });
+}
@@ -192,3 +192,69 @@ TEST(GridSystemData3, Serialize) {
         EXPECT_EQ(velocity->w(i, j, k), velocity2->w(i, j, k));
     });
 }
+
+TEST(GridSystemData3, BackBuffers) {
+    GridSystemData3 grids({8, 4, 6}, {1.0, 1.0, 1.0}, {0.0, 0.0, 0.0});
+
+    size_t scalarIdx = grids.addAdvectableScalarData(
+        std::make_shared<CellCenteredScalarGrid3::Builder>(), 3.0);
+    size_t vectorIdx = grids.addAdvectableVectorData(
+        std::make_shared<CellCenteredVectorGrid3::Builder>(),
+        Vector3D(1.0, 2.0, 3.0));
+
+    auto scalar = grids.advectableScalarDataAt(scalarIdx);
+    auto scalar0 = grids.advectableScalarDataBackBufferAt(scalarIdx);
+    auto vector = grids.advectableVectorDataAt(vectorIdx);
+    auto vector0 = grids.advectableVectorDataBackBufferAt(vectorIdx);
+    auto velocity = grids.velocity();
+    auto velocity0 = grids.velocityBackBuffer();
+
+    EXPECT_NE(scalar, scalar0);
+    EXPECT_NE(vector, vector0);
+    EXPECT_NE(velocity, velocity0);
+    EXPECT_TRUE(scalar->hasSameShape(*scalar0));
+    EXPECT_TRUE(vector->hasSameShape(*vector0));
+    EXPECT_TRUE(velocity->hasSameShape(*velocity0));
+
+    scalar->fill([](const Vector3D& pt) { return pt.x; });
+    grids.copyAdvectableScalarDataToBackBuffer(scalarIdx);
+    scalar->forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ((*scalar)(i, j, k), (*scalar0)(i, j, k));
+    });
+
+    scalar->fill(5.0);
+    grids.swapAdvectableScalarData(scalarIdx);
+    EXPECT_EQ(scalar, grids.advectableScalarDataAt(scalarIdx));
+    scalar->forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(i + 0.5, (*scalar)(i, j, k));
+        EXPECT_EQ(5.0, (*scalar0)(i, j, k));
+    });
+
+    velocity->fill(Vector3D(4.0, 5.0, 6.0));
+    grids.copyAdvectableVectorDataToBackBuffer(grids.velocityIndex());
+    velocity0->forEachUIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(4.0, velocity0->u(i, j, k));
+    });
+    velocity0->forEachVIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(5.0, velocity0->v(i, j, k));
+    });
+    velocity0->forEachWIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(6.0, velocity0->w(i, j, k));
+    });
+
+    grids.swapAdvectableVectorData(vectorIdx);
+    EXPECT_EQ(vector, grids.advectableVectorDataAt(vectorIdx));
+
+    grids.resize({16, 8, 12}, {0.5, 0.5, 0.5}, {1.0, 2.0, 3.0});
+    EXPECT_TRUE(scalar->hasSameShape(*scalar0));
+    EXPECT_TRUE(vector->hasSameShape(*vector0));
+    EXPECT_TRUE(velocity->hasSameShape(*velocity0));
+
+    GridSystemData3 grids2(grids);
+    EXPECT_NE(grids.velocityBackBuffer(), grids2.velocityBackBuffer());
+    EXPECT_EQ(
+        grids2.advectableVectorDataAt(grids2.velocityIndex()),
+        grids2.velocity());
+    EXPECT_TRUE(grids2.advectableScalarDataAt(scalarIdx)->hasSameShape(
+        *grids2.advectableScalarDataBackBufferAt(scalarIdx)));
+}
@@ -0,0 +1,87 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/neighbor_lists.h>
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <vector>
+
+using namespace jet;
+
+TEST(NeighborLists, Constructors) {
+    NeighborLists lists;
+    EXPECT_EQ(0u, lists.size());
+    EXPECT_TRUE(lists.empty());
+    EXPECT_EQ(0u, lists.numberOfEntries());
+    EXPECT_EQ(1u, lists.offsets().size());
+
+    std::vector<std::vector<size_t>> nested = {{1, 2}, {}, {0, 1, 3}, {2}};
+    NeighborLists lists2(nested);
+    EXPECT_EQ(4u, lists2.size());
+    EXPECT_EQ(6u, lists2.numberOfEntries());
+
+    for (size_t i = 0; i < nested.size(); ++i) {
+        const auto list = lists2[i];
+        EXPECT_EQ(nested[i].size(), list.size());
+        EXPECT_EQ(lists2.offsets()[i + 1] - lists2.offsets()[i], list.size());
+        for (size_t j = 0; j < list.size(); ++j) {
+            EXPECT_EQ(nested[i][j], list[j]);
+        }
+    }
+
+    EXPECT_EQ(nested, lists2.toNestedLists());
+
+    lists2.clear();
+    EXPECT_TRUE(lists2.empty());
+    EXPECT_EQ(0u, lists2.numberOfEntries());
+}
+
+TEST(NeighborLists, Build) {
+    const size_t n = 1000;
+    NeighborLists lists;
+
+    // i-th list holds (i % 7) consecutive indices starting from i
+    lists.build(n, [](size_t i) { return i % 7; },
+                [](size_t i, NeighborLists::IndexType* dst) {
+                    for (size_t j = 0; j < i % 7; ++j) {
+                        dst[j] = static_cast<NeighborLists::IndexType>(i + j);
+                    }
+                });
+
+    EXPECT_EQ(n, lists.size());
+    size_t total = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const auto list = lists[i];
+        EXPECT_EQ(i % 7, list.size());
+        for (size_t j = 0; j < list.size(); ++j) {
+            EXPECT_EQ(i + j, list[j]);
+        }
+        total += list.size();
+    }
+    EXPECT_EQ(total, lists.numberOfEntries());
+}
+
+TEST(NeighborLists, IndexRange) {
+    NeighborLists lists;
+
+    // Out-of-range neighbor indices should be rejected
+    const size_t maxIndex
+        = std::numeric_limits<NeighborLists::IndexType>::max();
+    if (maxIndex < std::numeric_limits<size_t>::max()) {
+        std::vector<std::vector<size_t>> nested = {{0}, {maxIndex + 1}};
+        EXPECT_THROW(lists.set(nested), std::invalid_argument);
+
+        // The number of lists is checked before any allocation
+        EXPECT_THROW(
+            lists.build(maxIndex + 2, [](size_t) { return kZeroSize; },
+                        [](size_t, NeighborLists::IndexType*) {}),
+            std::invalid_argument);
+    }
+
+    EXPECT_TRUE(lists.empty());
+}
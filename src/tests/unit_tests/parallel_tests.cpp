@@ -215,3 +215,101 @@ TEST(Parallel, Reduce) {
     int expected = std::accumulate(a.begin(), a.end(), 0);
     EXPECT_EQ(expected, sum);
 }
+
+TEST(Parallel, NestedFor) {
+    size_t N = std::max(20u, (3 * sNumCores) / 2);
+    std::vector<std::vector<size_t>> a(N, std::vector<size_t>(N, 0));
+
+    parallelFor(kZeroSize, N, [&](size_t j) {
+        parallelFor(kZeroSize, N, [&](size_t i) { a[j][i] = i + j * N; });
+    });
+
+    for (size_t j = 0; j < N; ++j) {
+        for (size_t i = 0; i < N; ++i) {
+            EXPECT_EQ(i + j * N, a[j][i]);
+        }
+    }
+}
+
+TEST(Parallel, SetMaxNumberOfThreads) {
+    unsigned int oldNumThreads = maxNumberOfThreads();
+    size_t N = 1000;
+
+    for (unsigned int numThreads : {1u, 3u, 8u}) {
+        setMaxNumberOfThreads(numThreads);
+        EXPECT_EQ(numThreads, maxNumberOfThreads());
+
+        std::vector<size_t> a(N, 0);
+        parallelFor(kZeroSize, N, [&a](size_t i) { a[i] = i; });
+        for (size_t i = 0; i < N; ++i) {
+            EXPECT_EQ(i, a[i]);
+        }
+    }
+
+    setMaxNumberOfThreads(oldNumThreads);
+}
+
+#ifdef JET_TASKING_CPP11THREADS
+TEST(Parallel, SetMaxNumberOfThreadsFromTask) {
+    unsigned int oldNumThreads = maxNumberOfThreads();
+
+    // A worker cannot join itself, so resizing from a task should be rejected
+    auto future = internal::async(
+        [oldNumThreads]() { setMaxNumberOfThreads(oldNumThreads + 1); });
+    EXPECT_THROW(future.get(), std::invalid_argument);
+    EXPECT_EQ(oldNumThreads, maxNumberOfThreads());
+
+    // The pool should still be usable
+    size_t N = 1000;
+    std::vector<size_t> a(N, 0);
+    parallelFor(kZeroSize, N, [&a](size_t i) { a[i] = i; });
+    for (size_t i = 0; i < N; ++i) {
+        EXPECT_EQ(i, a[i]);
+    }
+}
+#endif
+
+TEST(Parallel, DeterministicReduce) {
+    size_t N = 100000;
+    std::vector<double> a(N);
+
+    std::mt19937 rng;
+    std::uniform_real_distribution<> d(-1e3, 1e3);
+
+    for (size_t i = 0; i < N; ++i) {
+        a[i] = d(rng);
+    }
+
+    auto sumRange = [&](size_t start, size_t end, double init) {
+        double result = init;
+        for (size_t i = start; i < end; ++i) {
+            result += a[i];
+        }
+        return result;
+    };
+
+    unsigned int oldNumThreads = maxNumberOfThreads();
+
+    double serialSum =
+        parallelReduce(kZeroSize, a.size(), 0.0, sumRange, std::plus<double>(),
+                       ExecutionPolicy::kSerial, ReductionMode::kDeterministic);
+
+    for (unsigned int numThreads : {1u, 2u, 3u, 8u}) {
+        setMaxNumberOfThreads(numThreads);
+        double sum = parallelReduce(kZeroSize, a.size(), 0.0, sumRange,
+                                    std::plus<double>(),
+                                    ExecutionPolicy::kParallel,
+                                    ReductionMode::kDeterministic);
+        EXPECT_EQ(serialSum, sum);
+    }
+
+    setMaxNumberOfThreads(oldNumThreads);
+
+    double expected = std::accumulate(a.begin(), a.end(), 0.0);
+    EXPECT_NEAR(expected, serialSum, 1e-6);
+
+    double emptySum = parallelReduce(
+        kZeroSize, kZeroSize, 0.0, sumRange, std::plus<double>(),
+        ExecutionPolicy::kParallel, ReductionMode::kDeterministic);
+    EXPECT_EQ(0.0, emptySum);
+}
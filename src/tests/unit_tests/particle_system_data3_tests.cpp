@@ -8,6 +8,7 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <vector>
 
 using namespace jet;
@@ -198,15 +199,469 @@ TEST(ParticleSystemData3, BuildNeighborLists) {
 
     const auto& neighborLists = particleSystem.neighborLists();
     EXPECT_EQ(positions.size(), neighborLists.size());
+    EXPECT_EQ(positions.size() + 1, neighborLists.offsets().size());
+    EXPECT_EQ(neighborLists.offsets().back(), neighborLists.numberOfEntries());
 
     for (size_t i = 0; i < neighborLists.size(); ++i) {
         const auto& neighbors = neighborLists[i];
+        size_t expectedCount = 0;
         for (size_t ii = 0; ii < positions.size(); ++ii) {
             if (ii != i && positions[ii].distanceTo(positions[i]) <= radius) {
                 EXPECT_TRUE(neighbors.end() !=
                             std::find(neighbors.begin(), neighbors.end(), ii));
+                ++expectedCount;
             }
         }
+        EXPECT_EQ(expectedCount, neighbors.size());
+    }
+}
+
+TEST(ParticleSystemData3, SparseNeighborSearcher) {
+    ParticleSystemData3 particleSystem;
+    ParticleSystemData3::VectorData positions = {
+        {0.7, 0.2, 0.2}, {0.7, 0.8, 1.0}, {0.9, 0.4, 0.0}, {0.5, 0.1, 0.6},
+        {0.6, 0.3, 0.8}, {0.1, 0.6, 0.0}, {0.5, 1.0, 0.2}, {0.6, 0.7, 0.8},
+        {0.2, 0.4, 0.7}, {0.8, 0.5, 0.8}, {0.0, 0.8, 0.4}, {0.3, 0.0, 0.6},
+        {0.7, 0.8, 0.3}, {0.0, 0.7, 0.1}, {0.6, 0.3, 0.8}, {0.3, 0.2, 1.0},
+        {0.3, 0.5, 0.6}, {0.3, 0.9, 0.6}, {0.9, 1.0, 1.0}, {0.0, 0.1, 0.6}};
+    particleSystem.addParticles(positions);
+
+    EXPECT_FALSE(particleSystem.useSparseNeighborSearcher());
+    particleSystem.setUseSparseNeighborSearcher(true);
+    EXPECT_TRUE(particleSystem.useSparseNeighborSearcher());
+
+    const double radius = 0.4;
+    particleSystem.buildNeighborSearcher(radius);
+    EXPECT_EQ("PointSparseHashGridSearcher3",
+              particleSystem.neighborSearcher()->typeName());
+
+    particleSystem.buildNeighborLists(radius);
+
+    const auto& neighborLists = particleSystem.neighborLists();
+    for (size_t i = 0; i < neighborLists.size(); ++i) {
+        const auto& neighbors = neighborLists[i];
+        size_t expectedCount = 0;
+        for (size_t ii = 0; ii < positions.size(); ++ii) {
+            if (ii != i && positions[ii].distanceTo(positions[i]) <= radius) {
+                EXPECT_TRUE(neighbors.end() !=
+                            std::find(neighbors.begin(), neighbors.end(), ii));
+                ++expectedCount;
+            }
+        }
+        EXPECT_EQ(expectedCount, neighbors.size());
+    }
+
+    ParticleSystemData3 particleSystem2(particleSystem);
+    EXPECT_TRUE(particleSystem2.useSparseNeighborSearcher());
+}
+
+TEST(ParticleSystemData3, SkinRadius) {
+    ParticleSystemData3 particleSystem;
+    ParticleSystemData3::VectorData positions = {
+        {0.7, 0.2, 0.2}, {0.7, 0.8, 1.0}, {0.9, 0.4, 0.0}, {0.5, 0.1, 0.6},
+        {0.6, 0.3, 0.8}, {0.1, 0.6, 0.0}, {0.5, 1.0, 0.2}, {0.6, 0.7, 0.8}};
+    particleSystem.addParticles(positions);
+
+    const double radius = 0.4;
+    const double skin = 0.2;
+
+    // Without skin, lists always need to be rebuilt
+    EXPECT_EQ(0.0, particleSystem.skinRadius());
+    particleSystem.buildNeighborSearcher(radius);
+    particleSystem.buildNeighborLists(radius);
+    EXPECT_TRUE(particleSystem.needsNeighborListsRebuild(radius));
+
+    particleSystem.setSkinRadius(skin);
+    EXPECT_EQ(skin, particleSystem.skinRadius());
+    EXPECT_TRUE(particleSystem.needsNeighborListsRebuild(radius));
+
+    particleSystem.buildNeighborSearcher(radius);
+    particleSystem.buildNeighborLists(radius);
+    EXPECT_FALSE(particleSystem.needsNeighborListsRebuild(radius));
+    EXPECT_TRUE(particleSystem.needsNeighborListsRebuild(2.0 * radius));
+
+    // Lists include neighbors within radius + skin
+    const auto& neighborLists = particleSystem.neighborLists();
+    for (size_t i = 0; i < neighborLists.size(); ++i) {
+        const auto neighbors = neighborLists[i];
+        for (size_t ii = 0; ii < positions.size(); ++ii) {
+            if (ii != i &&
+                positions[ii].distanceTo(positions[i]) <= radius + skin) {
+                EXPECT_TRUE(neighbors.end() !=
+                            std::find(neighbors.begin(), neighbors.end(), ii));
+            }
+        }
+    }
+
+    // Moving less than half of the skin keeps the lists
+    auto x = particleSystem.positions();
+    x[3].x += 0.09;
+    EXPECT_DOUBLE_EQ(0.09,
+                     particleSystem.maxDisplacementSinceNeighborListsBuild());
+    EXPECT_FALSE(particleSystem.needsNeighborListsRebuild(radius));
+
+    x[3].x += 0.02;
+    EXPECT_TRUE(particleSystem.needsNeighborListsRebuild(radius));
+
+    particleSystem.buildNeighborLists(radius);
+    EXPECT_FALSE(particleSystem.needsNeighborListsRebuild(radius));
+
+    // Adding particles or invalidating requires a rebuild
+    particleSystem.addParticle({0.1, 0.1, 0.1});
+    EXPECT_TRUE(particleSystem.needsNeighborListsRebuild(radius));
+
+    particleSystem.buildNeighborLists(radius);
+    EXPECT_FALSE(particleSystem.needsNeighborListsRebuild(radius));
+    particleSystem.invalidateNeighborLists();
+    EXPECT_TRUE(particleSystem.needsNeighborListsRebuild(radius));
+}
+
+TEST(ParticleSystemData3, ForEachNeighborWithoutLists) {
+    ParticleSystemData3 particleSystem;
+    ParticleSystemData3::VectorData positions = {
+        {0.7, 0.2, 0.2}, {0.7, 0.8, 1.0}, {0.9, 0.4, 0.0}, {0.5, 0.1, 0.6},
+        {0.6, 0.3, 0.8}, {0.1, 0.6, 0.0}, {0.5, 1.0, 0.2}, {0.6, 0.7, 0.8},
+        {0.2, 0.4, 0.7}, {0.8, 0.5, 0.8}, {0.0, 0.8, 0.4}, {0.3, 0.0, 0.6},
+        {0.7, 0.8, 0.3}, {0.0, 0.7, 0.1}, {0.6, 0.3, 0.8}, {0.3, 0.2, 1.0}};
+    particleSystem.addParticles(positions);
+
+    const double radius = 0.4;
+    EXPECT_TRUE(particleSystem.useNeighborLists());
+    particleSystem.buildNeighborSearcher(radius);
+    particleSystem.buildNeighborLists(radius);
+
+    std::vector<std::vector<size_t>> expected(positions.size());
+    for (size_t i = 0; i < positions.size(); ++i) {
+        particleSystem.forEachNeighbor(
+            i, [&](size_t j) { expected[i].push_back(j); });
+        std::sort(expected[i].begin(), expected[i].end());
+    }
+
+    particleSystem.setUseNeighborLists(false);
+    EXPECT_FALSE(particleSystem.useNeighborLists());
+    particleSystem.buildNeighborSearcher(radius);
+    particleSystem.buildNeighborLists(radius);
+    EXPECT_EQ(0u, particleSystem.neighborLists().size());
+    EXPECT_TRUE(particleSystem.needsNeighborListsRebuild(radius));
+
+    for (size_t i = 0; i < positions.size(); ++i) {
+        std::vector<size_t> neighbors;
+        particleSystem.forEachNeighbor(
+            i, [&](size_t j) { neighbors.push_back(j); });
+        std::sort(neighbors.begin(), neighbors.end());
+        EXPECT_EQ(expected[i], neighbors);
+    }
+
+    // The searcher also answers queries with the smaller grid spacing
+    size_t count = 0;
+    particleSystem.neighborSearcher()->forEachNearbyPoint(
+        positions[0], radius, [&](size_t, const Vector3D&) { ++count; });
+    EXPECT_EQ(expected[0].size() + 1, count);
+
+    // Copy should keep the mode and the neighbors
+    ParticleSystemData3 particleSystem2(particleSystem);
+    EXPECT_FALSE(particleSystem2.useNeighborLists());
+    std::vector<size_t> neighbors;
+    particleSystem2.forEachNeighbor(
+        0, [&](size_t j) { neighbors.push_back(j); });
+    std::sort(neighbors.begin(), neighbors.end());
+    EXPECT_EQ(expected[0], neighbors);
+
+    // Lists cannot be built with a radius larger than the grid spacing
+    EXPECT_THROW(particleSystem.buildNeighborLists(2.0 * radius),
+                 std::invalid_argument);
+}
+
+TEST(ParticleSystemData3, Reserve) {
+    ParticleSystemData3 particleSystem;
+    size_t a0 = particleSystem.addScalarData(2.0);
+
+    particleSystem.reserve(100);
+    EXPECT_EQ(0u, particleSystem.numberOfParticles());
+    EXPECT_LE(100u, particleSystem.capacity());
+
+    // Layers added after reserving get the same capacity
+    size_t a1 = particleSystem.addVectorData();
+    EXPECT_LE(100u, particleSystem.capacity());
+
+    // Adding particles within the capacity keeps the storage
+    const Vector3D* x = particleSystem.positions().data();
+    const double* s = particleSystem.scalarDataAt(a0).data();
+    for (size_t i = 0; i < 100; ++i) {
+        particleSystem.addParticle({static_cast<double>(i), 0.0, 0.0});
+    }
+    EXPECT_EQ(100u, particleSystem.numberOfParticles());
+    EXPECT_EQ(x, particleSystem.positions().data());
+    EXPECT_EQ(s, particleSystem.scalarDataAt(a0).data());
+    for (size_t i = 0; i < 100; ++i) {
+        EXPECT_EQ(static_cast<double>(i), particleSystem.positions()[i].x);
+        EXPECT_EQ(0.0, particleSystem.scalarDataAt(a0)[i]);
+        EXPECT_EQ(Vector3D(), particleSystem.vectorDataAt(a1)[i]);
+    }
+
+    // Exceeding the capacity grows it geometrically
+    particleSystem.addParticle({100.0, 0.0, 0.0});
+    EXPECT_LE(200u, particleSystem.capacity());
+
+    // Sorting recycles the storage
+    const size_t capacity = particleSystem.capacity();
+    particleSystem.sortParticles();
+    particleSystem.sortParticles();
+    EXPECT_LE(capacity, particleSystem.capacity());
+}
+
+TEST(ParticleSystemData3, ForEachNeighborWithoutListsInWideDomain) {
+    // The domain spans far more cells than the default hash grid resolution
+    ParticleSystemData3 particleSystem;
+    ParticleSystemData3::VectorData positions;
+    for (size_t i = 0; i < 1000; ++i) {
+        double t = static_cast<double>(i);
+        positions.append(Vector3D(std::fmod(0.37 * t, 20.0),
+                                  std::fmod(0.71 * t, 0.6),
+                                  std::fmod(0.13 * t, 0.3)));
+    }
+    particleSystem.addParticles(positions);
+
+    const double radius = 0.1;
+    particleSystem.setUseNeighborLists(false);
+    particleSystem.buildNeighborSearcher(radius);
+    particleSystem.buildNeighborLists(radius);
+
+    for (size_t i = 0; i < positions.size(); ++i) {
+        std::vector<size_t> expected;
+        for (size_t j = 0; j < positions.size(); ++j) {
+            if (i != j && positions[i].distanceTo(positions[j]) <= radius) {
+                expected.push_back(j);
+            }
+        }
+
+        std::vector<size_t> neighbors;
+        particleSystem.forEachNeighbor(
+            i, [&](size_t j) { neighbors.push_back(j); });
+        std::sort(neighbors.begin(), neighbors.end());
+        EXPECT_EQ(expected, neighbors);
+    }
+}
+
+TEST(ParticleSystemData3, SortParticles) {
+    ParticleSystemData3 particleSystem;
+    ParticleSystemData3::VectorData positions = {
+        {0.7, 0.2, 0.2}, {0.7, 0.8, 1.0}, {0.9, 0.4, 0.0}, {0.5, 0.1, 0.6},
+        {0.6, 0.3, 0.8}, {0.1, 0.6, 0.0}, {0.5, 1.0, 0.2}, {0.6, 0.7, 0.8},
+        {0.2, 0.4, 0.7}, {0.8, 0.5, 0.8}, {0.0, 0.8, 0.4}, {0.3, 0.0, 0.6},
+        {0.7, 0.8, 0.3}, {0.0, 0.7, 0.1}, {0.6, 0.3, 0.8}, {0.3, 0.2, 1.0}};
+    particleSystem.addParticles(positions);
+
+    size_t a0 = particleSystem.addScalarData(2.0);
+    size_t a1 = particleSystem.addVectorData();
+    auto s = particleSystem.scalarDataAt(a0);
+    auto v = particleSystem.vectorDataAt(a1);
+    for (size_t i = 0; i < positions.size(); ++i) {
+        s[i] = static_cast<double>(i);
+        v[i] = positions[i] * 2.0;
+    }
+
+    const double radius = 0.4;
+    particleSystem.setSkinRadius(0.1);
+    particleSystem.buildNeighborSearcher(radius);
+    particleSystem.buildNeighborLists(radius);
+    EXPECT_FALSE(particleSystem.needsNeighborListsRebuild(radius));
+
+    Array1<size_t> permutation;
+    particleSystem.sortParticles(&permutation);
+    EXPECT_TRUE(particleSystem.needsNeighborListsRebuild(radius));
+    ASSERT_EQ(positions.size(), permutation.size());
+
+    // Permutation should be a bijection and all layers follow it
+    std::vector<size_t> sorted(permutation.begin(), permutation.end());
+    std::sort(sorted.begin(), sorted.end());
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        EXPECT_EQ(i, sorted[i]);
+    }
+
+    auto x = particleSystem.positions();
+    s = particleSystem.scalarDataAt(a0);
+    v = particleSystem.vectorDataAt(a1);
+    for (size_t i = 0; i < positions.size(); ++i) {
+        EXPECT_EQ(positions[permutation[i]], x[i]);
+        EXPECT_EQ(static_cast<double>(permutation[i]), s[i]);
+        EXPECT_EQ(positions[permutation[i]] * 2.0, v[i]);
+    }
+
+    // The searcher should report the new indices without an explicit rebuild
+    for (size_t i = 0; i < positions.size(); ++i) {
+        size_t cnt = 0;
+        particleSystem.neighborSearcher()->forEachNearbyPoint(
+            x[i], radius, [&](size_t j, const Vector3D& pt) {
+                EXPECT_EQ(x[j], pt);
+                ++cnt;
+            });
+        EXPECT_LT(0u, cnt);
+    }
+
+    particleSystem.buildNeighborLists(radius);
+    EXPECT_FALSE(particleSystem.needsNeighborListsRebuild(radius));
+    const auto& neighborLists = particleSystem.neighborLists();
+    for (size_t i = 0; i < positions.size(); ++i) {
+        for (size_t j : neighborLists[i]) {
+            EXPECT_GT(radius + 0.1, x[i].distanceTo(x[j]));
+        }
+    }
+
+    // Particles {0.6, 0.3, 0.8} (4 and 14) share the same code and should
+    // keep their order
+    auto it4 = std::find(permutation.begin(), permutation.end(), 4);
+    auto it14 = std::find(permutation.begin(), permutation.end(), 14);
+    EXPECT_EQ(it4 + 1, it14);
+
+    // Z-order visits the lower half in z (and then in y) first
+    EXPECT_TRUE(x[0].y < 0.5 && x[0].z < 0.5);
+    const Vector3D& last = x[positions.size() - 1];
+    EXPECT_TRUE(last.x >= 0.5 && last.y >= 0.5 && last.z >= 0.5);
+
+    // Sorting again should not change the order
+    particleSystem.sortParticles(&permutation);
+    for (size_t i = 0; i < positions.size(); ++i) {
+        EXPECT_EQ(i, permutation[i]);
+    }
+}
+
+TEST(ParticleSystemData3, RemoveParticles) {
+    // Use enough particles to span multiple compaction blocks
+    const size_t n = 10000;
+    ParticleSystemData3 particleSystem;
+    ParticleSystemData3::VectorData positions(n);
+    for (size_t i = 0; i < n; ++i) {
+        positions[i] = Vector3D(static_cast<double>(i), 0.0, 0.0);
+    }
+    particleSystem.addParticles(positions);
+
+    size_t a0 = particleSystem.addScalarData(2.0);
+    size_t a1 = particleSystem.addVectorData();
+    auto s = particleSystem.scalarDataAt(a0);
+    auto v = particleSystem.vectorDataAt(a1);
+    for (size_t i = 0; i < n; ++i) {
+        s[i] = static_cast<double>(i);
+        v[i] = positions[i] * 2.0;
+    }
+
+    const double radius = 1.5;
+    particleSystem.setSkinRadius(0.1);
+    particleSystem.buildNeighborSearcher(radius);
+    particleSystem.buildNeighborLists(radius);
+    EXPECT_FALSE(particleSystem.needsNeighborListsRebuild(radius));
+
+    // Remove every third particle and the whole range of [5000, 9000)
+    Array1<char> mask(n, 0);
+    size_t expectedNumberOfParticles = 0;
+    for (size_t i = 0; i < n; ++i) {
+        mask[i] = (i % 3 == 0 || (i >= 5000 && i < 9000)) ? 1 : 0;
+        expectedNumberOfParticles += (mask[i] == 0) ? 1 : 0;
+    }
+
+    Array1<size_t> remaining;
+    particleSystem.removeParticles(mask, &remaining);
+    EXPECT_TRUE(particleSystem.needsNeighborListsRebuild(radius));
+    ASSERT_EQ(expectedNumberOfParticles, particleSystem.numberOfParticles());
+    ASSERT_EQ(expectedNumberOfParticles, remaining.size());
+
+    // The remaining particles keep their order and all layers follow them
+    auto x = particleSystem.positions();
+    s = particleSystem.scalarDataAt(a0);
+    v = particleSystem.vectorDataAt(a1);
+    size_t j = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (mask[i] == 0) {
+            EXPECT_EQ(i, remaining[j]);
+            EXPECT_EQ(positions[i], x[j]);
+            EXPECT_EQ(static_cast<double>(i), s[j]);
+            EXPECT_EQ(positions[i] * 2.0, v[j]);
+            ++j;
+        }
+    }
+
+    // Neighbor lists are rebuilt with the new indices
+    particleSystem.buildNeighborSearcher(radius);
+    particleSystem.buildNeighborLists(radius);
+    EXPECT_EQ(expectedNumberOfParticles,
+              particleSystem.neighborLists().size());
+
+    // Removing nothing keeps all the particles
+    Array1<char> emptyMask(expectedNumberOfParticles, 0);
+    particleSystem.removeParticles(emptyMask, &remaining);
+    EXPECT_EQ(expectedNumberOfParticles, particleSystem.numberOfParticles());
+    for (size_t i = 0; i < remaining.size(); ++i) {
+        EXPECT_EQ(i, remaining[i]);
+    }
+
+    // Removing all the particles
+    Array1<char> fullMask(expectedNumberOfParticles, 1);
+    particleSystem.removeParticles(fullMask);
+    EXPECT_EQ(0u, particleSystem.numberOfParticles());
+
+    // Mask size should match the number of particles
+    EXPECT_THROW(particleSystem.removeParticles(mask), std::invalid_argument);
+}
+
+TEST(ParticleSystemData3, QueryNeighborsAfterRemoval) {
+    ParticleSystemData3 particleSystem;
+    ParticleSystemData3::VectorData positions;
+    for (size_t k = 0; k < 6; ++k) {
+        for (size_t j = 0; j < 6; ++j) {
+            for (size_t i = 0; i < 6; ++i) {
+                positions.append(Vector3D(0.1 * i, 0.1 * j, 0.1 * k));
+            }
+        }
+    }
+    particleSystem.addParticles(positions);
+
+    const double radius = 0.15;
+    particleSystem.setUseNeighborLists(false);
+    particleSystem.buildNeighborSearcher(radius);
+    particleSystem.buildNeighborLists(radius);
+
+    // Remove the upper half without rebuilding the searcher
+    Array1<char> mask(positions.size(), 0);
+    for (size_t i = 0; i < positions.size(); ++i) {
+        mask[i] = (positions[i].z > 0.25) ? 1 : 0;
+    }
+    particleSystem.removeParticles(mask);
+
+    const size_t n = particleSystem.numberOfParticles();
+    ASSERT_EQ(positions.size() / 2, n);
+    auto x = particleSystem.positions();
+
+    std::vector<std::vector<size_t>> expected(n);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            if (i != j && x[i].distanceTo(x[j]) <= radius) {
+                expected[i].push_back(j);
+            }
+        }
+    }
+
+    // The searcher only returns the remaining particles
+    for (size_t i = 0; i < n; ++i) {
+        std::vector<size_t> found;
+        particleSystem.neighborSearcher()->forEachNearbyPoint(
+            x[i], radius, [&](size_t j, const Vector3D& pt) {
+                ASSERT_LT(j, n);
+                EXPECT_EQ(x[j], pt);
+                if (i != j) {
+                    found.push_back(j);
+                }
+            });
+        std::sort(found.begin(), found.end());
+        EXPECT_EQ(expected[i], found);
+    }
+
+    particleSystem.buildNeighborLists(radius);
+    for (size_t i = 0; i < n; ++i) {
+        std::vector<size_t> neighbors;
+        particleSystem.forEachNeighbor(
+            i, [&](size_t j) { neighbors.push_back(j); });
+        std::sort(neighbors.begin(), neighbors.end());
+        EXPECT_EQ(expected[i], neighbors);
     }
 }
 
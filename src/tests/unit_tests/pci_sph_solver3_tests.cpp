@@ -4,7 +4,10 @@
 // personal capacity and am not conveying any rights to any intellectual
 // property of any third parties.
 
+#include <jet/box3.h>
 #include <jet/pci_sph_solver3.h>
+#include <jet/rigid_body_collider3.h>
+#include <jet/volume_particle_emitter3.h>
 #include <gtest/gtest.h>
 
 using namespace jet;
@@ -29,3 +32,113 @@ TEST(PciSphSolver3, Parameters) {
     solver.setMaxNumberOfIterations(10);
     EXPECT_DOUBLE_EQ(10, solver.maxNumberOfIterations());
 }
+
+TEST(PciSphSolver3, UpdateWithSleeping) {
+    PciSphSolver3 solver;
+    solver.setIsUsingSleeping(true);
+
+    auto particles = solver.sphSystemData();
+    particles->setTargetDensity(1000.0);
+    particles->setTargetSpacing(0.04);
+
+    BoundingBox3D domainBox({0.0, 0.0, 0.0}, {0.5, 0.5, 0.5});
+    BoundingBox3D sourceBound(domainBox);
+    sourceBound.expand(-0.04);
+
+    auto pool = Box3::builder()
+        .withLowerCorner({0.0, 0.0, 0.0})
+        .withUpperCorner({0.5, 0.2, 0.5})
+        .makeShared();
+    auto emitter = VolumeParticleEmitter3::builder()
+        .withSurface(pool)
+        .withSpacing(0.04)
+        .withMaxRegion(sourceBound)
+        .withIsOneShot(true)
+        .makeShared();
+    solver.setEmitter(emitter);
+
+    auto domain = Box3::builder()
+        .withBoundingBox(domainBox)
+        .withIsNormalFlipped(true)
+        .makeShared();
+    solver.setCollider(
+        RigidBodyCollider3::builder().withSurface(domain).makeShared());
+
+    Frame frame(0, 1.0 / 60.0);
+    for (; frame.index < 30; ++frame) {
+        solver.update(frame);
+    }
+
+    // The pool settles down and falls asleep
+    const size_t numberOfParticles = particles->numberOfParticles();
+    ASSERT_GT(numberOfParticles, 0u);
+    EXPECT_LT(numberOfParticles / 2, solver.numberOfSleepingParticles());
+
+    auto x = particles->positions();
+    auto v = particles->velocities();
+    for (size_t i = 0; i < numberOfParticles; ++i) {
+        EXPECT_TRUE(domainBox.contains(x[i]));
+    }
+
+    // Pushing a particle wakes it up
+    size_t top = 0;
+    for (size_t i = 0; i < numberOfParticles; ++i) {
+        if (x[i].y > x[top].y) {
+            top = i;
+        }
+    }
+    v[top] = Vector3D(0.0, -1.0, 0.0);
+
+    solver.update(frame++);
+    EXPECT_GT(numberOfParticles, solver.numberOfSleepingParticles());
+
+    x = particles->positions();
+    for (size_t i = 0; i < numberOfParticles; ++i) {
+        EXPECT_TRUE(domainBox.contains(x[i]));
+    }
+}
+
+TEST(PciSphSolver3, UpdateBlock) {
+    PciSphSolver3 solver;
+    solver.setMaxNumberOfIterations(3);
+    EXPECT_EQ(0u, solver.lastNumberOfIterations());
+
+    auto particles = solver.sphSystemData();
+    particles->setTargetDensity(1000.0);
+    particles->setTargetSpacing(0.1);
+
+    auto box = Box3::builder()
+        .withLowerCorner({0.0, 0.0, 0.0})
+        .withUpperCorner({0.5, 0.5, 0.5})
+        .makeShared();
+    auto emitter = VolumeParticleEmitter3::builder()
+        .withSurface(box)
+        .withSpacing(0.1)
+        .withIsOneShot(true)
+        .makeShared();
+    solver.setEmitter(emitter);
+
+    BoundingBox3D domainBox({0.0, 0.0, 0.0}, {1.0, 1.0, 1.0});
+    auto domain = Box3::builder()
+        .withBoundingBox(domainBox)
+        .withIsNormalFlipped(true)
+        .makeShared();
+    solver.setCollider(
+        RigidBodyCollider3::builder().withSurface(domain).makeShared());
+
+    Frame frame(0, 1.0 / 60.0);
+    for (; frame.index < 10; ++frame) {
+        solver.update(frame);
+    }
+
+    // The iteration stats are reported for the last sub-step
+    EXPECT_LE(1u, solver.lastNumberOfIterations());
+    EXPECT_GE(3u, solver.lastNumberOfIterations());
+    EXPECT_LE(0.0, solver.lastIterationTimeInSeconds());
+
+    ASSERT_GT(particles->numberOfParticles(), 0u);
+    auto x = particles->positions();
+    for (size_t i = 0; i < x.size(); ++i) {
+        EXPECT_TRUE(domainBox.contains(x[i]));
+    }
+}
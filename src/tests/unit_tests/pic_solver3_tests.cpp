@@ -7,6 +7,8 @@
 #include <jet/pic_solver3.h>
 #include <gtest/gtest.h>
 
+#include <random>
+
 using namespace jet;
 
 TEST(PicSolver3, UpdateEmpty) {
@@ -16,3 +18,38 @@ TEST(PicSolver3, UpdateEmpty) {
         solver.update(frame);
     }
 }
+
+TEST(PicSolver3, SignedDistanceField) {
+    auto solver = PicSolver3::builder()
+        .withResolution({16, 20, 24})
+        .withDomainSizeX(1.0)
+        .makeShared();
+    solver->setGravity({0.0, 0.0, 0.0});
+
+    // Particles at rest, including a few outside of the domain
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> dist(-0.1, 1.3);
+    Array1<Vector3D> points(300);
+    for (size_t i = 0; i < points.size(); ++i) {
+        points[i] = Vector3D(dist(rng), dist(rng), dist(rng));
+    }
+    auto particles = solver->particleSystemData();
+    particles->addParticles(points);
+
+    solver->update(Frame(0, 1.0 / 60.0));
+
+    // The splatted field should match the brute-force distances exactly
+    auto sdf = solver->signedDistanceField();
+    auto sdfPos = sdf->dataPosition();
+    const Vector3D h = sdf->gridSpacing();
+    const double radius = 1.2 * max3(h.x, h.y, h.z) / std::sqrt(2.0);
+    const double sdfBandRadius = 2.0 * radius;
+    sdf->forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        Vector3D pt = sdfPos(i, j, k);
+        double minDist = sdfBandRadius;
+        for (size_t p = 0; p < points.size(); ++p) {
+            minDist = std::min(minDist, pt.distanceTo(points[p]));
+        }
+        EXPECT_DOUBLE_EQ(minDist - radius, (*sdf)(i, j, k));
+    });
+}
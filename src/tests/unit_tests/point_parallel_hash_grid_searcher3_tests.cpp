@@ -7,6 +7,8 @@
 #include <jet/array1.h>
 #include <jet/point_parallel_hash_grid_searcher3.h>
 #include <gtest/gtest.h>
+
+#include <algorithm>
 #include <vector>
 
 using namespace jet;
@@ -52,6 +54,41 @@ TEST(PointParallelHashGridSearcher3, ForEachNearbyPointEmpty) {
         });
 }
 
+TEST(PointParallelHashGridSearcher3, ForEachNearbyPointLargeRadius) {
+    Array1<Vector3D> points;
+    for (size_t i = 0; i < 1000; ++i) {
+        double t = static_cast<double>(i);
+        points.append(Vector3D(std::fmod(0.37 * t, 3.0),
+                               std::fmod(0.71 * t, 2.0),
+                               std::fmod(0.13 * t, 1.5)));
+    }
+
+    // Search radius larger than the grid spacing and the wrapped domain
+    PointParallelHashGridSearcher3 searcher(4, 4, 4, 0.25);
+    searcher.build(points.accessor());
+
+    const Vector3D origin(1.0, 1.0, 0.5);
+    for (double radius : {0.2, 0.6, 1.3}) {
+        std::vector<size_t> expected;
+        for (size_t i = 0; i < points.size(); ++i) {
+            if (points[i].distanceTo(origin) <= radius) {
+                expected.push_back(i);
+            }
+        }
+
+        std::vector<size_t> found;
+        searcher.forEachNearbyPoint(
+            origin, radius, [&](size_t i, const Vector3D& pt) {
+                EXPECT_EQ(points[i], pt);
+                found.push_back(i);
+            });
+        std::sort(found.begin(), found.end());
+
+        EXPECT_EQ(expected, found);
+        EXPECT_EQ(!expected.empty(), searcher.hasNearbyPoint(origin, radius));
+    }
+}
+
 TEST(PointParallelHashGridSearcher3, CopyConstructor) {
     Array1<Vector3D> points = {
         Vector3D(0, 1, 3),
@@ -0,0 +1,283 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/array1.h>
+#include <jet/point_simple_list_searcher3.h>
+#include <jet/point_sparse_hash_grid_searcher3.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace jet;
+
+TEST(PointSparseHashGridSearcher3, ForEachNearbyPoint) {
+    Array1<Vector3D> points = {
+        Vector3D(0, 1, 3),
+        Vector3D(2, 5, 4),
+        Vector3D(-1, 3, 0)
+    };
+
+    PointSparseHashGridSearcher3 searcher(std::sqrt(10));
+    searcher.build(points.accessor());
+
+    int cnt = 0;
+    searcher.forEachNearbyPoint(
+        Vector3D(0, 0, 0),
+        std::sqrt(10.0),
+        [&](size_t i, const Vector3D& pt) {
+            EXPECT_TRUE(i == 0 || i == 2);
+
+            if (i == 0) {
+                EXPECT_EQ(points[0], pt);
+            } else if (i == 2) {
+                EXPECT_EQ(points[2], pt);
+            }
+
+            ++cnt;
+        });
+    EXPECT_EQ(2, cnt);
+}
+
+TEST(PointSparseHashGridSearcher3, ForEachNearbyPointEmpty) {
+    Array1<Vector3D> points;
+
+    PointSparseHashGridSearcher3 searcher(std::sqrt(10));
+    searcher.build(points.accessor());
+
+    searcher.forEachNearbyPoint(
+        Vector3D(0, 0, 0),
+        std::sqrt(10.0),
+        [](size_t, const Vector3D&) {
+        });
+}
+
+TEST(PointSparseHashGridSearcher3, ForEachNearbyPointLargeRadius) {
+    Array1<Vector3D> points;
+    for (size_t i = 0; i < 1000; ++i) {
+        double t = static_cast<double>(i);
+        points.append(Vector3D(std::fmod(0.37 * t, 3.0),
+                               std::fmod(0.71 * t, 2.0),
+                               std::fmod(0.13 * t, 1.5)));
+    }
+    points.append(Vector3D(40.0, 0.0, 0.0));
+
+    // Search radius larger than the grid spacing with both cell tables
+    for (bool isSparse : {false, true}) {
+        Array1<Vector3D> queryPoints(points.size() - (isSparse ? 0 : 1));
+        for (size_t i = 0; i < queryPoints.size(); ++i) {
+            queryPoints[i] = points[i];
+        }
+
+        PointSparseHashGridSearcher3 searcher(0.25);
+        searcher.build(queryPoints.accessor());
+        EXPECT_EQ(!isSparse, searcher.usesDenseTable());
+
+        const Vector3D origin(1.0, 1.0, 0.5);
+        for (double radius : {0.2, 0.6, 1.3, 100.0}) {
+            std::vector<size_t> expected;
+            for (size_t i = 0; i < queryPoints.size(); ++i) {
+                if (queryPoints[i].distanceTo(origin) <= radius) {
+                    expected.push_back(i);
+                }
+            }
+
+            std::vector<size_t> found;
+            searcher.forEachNearbyPoint(
+                origin, radius, [&](size_t i, const Vector3D& pt) {
+                    EXPECT_EQ(queryPoints[i], pt);
+                    found.push_back(i);
+                });
+            std::sort(found.begin(), found.end());
+
+            EXPECT_EQ(expected, found);
+            EXPECT_EQ(!expected.empty(),
+                      searcher.hasNearbyPoint(origin, radius));
+        }
+    }
+}
+
+TEST(PointSparseHashGridSearcher3, CopyConstructor) {
+    Array1<Vector3D> points = {
+        Vector3D(0, 1, 3),
+        Vector3D(2, 5, 4),
+        Vector3D(-1, 3, 0)
+    };
+
+    PointSparseHashGridSearcher3 searcher(std::sqrt(10));
+    searcher.build(points.accessor());
+
+    PointSparseHashGridSearcher3 searcher2(searcher);
+    int cnt = 0;
+    searcher2.forEachNearbyPoint(
+        Vector3D(0, 0, 0),
+        std::sqrt(10.0),
+        [&](size_t i, const Vector3D& pt) {
+            EXPECT_TRUE(i == 0 || i == 2);
+
+            if (i == 0) {
+                EXPECT_EQ(points[0], pt);
+            } else if (i == 2) {
+                EXPECT_EQ(points[2], pt);
+            }
+
+            ++cnt;
+        });
+    EXPECT_EQ(2, cnt);
+}
+
+TEST(PointSparseHashGridSearcher3, Serialization) {
+    Array1<Vector3D> points = {
+        Vector3D(0, 1, 3),
+        Vector3D(2, 5, 4),
+        Vector3D(-1, 3, 0)
+    };
+
+    PointSparseHashGridSearcher3 searcher(std::sqrt(10));
+    searcher.build(points.accessor());
+
+    std::vector<uint8_t> buffer;
+    searcher.serialize(&buffer);
+
+    PointSparseHashGridSearcher3 searcher2;
+    searcher2.deserialize(buffer);
+
+    int cnt = 0;
+    searcher2.forEachNearbyPoint(
+        Vector3D(0, 0, 0),
+        std::sqrt(10.0),
+        [&](size_t i, const Vector3D& pt) {
+            EXPECT_TRUE(i == 0 || i == 2);
+
+            if (i == 0) {
+                EXPECT_EQ(points[0], pt);
+            } else if (i == 2) {
+                EXPECT_EQ(points[2], pt);
+            }
+
+            ++cnt;
+        });
+    EXPECT_EQ(2, cnt);
+}
+
+TEST(PointSparseHashGridSearcher3, ThinDomain) {
+    // A 100 x 1 x 100 sheet which a fixed-resolution hash grid would alias
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> dist(0.0, 1.0);
+    Array1<Vector3D> points(2000);
+    for (auto& pt : points) {
+        pt = Vector3D(100.0 * dist(rng) - 50.0, dist(rng), 100.0 * dist(rng));
+    }
+
+    double radius = 2.0;
+    PointSparseHashGridSearcher3 searcher(2.0 * radius);
+    searcher.build(points.accessor());
+
+    PointSimpleListSearcher3 answer;
+    answer.build(points.accessor());
+
+    // The sheet is densely occupied, so a dense table over the occupied box
+    // is used instead of the hash table.
+    EXPECT_EQ(points.size(), searcher.sortedIndices().size());
+    EXPECT_TRUE(searcher.usesDenseTable());
+    EXPECT_LE(searcher.numberOfBuckets(), 4 * searcher.numberOfOccupiedCells());
+    EXPECT_LE(searcher.numberOfOccupiedCells(), 25u * 25u * 2u);
+
+    for (size_t i = 0; i < 100; ++i) {
+        Vector3D origin = points[i * 20];
+
+        std::vector<size_t> actual;
+        searcher.forEachNearbyPoint(
+            origin, radius, [&](size_t j, const Vector3D& pt) {
+                EXPECT_EQ(points[j], pt);
+                actual.push_back(j);
+            });
+
+        std::vector<size_t> expected;
+        answer.forEachNearbyPoint(
+            origin, radius, [&](size_t j, const Vector3D&) {
+                expected.push_back(j);
+            });
+
+        std::sort(actual.begin(), actual.end());
+        std::sort(expected.begin(), expected.end());
+        EXPECT_EQ(expected, actual);
+
+        EXPECT_TRUE(searcher.hasNearbyPoint(origin, radius));
+    }
+
+    EXPECT_FALSE(searcher.hasNearbyPoint(Vector3D(0, 10, 0), radius));
+}
+
+TEST(PointSparseHashGridSearcher3, HugeDomain) {
+    // Cells beyond the packable range of the sort key
+    Array1<Vector3D> points = {
+        Vector3D(1e7, 0, 0),
+        Vector3D(1e7 + 0.5, 0, 0),
+        Vector3D(-1e7, 0, 0),
+        Vector3D(0, 0, 1e8),
+        Vector3D(0, 0.5, 1e8)
+    };
+
+    PointSparseHashGridSearcher3 searcher(2.0);
+    searcher.build(points.accessor());
+    EXPECT_EQ(3u, searcher.numberOfOccupiedCells());
+    EXPECT_FALSE(searcher.usesDenseTable());
+    EXPECT_GE(searcher.numberOfBuckets(), 2 * searcher.numberOfOccupiedCells());
+
+    std::vector<size_t> actual;
+    searcher.forEachNearbyPoint(
+        Vector3D(0, 0.2, 1e8), 1.0,
+        [&](size_t i, const Vector3D&) { actual.push_back(i); });
+    std::sort(actual.begin(), actual.end());
+    EXPECT_EQ(std::vector<size_t>({3, 4}), actual);
+
+    EXPECT_TRUE(searcher.hasNearbyPoint(Vector3D(1e7, 0.1, 0), 1.0));
+    EXPECT_FALSE(searcher.hasNearbyPoint(Vector3D(0, 0, 0), 1.0));
+}
+
+TEST(PointSparseHashGridSearcher3, TwoClusters) {
+    // Two distant blocks only fill a tiny part of their bounding box, so the
+    // occupied cells are hashed.
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> dist(0.0, 1.0);
+    Array1<Vector3D> points(2000);
+    for (size_t i = 0; i < points.size(); ++i) {
+        Vector3D offset = (i % 2 == 0) ? Vector3D() : Vector3D(1e3, 1e3, 1e3);
+        points[i] = offset + Vector3D(dist(rng), dist(rng), dist(rng));
+    }
+
+    double radius = 0.1;
+    PointSparseHashGridSearcher3 searcher(2.0 * radius);
+    searcher.build(points.accessor());
+    EXPECT_FALSE(searcher.usesDenseTable());
+
+    PointSimpleListSearcher3 answer;
+    answer.build(points.accessor());
+
+    for (size_t i = 0; i < 100; ++i) {
+        Vector3D origin = points[i * 20 + i % 2];
+
+        std::vector<size_t> actual;
+        searcher.forEachNearbyPoint(
+            origin, radius, [&](size_t j, const Vector3D& pt) {
+                EXPECT_EQ(points[j], pt);
+                actual.push_back(j);
+            });
+
+        std::vector<size_t> expected;
+        answer.forEachNearbyPoint(
+            origin, radius, [&](size_t j, const Vector3D&) {
+                expected.push_back(j);
+            });
+
+        std::sort(actual.begin(), actual.end());
+        std::sort(expected.begin(), expected.end());
+        EXPECT_EQ(expected, actual);
+    }
+
+    EXPECT_FALSE(searcher.hasNearbyPoint(Vector3D(500, 500, 500), radius));
+}
@@ -4,12 +4,18 @@
 // personal capacity and am not conveying any rights to any intellectual
 // property of any third parties.
 
+#include <jet/array1.h>
+#include <jet/box3.h>
 #include <jet/implicit_surface_set3.h>
 #include <jet/plane3.h>
 #include <jet/rigid_body_collider3.h>
+#include <jet/sphere3.h>
+#include <jet/surface_set3.h>
 
 #include <gtest/gtest.h>
 
+#include <random>
+
 using namespace jet;
 
 TEST(RigidBodyCollider3, ResolveCollision) {
@@ -151,3 +157,58 @@ TEST(RigidBodyCollider3, Empty) {
     EXPECT_DOUBLE_EQ(0.0, newVelocity.y);
     EXPECT_DOUBLE_EQ(0.0, newVelocity.z);
 }
+
+TEST(RigidBodyCollider3, ResolveCollisionOfPoints) {
+    auto box = Box3::builder()
+        .withLowerCorner({0, 0, 0})
+        .withUpperCorner({1, 1, 1})
+        .withIsNormalFlipped(true)
+        .makeShared();
+    auto sphere = Sphere3::builder()
+        .withCenter({0.5, 0.3, 0.5})
+        .withRadius(0.2)
+        .makeShared();
+    auto surface = SurfaceSet3::builder()
+        .withSurfaces({box, sphere})
+        .makeShared();
+    RigidBodyCollider3 collider(surface);
+    collider.setFrictionCoefficient(0.1);
+    EXPECT_TRUE(collider.isUsingBroadPhase());
+
+    const double radius = 0.02;
+    const double restitutionCoefficient = 0.5;
+
+    // Points inside and slightly outside of the box moving downward
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> d(-0.05, 1.05);
+    Array1<Vector3D> positions(20000);
+    Array1<Vector3D> velocities(20000);
+    for (size_t i = 0; i < positions.size(); ++i) {
+        positions[i] = Vector3D(d(rng), d(rng), d(rng));
+        velocities[i] = Vector3D(0.1, -1.0, 0.0);
+    }
+
+    Array1<Vector3D> expectedPositions(positions);
+    Array1<Vector3D> expectedVelocities(velocities);
+    for (size_t i = 0; i < positions.size(); ++i) {
+        collider.resolveCollision(radius, restitutionCoefficient,
+                                  &expectedPositions[i],
+                                  &expectedVelocities[i]);
+    }
+
+    // The broad phase only skips the points that are not in contact
+    for (int useBroadPhase = 0; useBroadPhase < 2; ++useBroadPhase) {
+        collider.setIsUsingBroadPhase(useBroadPhase != 0);
+
+        Array1<Vector3D> newPositions(positions);
+        Array1<Vector3D> newVelocities(velocities);
+        collider.resolveCollision(radius, restitutionCoefficient,
+                                  newPositions.accessor(),
+                                  newVelocities.accessor());
+
+        for (size_t i = 0; i < positions.size(); ++i) {
+            EXPECT_EQ(expectedPositions[i], newPositions[i]);
+            EXPECT_EQ(expectedVelocities[i], newVelocities[i]);
+        }
+    }
+}
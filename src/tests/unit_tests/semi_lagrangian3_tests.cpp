@@ -0,0 +1,138 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/cell_centered_scalar_grid3.h>
+#include <jet/cell_centered_vector_grid3.h>
+#include <jet/cubic_semi_lagrangian3.h>
+#include <jet/custom_scalar_field3.h>
+#include <jet/face_centered_grid3.h>
+#include <jet/vertex_centered_scalar_grid3.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace jet;
+
+namespace {
+
+// Samples every grid as a constant to see if the sampler hooks are used
+class ConstantSemiLagrangian3 : public SemiLagrangian3 {
+ protected:
+    std::function<double(const Vector3D&)> getScalarSamplerFunc(
+        const ScalarGrid3&) const override {
+        return [](const Vector3D&) { return 7.0; };
+    }
+
+    std::function<Vector3D(const Vector3D&)> getVectorSamplerFunc(
+        const CollocatedVectorGrid3&) const override {
+        return [](const Vector3D&) { return Vector3D(1.0, 2.0, 3.0); };
+    }
+
+    std::function<Vector3D(const Vector3D&)> getVectorSamplerFunc(
+        const FaceCenteredGrid3&) const override {
+        return [](const Vector3D&) { return Vector3D(4.0, 5.0, 6.0); };
+    }
+};
+
+void testAdvectScalars(AdvectionSolver3* solver) {
+    Size3 res(16, 12, 10);
+    Vector3D h(0.1, 0.1, 0.1);
+
+    FaceCenteredGrid3 flow(res, h);
+    flow.fill([](const Vector3D& pt) {
+        return Vector3D(-(pt.y - 0.6), pt.x - 0.8, 0.3);
+    });
+
+    CustomScalarField3 boundarySdf([](const Vector3D& pt) {
+        return pt.distanceTo(Vector3D(0.8, 0.6, 0.5)) - 0.2;
+    });
+
+    CellCenteredScalarGrid3 density(res, h);
+    CellCenteredScalarGrid3 temperature(res, h);
+    VertexCenteredScalarGrid3 fuel(res, h);
+    density.fill([](const Vector3D& pt) { return pt.x * pt.y; });
+    temperature.fill([](const Vector3D& pt) { return std::sin(pt.z); });
+    fuel.fill([](const Vector3D& pt) { return pt.y - pt.z; });
+
+    CellCenteredScalarGrid3 density0(density);
+    CellCenteredScalarGrid3 temperature0(temperature);
+    VertexCenteredScalarGrid3 fuel0(fuel);
+    solver->advect(density, flow, 0.05, &density0, boundarySdf);
+    solver->advect(temperature, flow, 0.05, &temperature0, boundarySdf);
+    solver->advect(fuel, flow, 0.05, &fuel0, boundarySdf);
+
+    CellCenteredScalarGrid3 density1(density);
+    CellCenteredScalarGrid3 temperature1(temperature);
+    VertexCenteredScalarGrid3 fuel1(fuel);
+    std::vector<const ScalarGrid3*> inputs = {&density, &fuel, &temperature};
+    std::vector<ScalarGrid3*> outputs = {&density1, &fuel1, &temperature1};
+    solver->advectScalars(inputs, flow, 0.05, outputs, boundarySdf);
+
+    density.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(density0(i, j, k), density1(i, j, k));
+        EXPECT_EQ(temperature0(i, j, k), temperature1(i, j, k));
+    });
+    fuel.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(fuel0(i, j, k), fuel1(i, j, k));
+    });
+
+    outputs.pop_back();
+    EXPECT_THROW(
+        solver->advectScalars(inputs, flow, 0.05, outputs, boundarySdf),
+        std::invalid_argument);
+}
+
+}  // namespace
+
+TEST(SemiLagrangian3, AdvectScalars) {
+    SemiLagrangian3 solver;
+    testAdvectScalars(&solver);
+}
+
+TEST(CubicSemiLagrangian3, AdvectScalars) {
+    CubicSemiLagrangian3 solver;
+    testAdvectScalars(&solver);
+}
+
+TEST(SemiLagrangian3, AdvectScalarsWithCustomSampler) {
+    ConstantSemiLagrangian3 solver;
+    testAdvectScalars(&solver);
+}
+
+TEST(SemiLagrangian3, CustomSampler) {
+    Size3 res(8, 6, 4);
+    Vector3D h(0.1, 0.1, 0.1);
+
+    FaceCenteredGrid3 flow(res, h, Vector3D(), Vector3D(0.3, -0.2, 0.1));
+    ConstantSemiLagrangian3 solver;
+
+    CellCenteredScalarGrid3 input(res, h);
+    CellCenteredScalarGrid3 output(res, h);
+    solver.advect(input, flow, 0.05, &output);
+    output.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(7.0, output(i, j, k));
+    });
+
+    CellCenteredVectorGrid3 vectorInput(res, h);
+    CellCenteredVectorGrid3 vectorOutput(res, h);
+    solver.advect(vectorInput, flow, 0.05, &vectorOutput);
+    vectorOutput.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(Vector3D(1.0, 2.0, 3.0), vectorOutput(i, j, k));
+    });
+
+    FaceCenteredGrid3 faceOutput(res, h);
+    solver.advect(flow, flow, 0.05, &faceOutput);
+    faceOutput.forEachUIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(4.0, faceOutput.u(i, j, k));
+    });
+    faceOutput.forEachVIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(5.0, faceOutput.v(i, j, k));
+    });
+    faceOutput.forEachWIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(6.0, faceOutput.w(i, j, k));
+    });
+}
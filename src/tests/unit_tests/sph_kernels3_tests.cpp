@@ -7,6 +7,8 @@
 #include <jet/sph_kernels3.h>
 #include <gtest/gtest.h>
 
+#include <vector>
+
 using namespace jet;
 
 TEST(SphStdKernel3, Constructors) {
@@ -144,3 +146,77 @@ TEST(SphSpikyKernel3, SecondDerivative) {
     double fdm = (kernel(5.0 + e) - 2.0 * kernel(5.0) + kernel(5.0 - e)) / (e * e);
     EXPECT_NEAR(fdm, value1, 1e-10);
 }
+
+TEST(SphStdKernel3, Batch) {
+    SphStdKernel3 kernel(10.0);
+
+    std::vector<double> dists, squaredDists;
+    std::vector<Vector3D> dirs;
+    for (int i = 0; i <= 24; ++i) {
+        dists.push_back(0.5 * i);
+        squaredDists.push_back(0.25 * i * i);
+        dirs.push_back(Vector3D(i, 1.0, -2.0).normalized());
+    }
+    const size_t n = dists.size();
+
+    std::vector<double> values(n), valuesFromSquared(n), firstDerivatives(n),
+        secondDerivatives(n);
+    std::vector<Vector3D> gradients(n);
+    kernel.values(dists.data(), n, values.data());
+    kernel.valuesFromSquaredDistances(
+        squaredDists.data(), n, valuesFromSquared.data());
+    kernel.firstDerivatives(dists.data(), n, firstDerivatives.data());
+    kernel.gradients(dists.data(), dirs.data(), n, gradients.data());
+    kernel.secondDerivatives(dists.data(), n, secondDerivatives.data());
+
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(kernel(dists[i]), values[i]);
+        EXPECT_EQ(kernel(dists[i]), valuesFromSquared[i]);
+        EXPECT_EQ(kernel.firstDerivative(dists[i]), firstDerivatives[i]);
+        EXPECT_EQ(kernel.gradient(dists[i], dirs[i]), gradients[i]);
+        EXPECT_EQ(kernel.secondDerivative(dists[i]), secondDerivatives[i]);
+    }
+
+    // In-place evaluation
+    kernel.values(dists.data(), n, dists.data());
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(values[i], dists[i]);
+    }
+}
+
+TEST(SphSpikyKernel3, Batch) {
+    SphSpikyKernel3 kernel(10.0);
+
+    std::vector<double> dists, squaredDists;
+    std::vector<Vector3D> dirs;
+    for (int i = 0; i <= 24; ++i) {
+        dists.push_back(0.5 * i);
+        squaredDists.push_back(0.25 * i * i);
+        dirs.push_back(Vector3D(i, 1.0, -2.0).normalized());
+    }
+    const size_t n = dists.size();
+
+    std::vector<double> values(n), valuesFromSquared(n), firstDerivatives(n),
+        secondDerivatives(n);
+    std::vector<Vector3D> gradients(n);
+    kernel.values(dists.data(), n, values.data());
+    kernel.valuesFromSquaredDistances(
+        squaredDists.data(), n, valuesFromSquared.data());
+    kernel.firstDerivatives(dists.data(), n, firstDerivatives.data());
+    kernel.gradients(dists.data(), dirs.data(), n, gradients.data());
+    kernel.secondDerivatives(dists.data(), n, secondDerivatives.data());
+
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(kernel(dists[i]), values[i]);
+        EXPECT_DOUBLE_EQ(kernel(dists[i]), valuesFromSquared[i]);
+        EXPECT_EQ(kernel.firstDerivative(dists[i]), firstDerivatives[i]);
+        EXPECT_EQ(kernel.gradient(dists[i], dirs[i]), gradients[i]);
+        EXPECT_EQ(kernel.secondDerivative(dists[i]), secondDerivatives[i]);
+    }
+
+    // In-place evaluation
+    kernel.values(dists.data(), n, dists.data());
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(values[i], dists[i]);
+    }
+}
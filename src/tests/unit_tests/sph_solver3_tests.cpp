@@ -4,7 +4,10 @@
 // personal capacity and am not conveying any rights to any intellectual
 // property of any third parties.
 
+#include <jet/box3.h>
+#include <jet/rigid_body_collider3.h>
 #include <jet/sph_solver3.h>
+#include <jet/volume_particle_emitter3.h>
 #include <gtest/gtest.h>
 
 using namespace jet;
@@ -59,5 +62,158 @@ TEST(SphSolver3, Parameters) {
     solver.setTimeStepLimitScale(-1.0);
     EXPECT_DOUBLE_EQ(0.0, solver.timeStepLimitScale());
 
+    EXPECT_FALSE(solver.isUsingSleeping());
+    solver.setIsUsingSleeping(true);
+    EXPECT_TRUE(solver.isUsingSleeping());
+    EXPECT_EQ(0u, solver.numberOfSleepingParticles());
+
+    solver.setSleepingVelocityThreshold(0.3);
+    EXPECT_DOUBLE_EQ(0.3, solver.sleepingVelocityThreshold());
+
+    solver.setSleepingVelocityThreshold(-1.0);
+    EXPECT_DOUBLE_EQ(0.0, solver.sleepingVelocityThreshold());
+
+    solver.setSleepingDensityErrorThreshold(0.3);
+    EXPECT_DOUBLE_EQ(0.3, solver.sleepingDensityErrorThreshold());
+
+    solver.setSleepingDensityErrorThreshold(-1.0);
+    EXPECT_DOUBLE_EQ(0.0, solver.sleepingDensityErrorThreshold());
+
+    solver.setSleepingStepCount(5);
+    EXPECT_EQ(5u, solver.sleepingStepCount());
+
+    solver.setSleepingStepCount(0);
+    EXPECT_EQ(1u, solver.sleepingStepCount());
+
     EXPECT_TRUE(solver.sphSystemData() != nullptr);
 }
+
+TEST(SphSolver3, UpdateWithoutNeighborLists) {
+    auto runSolver = [](bool useNeighborLists) {
+        SphSolver3 solver;
+        solver.setPseudoViscosityCoefficient(0.0);
+        solver.setViscosityCoefficient(0.01);
+
+        auto particles = solver.sphSystemData();
+        particles->setTargetDensity(1000.0);
+        particles->setTargetSpacing(0.1);
+        particles->setUseNeighborLists(useNeighborLists);
+
+        auto box = Box3::builder()
+            .withLowerCorner({0.0, 0.0, 0.0})
+            .withUpperCorner({0.5, 0.5, 0.5})
+            .makeShared();
+        auto emitter = VolumeParticleEmitter3::builder()
+            .withSurface(box)
+            .withSpacing(0.1)
+            .withIsOneShot(true)
+            .makeShared();
+        solver.setEmitter(emitter);
+
+        auto domain = Box3::builder()
+            .withLowerCorner({-0.5, -0.5, -0.5})
+            .withUpperCorner({1.0, 1.0, 1.0})
+            .withIsNormalFlipped(true)
+            .makeShared();
+        solver.setCollider(
+            RigidBodyCollider3::builder().withSurface(domain).makeShared());
+
+        Frame frame(0, 1.0 / 60.0);
+        for (; frame.index < 3; ++frame) {
+            solver.update(frame);
+        }
+
+        return particles;
+    };
+
+    auto withLists = runSolver(true);
+    auto withoutLists = runSolver(false);
+
+    ASSERT_GT(withLists->numberOfParticles(), 0u);
+    ASSERT_EQ(withLists->numberOfParticles(),
+              withoutLists->numberOfParticles());
+    EXPECT_EQ(0u, withoutLists->neighborLists().size());
+
+    // Only the summation order differs between the modes
+    auto x0 = withLists->positions();
+    auto x1 = withoutLists->positions();
+    auto d0 = withLists->densities();
+    auto d1 = withoutLists->densities();
+    for (size_t i = 0; i < x0.size(); ++i) {
+        EXPECT_NEAR(0.0, x0[i].distanceTo(x1[i]), 1e-9);
+        EXPECT_NEAR(d0[i], d1[i], 1e-6 * d0[i]);
+    }
+}
+
+TEST(SphSolver3, RemoveParticlesOutsideDomain) {
+    SphSolver3 solver;
+    EXPECT_FALSE(solver.removesParticlesOutsideDomain());
+
+    BoundingBox3D domain({-1.0, 0.0, -1.0}, {2.0, 2.0, 2.0});
+    solver.setParticleDomain(domain);
+    solver.setRemovesParticlesOutsideDomain(true);
+    EXPECT_TRUE(solver.removesParticlesOutsideDomain());
+    EXPECT_EQ(domain.lowerCorner, solver.particleDomain().lowerCorner);
+    EXPECT_EQ(domain.upperCorner, solver.particleDomain().upperCorner);
+
+    auto particles = solver.sphSystemData();
+    particles->setTargetDensity(1000.0);
+    particles->setTargetSpacing(0.1);
+
+    // A block without collider falls through the bottom of the domain
+    auto box = Box3::builder()
+        .withLowerCorner({0.0, 0.05, 0.0})
+        .withUpperCorner({0.5, 0.5, 0.5})
+        .makeShared();
+    auto emitter = VolumeParticleEmitter3::builder()
+        .withSurface(box)
+        .withSpacing(0.1)
+        .withIsOneShot(true)
+        .makeShared();
+    solver.setEmitter(emitter);
+
+    Frame frame(0, 1.0 / 60.0);
+    solver.update(frame++);
+    ASSERT_GT(particles->numberOfParticles(), 0u);
+
+    for (; frame.index < 30; ++frame) {
+        solver.update(frame);
+    }
+
+    // Every particle has left the domain after half a second
+    EXPECT_EQ(0u, particles->numberOfParticles());
+}
+
+TEST(SphSolver3, UpdateWithParticleRemovalWithoutDomain) {
+    SphSolver3 solver;
+
+    // The default domain is unbounded, so nothing is removed
+    solver.setRemovesParticlesOutsideDomain(true);
+    EXPECT_FALSE(solver.particleDomain().isEmpty());
+
+    auto particles = solver.sphSystemData();
+    particles->setTargetDensity(1000.0);
+    particles->setTargetSpacing(0.1);
+
+    auto box = Box3::builder()
+        .withLowerCorner({0.0, 0.05, 0.0})
+        .withUpperCorner({0.5, 0.5, 0.5})
+        .makeShared();
+    auto emitter = VolumeParticleEmitter3::builder()
+        .withSurface(box)
+        .withSpacing(0.1)
+        .withIsOneShot(true)
+        .makeShared();
+    solver.setEmitter(emitter);
+
+    Frame frame(0, 1.0 / 60.0);
+    solver.update(frame++);
+    const size_t numberOfParticles = particles->numberOfParticles();
+    ASSERT_GT(numberOfParticles, 0u);
+
+    for (; frame.index < 5; ++frame) {
+        solver.update(frame);
+    }
+
+    EXPECT_EQ(numberOfParticles, particles->numberOfParticles());
+}
@@ -4,6 +4,7 @@
 // personal capacity and am not conveying any rights to any intellectual
 // property of any third parties.
 
+#include <jet/sph_kernels3.h>
 #include <jet/sph_system_data3.h>
 #include <gtest/gtest.h>
 #include <vector>
@@ -61,6 +62,82 @@ TEST(SphSystemData3, Particles) {
     EXPECT_GT(1.0, midVal);
 }
 
+TEST(SphSystemData3, SkinRadius) {
+    SphSystemData3 data;
+    data.setTargetSpacing(0.1);
+    data.setRelativeKernelRadius(1.8);
+
+    for (size_t k = 0; k < 5; ++k) {
+        for (size_t j = 0; j < 5; ++j) {
+            for (size_t i = 0; i < 5; ++i) {
+                data.addParticle(
+                    Vector3D(0.1 * i + 0.01 * j, 0.1 * j, 0.1 * k + 0.01 * i));
+            }
+        }
+    }
+
+    data.buildNeighborSearcher();
+    data.buildNeighborLists();
+    data.updateDensities();
+    auto d0 = data.densities();
+    std::vector<double> expected(d0.begin(), d0.end());
+
+    // Densities from the skinned lists should match the exact ones
+    data.setSkinRadius(0.5 * data.kernelRadius());
+    EXPECT_TRUE(data.needsNeighborListsRebuild());
+    data.buildNeighborSearcher();
+    data.buildNeighborLists();
+    EXPECT_FALSE(data.needsNeighborListsRebuild());
+    data.updateDensities();
+
+    auto d = data.densities();
+    for (size_t i = 0; i < data.numberOfParticles(); ++i) {
+        EXPECT_NEAR(expected[i], d[i], 1e-9 * expected[i]);
+    }
+}
+
+TEST(SphSystemData3, InterpolateWithSkinRadius) {
+    SphSystemData3 data;
+    data.setTargetSpacing(0.1);
+    data.setRelativeKernelRadius(1.8);
+    data.setSkinRadius(0.5 * data.kernelRadius());
+
+    for (size_t k = 0; k < 5; ++k) {
+        for (size_t j = 0; j < 5; ++j) {
+            for (size_t i = 0; i < 5; ++i) {
+                data.addParticle(Vector3D(0.1 * i, 0.1 * j, 0.1 * k));
+            }
+        }
+    }
+
+    data.buildNeighborSearcher();
+    data.buildNeighborLists();
+    data.updateDensities();
+
+    // Move the particle at (0.2, 0.2, 0) below the block by less than half
+    // of the skin so that it enters the kernel radius of the origin.
+    const Vector3D origin(0.2, 0.2, -0.2);
+    auto x = data.positions();
+    x[12].z -= 0.4 * data.skinRadius();
+    EXPECT_FALSE(data.needsNeighborListsRebuild());
+
+    SphStdKernel3 kernel(data.kernelRadius());
+    auto d = data.densities();
+    Array1<double> values(data.numberOfParticles(), 1.0);
+    double expectedSum = 0.0;
+    double expectedValue = 0.0;
+    for (size_t i = 0; i < data.numberOfParticles(); ++i) {
+        const double w = kernel(origin.distanceTo(x[i]));
+        expectedSum += w;
+        expectedValue += data.mass() / d[i] * w;
+    }
+    EXPECT_LT(0.0, expectedSum);
+
+    EXPECT_DOUBLE_EQ(expectedSum, data.sumOfKernelNearby(origin));
+    EXPECT_DOUBLE_EQ(expectedValue,
+                     data.interpolate(origin, values.constAccessor()));
+}
+
 TEST(SphSystemData3, Serialization) {
     SphSystemData3 data;
 
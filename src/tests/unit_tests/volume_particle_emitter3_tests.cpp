@@ -6,6 +6,7 @@
 
 #include "unit_tests_utils.h"
 
+#include <jet/parallel.h>
 #include <jet/sphere3.h>
 #include <jet/surface_to_implicit3.h>
 #include <jet/volume_particle_emitter3.h>
@@ -133,3 +134,69 @@ TEST(VolumeParticleEmitter3, Builder) {
     EXPECT_VECTOR3_EQ(Vector3D(3.0, 4.0, 5.0), emitter.linearVelocity());
     EXPECT_VECTOR3_EQ(Vector3D(0.0, 1.0, 2.0), emitter.angularVelocity());
 }
+
+TEST(VolumeParticleEmitter3, EmitIsDeterministic) {
+    auto sphere = std::make_shared<Sphere3>(Vector3D(1.0, 2.0, 4.0), 3.0);
+    const unsigned int defaultNumberOfThreads = maxNumberOfThreads();
+
+    auto emit = [&](unsigned int numberOfThreads, uint32_t seed,
+                    size_t maxNumberOfParticles) {
+        setMaxNumberOfThreads(numberOfThreads);
+
+        // Spans several candidate chunks and runs out of budget in the
+        // second emission
+        auto emitter = VolumeParticleEmitter3::builder()
+            .withSurface(sphere)
+            .withMaxRegion(BoundingBox3D({0.0, 0.0, 0.0}, {3.0, 3.0, 3.0}))
+            .withSpacing(0.08)
+            .withMaxNumberOfParticles(maxNumberOfParticles)
+            .withJitter(0.5)
+            .withIsOneShot(false)
+            .withAllowOverlapping(false)
+            .withRandomSeed(seed)
+            .makeShared();
+
+        auto particles = std::make_shared<ParticleSystemData3>();
+        emitter->setTarget(particles);
+        emitter->update(0.0, 0.01);
+
+        // Make room for the second emission
+        auto pos = particles->positions();
+        for (size_t i = 0; i < pos.size(); ++i) {
+            pos[i] += Vector3D(0.0, 0.0, 1.0);
+        }
+        emitter->update(0.01, 0.01);
+
+        setMaxNumberOfThreads(defaultNumberOfThreads);
+
+        Array1<Vector3D> result(particles->numberOfParticles());
+        particles->positions().parallelForEachIndex(
+            [&](size_t i) { result[i] = particles->positions()[i]; });
+        return result;
+    };
+
+    Array1<Vector3D> expected = emit(1, 0, kMaxSize);
+    ASSERT_LT(0u, expected.size());
+
+    Array1<Vector3D> actual = emit(4, 0, kMaxSize);
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_VECTOR3_EQ(expected[i], actual[i]);
+    }
+
+    // Capping the number of particles should emit a prefix of the same
+    // sequence
+    const size_t n = expected.size() / 2 + 10;
+    Array1<Vector3D> partial = emit(4, 0, n);
+    ASSERT_EQ(n, partial.size());
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_VECTOR3_EQ(expected[i], partial[i]);
+    }
+
+    Array1<Vector3D> reseeded = emit(1, 1, kMaxSize);
+    bool differs = reseeded.size() != expected.size();
+    for (size_t i = 0; !differs && i < expected.size(); ++i) {
+        differs = reseeded[i] != expected[i];
+    }
+    EXPECT_TRUE(differs);
+}